@@ -0,0 +1,206 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "flat_octree.h"
+#include "octree.h"
+
+#include "kdl/vector_utils.h"
+
+#include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace tb
+{
+namespace
+{
+
+constexpr size_t NumBrushes = 100'000;
+constexpr size_t NumQueries = 10'000;
+constexpr double MinSize = 256.0;
+
+/**
+ * Creates bounds that resemble the brushes of a large map: boxes of grid aligned sizes
+ * between 16 and 512 units, distributed in a 16k cube.
+ */
+std::vector<std::pair<vm::bbox3d, size_t>> makeBrushBounds()
+{
+  auto rng = std::mt19937{1};
+  auto position = std::uniform_int_distribution<int>{-512, 511};
+  auto size = std::uniform_int_distribution<int>{1, 32};
+
+  auto result = std::vector<std::pair<vm::bbox3d, size_t>>{};
+  result.reserve(NumBrushes);
+  for (size_t i = 0; i < NumBrushes; ++i)
+  {
+    const auto min = vm::vec3d{
+      double(position(rng) * 16), double(position(rng) * 16), double(position(rng) * 16)};
+    const auto max =
+      min
+      + vm::vec3d{double(size(rng) * 16), double(size(rng) * 16), double(size(rng) * 16)};
+    result.emplace_back(vm::bbox3d{min, max}, i);
+  }
+  return result;
+}
+
+std::vector<vm::ray3d> makeRays()
+{
+  auto rng = std::mt19937{2};
+  auto position = std::uniform_real_distribution<double>{-8192.0, 8192.0};
+  auto direction = std::uniform_real_distribution<double>{-1.0, 1.0};
+
+  auto result = std::vector<vm::ray3d>{};
+  result.reserve(NumQueries);
+  for (size_t i = 0; i < NumQueries; ++i)
+  {
+    const auto origin = vm::vec3d{position(rng), position(rng), position(rng)};
+    const auto dir = vm::vec3d{direction(rng), direction(rng), direction(rng)};
+    result.emplace_back(origin, vm::normalize(dir));
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("OctreeBenchmark.build")
+{
+  const auto brushes = makeBrushBounds();
+
+  timeLambda(
+    [&]() {
+      auto tree = octree<double, size_t>{MinSize};
+      for (const auto& [bounds, data] : brushes)
+      {
+        tree.insert(bounds, data);
+      }
+    },
+    fmt::format("insert {} brushes into octree", NumBrushes));
+
+  timeLambda(
+    [&]() {
+      auto tree = flat_octree<double, size_t>{MinSize};
+      for (const auto& [bounds, data] : brushes)
+      {
+        tree.insert(bounds, data);
+      }
+    },
+    fmt::format("insert {} brushes into flat_octree", NumBrushes));
+
+  timeLambda(
+    [&]() {
+      auto tree = flat_octree<double, size_t>{MinSize};
+      tree.build(brushes);
+    },
+    fmt::format("build flat_octree from {} brushes", NumBrushes));
+}
+
+TEST_CASE("OctreeBenchmark.update")
+{
+  const auto brushes = makeBrushBounds();
+  const auto movedBrushes = kdl::vec_transform(brushes, [](const auto& brush) {
+    return std::pair{brush.first.translate({1024.0, 512.0, 0.0}), brush.second};
+  });
+
+  auto tree = flat_octree<double, size_t>{MinSize};
+  tree.build(brushes);
+
+  timeLambda(
+    [&]() {
+      for (const auto& [bounds, data] : movedBrushes)
+      {
+        tree.update(bounds, data);
+      }
+    },
+    fmt::format("update {} brushes in flat_octree one by one", NumBrushes));
+
+  tree.build(brushes);
+
+  timeLambda(
+    [&]() { tree.update(movedBrushes); },
+    fmt::format("update {} brushes in flat_octree in one batch", NumBrushes));
+}
+
+TEST_CASE("OctreeBenchmark.query")
+{
+  const auto brushes = makeBrushBounds();
+  const auto rays = makeRays();
+
+  auto tree = octree<double, size_t>{MinSize};
+  for (const auto& [bounds, data] : brushes)
+  {
+    tree.insert(bounds, data);
+  }
+
+  auto flatTree = flat_octree<double, size_t>{MinSize};
+  flatTree.build(brushes);
+
+  auto octreeCount = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        octreeCount += tree.find_intersectors(ray).size();
+      }
+    },
+    fmt::format("{} ray queries against octree", NumQueries));
+
+  auto flatOctreeCount = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        flatTree.visit_intersectors(ray, [&](const size_t) { ++flatOctreeCount; });
+      }
+    },
+    fmt::format("{} ray queries against flat_octree", NumQueries));
+
+  CHECK(flatOctreeCount == octreeCount);
+
+  octreeCount = 0;
+  timeLambda(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        octreeCount += tree.find_containers(ray.origin).size();
+      }
+    },
+    fmt::format("{} point queries against octree", NumQueries));
+
+  flatOctreeCount = 0;
+  timeLambda(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        flatTree.visit_containers(ray.origin, [&](const size_t) { ++flatOctreeCount; });
+      }
+    },
+    fmt::format("{} point queries against flat_octree", NumQueries));
+
+  CHECK(flatOctreeCount == octreeCount);
+}
+
+} // namespace tb
@@ -0,0 +1,209 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Color.h"
+#include "el/ELExceptions.h"
+#include "el/EvaluationContext.h"
+#include "el/Expression.h"
+#include "el/Value.h"
+#include "io/DefParser.h"
+#include "io/DiskIO.h"
+#include "io/File.h"
+#include "io/FgdParser.h"
+#include "io/PathMatcher.h"
+#include "io/Reader.h"
+#include "io/TestParserStatus.h"
+#include "io/TraversalMode.h"
+#include "mdl/DecalDefinition.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityDefinition.h"
+#include "mdl/EntityPropertiesVariableStore.h"
+#include "mdl/ModelDefinition.h"
+
+#include "kdl/result.h"
+#include "kdl/vector_utils.h"
+
+#include <fmt/format.h>
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace tb::el
+{
+namespace
+{
+
+constexpr size_t NumIterations = 100;
+
+std::vector<std::unique_ptr<mdl::EntityDefinition>> parseDefinitions(
+  const std::filesystem::path& path)
+{
+  auto file = io::Disk::openFile(path) | kdl::value();
+  auto reader = file->reader().buffer();
+
+  auto status = io::TestParserStatus{};
+  const auto defaultColor = Color{1.0f, 1.0f, 1.0f, 1.0f};
+  if (path.extension() == ".fgd")
+  {
+    auto parser = io::FgdParser{reader.stringView(), defaultColor, path};
+    return parser.parseDefinitions(status);
+  }
+
+  auto parser = io::DefParser{reader.stringView(), defaultColor};
+  return parser.parseDefinitions(status);
+}
+
+/**
+ * Returns the model and decal expressions of all point entity definitions in the bundled
+ * game configurations, skipping constant expressions.
+ */
+std::vector<ExpressionNode> collectExpressions()
+{
+  const auto basePath = std::filesystem::current_path() / "fixture/games/";
+  const auto paths = io::Disk::find(
+                       basePath,
+                       io::TraversalMode::Recursive,
+                       io::makeExtensionPathMatcher({".fgd", ".def"}))
+                     | kdl::value();
+
+  auto result = std::vector<ExpressionNode>{};
+  for (const auto& path : paths)
+  {
+    for (const auto& definition : parseDefinitions(path))
+    {
+      if (
+        const auto* pointDefinition =
+          dynamic_cast<const mdl::PointEntityDefinition*>(definition.get()))
+      {
+        for (const auto& expression :
+             {pointDefinition->modelDefinition().expression(),
+              pointDefinition->decalDefinition().expression()})
+        {
+          if (expression.compile().instructions().size() > 1)
+          {
+            result.push_back(expression);
+          }
+        }
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<mdl::Entity> createEntities()
+{
+  auto result = std::vector<mdl::Entity>{};
+  for (size_t i = 0; i < 16; ++i)
+  {
+    result.push_back(mdl::Entity{{
+      {"spawnflags", fmt::format("{}", i)},
+      {"model", fmt::format("progs/model{}.mdl", i)},
+      {"texture", fmt::format("decal{}", i)},
+      {"skin", fmt::format("{}", i % 4)},
+    }});
+  }
+  return result;
+}
+
+template <typename Evaluate>
+std::optional<Value> tryEvaluate(const Evaluate& evaluate)
+{
+  try
+  {
+    return evaluate();
+  }
+  catch (const Exception&)
+  {
+    return std::nullopt;
+  }
+}
+
+} // namespace
+
+TEST_CASE("ExpressionBenchmark.evaluateEntityDefinitionExpressions")
+{
+  const auto expressions = collectExpressions();
+  REQUIRE(!expressions.empty());
+
+  const auto compiledExpressions =
+    kdl::vec_transform(expressions, [](const auto& expression) {
+      return expression.compile();
+    });
+
+  const auto entities = createEntities();
+
+  for (size_t i = 0; i < expressions.size(); ++i)
+  {
+    for (const auto& entity : entities)
+    {
+      const auto variableStore = mdl::EntityPropertiesVariableStore{entity};
+      CHECK(
+        tryEvaluate([&]() {
+          return expressions[i].evaluate(EvaluationContext{variableStore});
+        })
+        == tryEvaluate([&]() { return compiledExpressions[i].evaluate(variableStore); }));
+    }
+  }
+
+  timeLambda(
+    [&]() {
+      for (size_t n = 0; n < NumIterations; ++n)
+      {
+        for (const auto& expression : expressions)
+        {
+          for (const auto& entity : entities)
+          {
+            const auto variableStore = mdl::EntityPropertiesVariableStore{entity};
+            tryEvaluate(
+              [&]() { return expression.evaluate(EvaluationContext{variableStore}); });
+          }
+        }
+      }
+    },
+    fmt::format(
+      "evaluate {} expressions {} times (tree)",
+      expressions.size(),
+      NumIterations * entities.size()));
+
+  timeLambda(
+    [&]() {
+      for (size_t n = 0; n < NumIterations; ++n)
+      {
+        for (const auto& compiledExpression : compiledExpressions)
+        {
+          for (const auto& entity : entities)
+          {
+            const auto variableStore = mdl::EntityPropertiesVariableStore{entity};
+            tryEvaluate([&]() { return compiledExpression.evaluate(variableStore); });
+          }
+        }
+      }
+    },
+    fmt::format(
+      "evaluate {} expressions {} times (compiled)",
+      expressions.size(),
+      NumIterations * entities.size()));
+}
+
+} // namespace tb::el
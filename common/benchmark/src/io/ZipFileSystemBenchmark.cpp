@@ -0,0 +1,143 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "io/DiskIO.h"
+#include "io/File.h"
+#include "io/ImageFileSystem.h"
+#include "io/ZipFileSystem.h"
+
+#include "kdl/result.h"
+#include "kdl/task_manager.h"
+#include "kdl/vector_utils.h"
+
+#include <fmt/format.h>
+#include <miniz/miniz.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tb::io
+{
+namespace
+{
+
+constexpr size_t NumEntries = 5'000;
+constexpr size_t EntrySize = 16 * 1024;
+
+std::filesystem::path entryPath(const size_t i)
+{
+  return fmt::format("textures/dir{}/texture{}.wal", i / 100, i);
+}
+
+/**
+ * Writes a zip archive with NumEntries compressed entries to the given path. The entries
+ * contain pseudo random data with a limited range of values so that they compress
+ * similarly to the textures in a typical pk3 file.
+ */
+void writeArchive(const std::filesystem::path& path)
+{
+  auto archive = mz_zip_archive{};
+  REQUIRE(mz_zip_writer_init_file(&archive, path.string().c_str(), 0));
+
+  auto seed = uint32_t(1);
+  auto data = std::vector<unsigned char>(EntrySize);
+  for (size_t i = 0; i < NumEntries; ++i)
+  {
+    for (auto& c : data)
+    {
+      seed = seed * 1664525u + 1013904223u;
+      c = static_cast<unsigned char>((seed >> 24) & 0x1F);
+    }
+
+    REQUIRE(mz_zip_writer_add_mem(
+      &archive,
+      entryPath(i).string().c_str(),
+      data.data(),
+      data.size(),
+      MZ_DEFAULT_LEVEL));
+  }
+
+  REQUIRE(mz_zip_writer_finalize_archive(&archive));
+  REQUIRE(mz_zip_writer_end(&archive));
+}
+
+size_t readFile(const FileSystem& fs, const std::filesystem::path& path)
+{
+  const auto file = fs.openFile(path) | kdl::value();
+  auto reader = file->reader().buffer();
+  return reader.size();
+}
+
+} // namespace
+
+TEST_CASE("ZipFileSystemBenchmark.extractFiles")
+{
+  const auto archivePath = std::filesystem::temp_directory_path() / "benchmark.pk3";
+  writeArchive(archivePath);
+
+  {
+    auto fs = std::unique_ptr<FileSystem>{};
+    timeLambda(
+      [&]() {
+        fs = Disk::openFile(archivePath) | kdl::and_then([](auto file) {
+               return createImageFileSystem<ZipFileSystem>(std::move(file));
+             })
+             | kdl::value();
+      },
+      fmt::format("open archive with {} entries", NumEntries));
+
+    auto paths = std::vector<std::filesystem::path>{};
+    for (size_t i = 0; i < NumEntries; ++i)
+    {
+      paths.push_back(entryPath(i));
+    }
+
+    timeLambda(
+      [&]() {
+        for (const auto& path : paths)
+        {
+          CHECK(readFile(*fs, path) == EntrySize);
+        }
+      },
+      fmt::format("extract {} entries sequentially", NumEntries));
+
+    auto taskManager = kdl::task_manager{};
+    timeLambda(
+      [&]() {
+        auto tasks = kdl::vec_transform(paths, [&](const auto& path) {
+          return std::function{[&]() { return readFile(*fs, path); }};
+        });
+        const auto sizes = taskManager.run_tasks_and_wait(std::move(tasks));
+        CHECK(std::ranges::all_of(
+          sizes, [](const auto size) { return size == EntrySize; }));
+      },
+      fmt::format("extract {} entries in parallel", NumEntries));
+  }
+
+  std::filesystem::remove(archivePath);
+}
+
+} // namespace tb::io
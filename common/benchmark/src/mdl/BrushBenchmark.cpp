@@ -0,0 +1,200 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "io/NodeWriter.h"
+#include "io/TestParserStatus.h"
+#include "io/WorldReader.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/LayerNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/result.h"
+#include "kdl/task_manager.h"
+
+#include "vm/mat_ext.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <array>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t BrushesPerAxis = 32;
+const auto worldBounds = vm::bbox3d{8192.0};
+
+/**
+ * Returns a map containing a grid of about 32k cuboid brushes in standard format.
+ */
+std::string makeMap()
+{
+  auto str = std::stringstream{};
+  str << "{\n\"classname\" \"worldspawn\"\n";
+  for (size_t x = 0; x < BrushesPerAxis; ++x)
+  {
+    for (size_t y = 0; y < BrushesPerAxis; ++y)
+    {
+      for (size_t z = 0; z < BrushesPerAxis; ++z)
+      {
+        const auto minX = int(x) * 128 - 2048;
+        const auto minY = int(y) * 128 - 2048;
+        const auto minZ = int(z) * 128 - 2048;
+        const auto size = int(16 + 16 * ((x + y + z) % 6));
+
+        // the arguments are min x, y, z followed by max x, y, z
+        constexpr auto faces = std::array{
+          "( {0} {1} {2} ) ( {0} {1} {5} ) ( {3} {1} {2} ) mat 0 0 0 1 1\n",
+          "( {0} {1} {2} ) ( {0} {4} {2} ) ( {0} {1} {5} ) mat 0 0 0 1 1\n",
+          "( {0} {1} {2} ) ( {3} {1} {2} ) ( {0} {4} {2} ) mat 0 0 0 1 1\n",
+          "( {3} {4} {5} ) ( {0} {4} {5} ) ( {3} {4} {2} ) mat 0 0 0 1 1\n",
+          "( {3} {4} {5} ) ( {3} {4} {2} ) ( {3} {1} {5} ) mat 0 0 0 1 1\n",
+          "( {3} {4} {5} ) ( {3} {1} {5} ) ( {0} {4} {5} ) mat 0 0 0 1 1\n",
+        };
+
+        str << "{\n";
+        for (const auto* face : faces)
+        {
+          str << fmt::format(
+            fmt::runtime(face), minX, minY, minZ, minX + size, minY + size, minZ + size);
+        }
+        str << "}\n";
+      }
+    }
+  }
+  str << "}\n";
+  return str.str();
+}
+
+std::vector<Brush> makeBrushes()
+{
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto result = std::vector<Brush>{};
+  for (size_t x = 0; x < BrushesPerAxis; ++x)
+  {
+    for (size_t y = 0; y < BrushesPerAxis; ++y)
+    {
+      for (size_t z = 0; z < BrushesPerAxis; ++z)
+      {
+        const auto min =
+          vm::vec3d{double(x) * 128.0, double(y) * 128.0, double(z) * 128.0}
+          - vm::vec3d{2048.0, 2048.0, 2048.0};
+        const auto size = double(16 + 16 * ((x + y + z) % 6));
+        result.push_back(
+          builder.createCuboid(vm::bbox3d{min, min + vm::vec3d{size, size, size}}, "")
+          | kdl::value());
+      }
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("BrushBenchmark.loadMap")
+{
+  const auto map = makeMap();
+  auto taskManager = kdl::task_manager{};
+
+  auto world = std::unique_ptr<WorldNode>{};
+  timeLambda(
+    [&]() {
+      auto status = io::TestParserStatus{};
+      auto reader = io::WorldReader{map, MapFormat::Standard, {}};
+      world = reader.read(worldBounds, status, taskManager);
+    },
+    fmt::format("load map with {} brushes", BrushesPerAxis * BrushesPerAxis * BrushesPerAxis));
+
+  REQUIRE(world);
+  CHECK(
+    world->defaultLayer()->childCount()
+    == BrushesPerAxis * BrushesPerAxis * BrushesPerAxis);
+
+  auto written = std::stringstream{};
+  timeLambda(
+    [&]() {
+      auto writer = io::NodeWriter{*world, written};
+      writer.writeMap(taskManager);
+    },
+    "write map");
+  CHECK(written.tellp() > 0);
+
+  timeLambda([&]() { world.reset(); }, "destroy world");
+}
+
+TEST_CASE("BrushBenchmark.transformBrushes")
+{
+  auto brushes = makeBrushes();
+  auto failures = size_t(0);
+
+  const auto translation = vm::translation_matrix(vm::vec3d{16.0, 0.0, 0.0});
+  timeLambda(
+    [&]() {
+      for (auto& brush : brushes)
+      {
+        failures += brush.transform(worldBounds, translation, false).is_success() ? 0u : 1u;
+      }
+    },
+    fmt::format("translate {} brushes", brushes.size()));
+
+  const auto rotation90 = vm::rotation_matrix(vm::vec3d{0, 0, 1}, vm::to_radians(90.0));
+  timeLambda(
+    [&]() {
+      for (auto& brush : brushes)
+      {
+        failures +=
+          brush.transform(worldBounds, rotation90, false).is_success() ? 0u : 1u;
+      }
+    },
+    fmt::format("rotate {} brushes by 90 degrees", brushes.size()));
+
+  const auto flip = vm::mirror_matrix<double>(vm::axis::x);
+  timeLambda(
+    [&]() {
+      for (auto& brush : brushes)
+      {
+        failures += brush.transform(worldBounds, flip, false).is_success() ? 0u : 1u;
+      }
+    },
+    fmt::format("flip {} brushes", brushes.size()));
+
+  const auto rotation = vm::rotation_matrix(vm::vec3d{0, 0, 1}, vm::to_radians(15.0));
+  timeLambda(
+    [&]() {
+      for (auto& brush : brushes)
+      {
+        failures += brush.transform(worldBounds, rotation, false).is_success() ? 0u : 1u;
+      }
+    },
+    fmt::format("rotate {} brushes", brushes.size()));
+
+  CHECK(failures == 0u);
+}
+
+} // namespace tb::mdl
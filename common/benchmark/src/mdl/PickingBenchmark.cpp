@@ -0,0 +1,192 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushNode.h"
+#include "mdl/EditorContext.h"
+#include "mdl/LayerNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/PackedPlanes.h"
+#include "mdl/PickResult.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/result.h"
+#include "kdl/vector_utils.h"
+
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t BrushesPerAxis = 44;
+constexpr size_t NumRays = 1'000;
+
+/**
+ * Adds a grid of about 80k brushes of different sizes to the given world.
+ */
+std::vector<BrushNode*> addBrushes(WorldNode& world)
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto result = std::vector<BrushNode*>{};
+  world.disableNodeTreeUpdates();
+  for (size_t x = 0; x < BrushesPerAxis; ++x)
+  {
+    for (size_t y = 0; y < BrushesPerAxis; ++y)
+    {
+      for (size_t z = 0; z < BrushesPerAxis; ++z)
+      {
+        const auto min =
+          vm::vec3d{double(x) * 128.0, double(y) * 128.0, double(z) * 128.0}
+          - vm::vec3d{2816.0, 2816.0, 2816.0};
+        const auto size = double(16 + 16 * ((x + y + z) % 6));
+        auto* brushNode = new BrushNode{
+          builder.createCuboid(vm::bbox3d{min, min + vm::vec3d{size, size, size}}, "")
+          | kdl::value()};
+        world.defaultLayer()->addChild(brushNode);
+        result.push_back(brushNode);
+      }
+    }
+  }
+  world.rebuildNodeTree();
+  world.enableNodeTreeUpdates();
+
+  return result;
+}
+
+std::vector<vm::ray3d> makeRays()
+{
+  auto rng = std::mt19937{1};
+  auto position = std::uniform_real_distribution<double>{-4096.0, 4096.0};
+
+  auto result = std::vector<vm::ray3d>{};
+  for (size_t i = 0; i < NumRays; ++i)
+  {
+    const auto origin = vm::vec3d{position(rng), position(rng), position(rng)};
+    const auto target = vm::vec3d{position(rng), position(rng), position(rng)} / 2.0;
+    result.emplace_back(origin, vm::normalize(target - origin));
+  }
+  return result;
+}
+
+template <typename L>
+void timePicks(L&& lambda, const std::string& message)
+{
+  const auto start = std::chrono::high_resolution_clock::now();
+  lambda();
+  const auto end = std::chrono::high_resolution_clock::now();
+
+  const auto seconds = std::chrono::duration<double>(end - start).count();
+  printf(
+    "Picks per second for '%s': %.0f\n", message.c_str(), double(NumRays) / seconds);
+}
+
+} // namespace
+
+TEST_CASE("PickingBenchmark.pickWorld")
+{
+  auto world = WorldNode{{}, {}, MapFormat::Standard};
+  const auto brushes = addBrushes(world);
+  const auto rays = makeRays();
+  const auto editorContext = EditorContext{};
+
+  auto hitCount = size_t(0);
+  timePicks(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        auto pickResult = PickResult{};
+        world.pick(editorContext, ray, pickResult);
+        hitCount += pickResult.size();
+      }
+    },
+    fmt::format("pick {} brushes", brushes.size()));
+
+  CHECK(hitCount > 0);
+}
+
+TEST_CASE("PickingBenchmark.pickBrushes")
+{
+  auto world = WorldNode{{}, {}, MapFormat::Standard};
+  const auto brushes = addBrushes(world);
+  const auto rays = makeRays();
+
+  const auto facePlanes = kdl::vec_transform(brushes, [](const auto* brushNode) {
+    return PackedPlanes{kdl::vec_transform(
+      brushNode->brush().faces(), [](const auto& face) { return face.boundary(); })};
+  });
+
+  // test every ray against every brush without using the node tree
+  auto faceHitCount = size_t(0);
+  timePicks(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        for (const auto* brushNode : brushes)
+        {
+          for (const auto& face : brushNode->brush().faces())
+          {
+            if (face.intersectWithRay(ray))
+            {
+              ++faceHitCount;
+              break;
+            }
+          }
+        }
+      }
+    },
+    fmt::format("intersect faces of {} brushes one by one", brushes.size()));
+
+  auto packedHitCount = size_t(0);
+  timePicks(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        for (const auto& planes : facePlanes)
+        {
+          if (planes.intersectWithRay(ray))
+          {
+            ++packedHitCount;
+          }
+        }
+      }
+    },
+    fmt::format("intersect packed planes of {} brushes", brushes.size()));
+
+  // the counts can differ slightly because testing the faces one by one can miss rays
+  // that pass through an edge
+  printf("Brushes hit: %zu (faces), %zu (packed planes)\n", faceHitCount, packedHitCount);
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,103 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "InternedString.h"
+
+#include <array>
+#include <mutex>
+#include <ostream>
+#include <unordered_set>
+
+namespace tb
+{
+namespace
+{
+
+struct TransparentHash
+{
+  using is_transparent = void;
+
+  std::size_t operator()(const std::string_view string) const noexcept
+  {
+    return std::hash<std::string_view>{}(string);
+  }
+};
+
+struct Shard
+{
+  std::mutex mutex;
+  std::unordered_set<std::string, TransparentHash, std::equal_to<>> strings;
+};
+
+// The pool is split into shards so that threads interning different strings at the same
+// time, e.g. when parsing brushes in parallel, rarely contend for the same lock.
+constexpr auto ShardCount = size_t(16);
+
+const std::string* intern(const std::string_view string)
+{
+  static auto shards = std::array<Shard, ShardCount>{};
+
+  const auto hash = TransparentHash{}(string);
+  auto& shard = shards[hash % ShardCount];
+
+  const auto lock = std::lock_guard{shard.mutex};
+  auto it = shard.strings.find(string);
+  if (it == shard.strings.end())
+  {
+    it = shard.strings.emplace(string).first;
+  }
+
+  // unordered_set never moves its elements, so the returned pointer remains valid
+  return &*it;
+}
+
+} // namespace
+
+InternedString::InternedString()
+  : InternedString{std::string_view{}}
+{
+}
+
+InternedString::InternedString(const std::string_view string)
+  : m_string{intern(string)}
+{
+}
+
+const std::string& InternedString::str() const
+{
+  return *m_string;
+}
+
+bool operator==(const InternedString& lhs, const InternedString& rhs)
+{
+  return lhs.m_string == rhs.m_string;
+}
+
+std::strong_ordering operator<=>(const InternedString& lhs, const InternedString& rhs)
+{
+  return lhs.m_string == rhs.m_string ? std::strong_ordering::equal
+                                      : *lhs.m_string <=> *rhs.m_string;
+}
+
+std::ostream& operator<<(std::ostream& lhs, const InternedString& rhs)
+{
+  return lhs << rhs.str();
+}
+
+} // namespace tb
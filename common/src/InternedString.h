@@ -0,0 +1,75 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace tb
+{
+
+/**
+ * A string whose contents are stored in a process wide pool. Equal strings share the
+ * same pool entry, so an interned string is only as large as a pointer, and comparing
+ * two interned strings for equality is a pointer comparison.
+ *
+ * Pool entries are never released. This is intended for small sets of strings that are
+ * repeated many times, such as material names.
+ *
+ * Interning is thread safe.
+ */
+class InternedString
+{
+private:
+  const std::string* m_string;
+
+public:
+  /**
+   * Creates an empty interned string.
+   */
+  InternedString();
+
+  explicit InternedString(std::string_view string);
+
+  const std::string& str() const;
+
+  friend bool operator==(const InternedString& lhs, const InternedString& rhs);
+  friend std::strong_ordering operator<=>(
+    const InternedString& lhs, const InternedString& rhs);
+
+  friend std::ostream& operator<<(std::ostream& lhs, const InternedString& rhs);
+
+  friend struct std::hash<InternedString>;
+};
+
+} // namespace tb
+
+template <>
+struct std::hash<tb::InternedString>
+{
+  std::size_t operator()(const tb::InternedString& string) const noexcept
+  {
+    return std::hash<const std::string*>{}(string.m_string);
+  }
+};
@@ -129,6 +129,10 @@ extern Preference<bool> EnableMSAA;
 
 extern Preference<bool> AlignmentLock;
 extern Preference<bool> UVLock;
+/**
+ * The maximum amount of memory the undo history may use, in megabytes. 0 means unlimited.
+ */
+extern Preference<int> UndoMemoryBudget;
 
 Preference<std::filesystem::path>& RendererFontPath();
 extern Preference<int> RendererFontSize;
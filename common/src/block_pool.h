@@ -0,0 +1,262 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace tb
+{
+
+/**
+ * A pool of memory blocks of a fixed size, intended to back class specific operator new
+ * and operator delete for small objects that are allocated and freed in large numbers.
+ *
+ * Every thread keeps a cache of free blocks, so allocating and freeing a block does not
+ * require any synchronization in the common case. Blocks are carved from large chunks,
+ * so blocks that are allocated together are close to each other in memory. Free blocks
+ * are exchanged between the threads and a shared list in batches, so that blocks freed on
+ * one thread can be reused on another thread, and a thread returns its cached blocks to
+ * the shared list when it exits. Blocks that are allocated or freed on a thread after its
+ * cache was destroyed, e.g. during static destruction, go to the shared list directly.
+ *
+ * Chunks are never released to the system, so the memory used by a pool remains at the
+ * maximum number of blocks allocated at any time.
+ *
+ * @tparam Size the size of a block
+ * @tparam Align the alignment of a block
+ */
+template <std::size_t Size, std::size_t Align>
+class block_pool
+{
+private:
+  struct free_block
+  {
+    free_block* next;
+  };
+
+  static constexpr auto block_align = std::max(Align, alignof(free_block));
+  static constexpr auto block_size =
+    (std::max(Size, sizeof(free_block)) + block_align - 1) / block_align * block_align;
+  static constexpr auto batch_size = std::size_t(64);
+  static constexpr auto batches_per_chunk = std::size_t(16);
+
+  struct batch
+  {
+    free_block* head = nullptr;
+    std::size_t count = 0;
+  };
+
+  struct shared_state
+  {
+    std::mutex mutex;
+    std::vector<batch> batches;
+  };
+
+  struct local_cache
+  {
+    free_block* head = nullptr;
+    std::size_t count = 0;
+
+    local_cache() = default;
+
+    local_cache(const local_cache&) = delete;
+    local_cache& operator=(const local_cache&) = delete;
+
+    ~local_cache()
+    {
+      local_destroyed() = true;
+      if (head)
+      {
+        auto& shared = shared_instance();
+        const auto lock = std::lock_guard{shared.mutex};
+        shared.batches.push_back(batch{std::exchange(head, nullptr), count});
+      }
+    }
+  };
+
+  static shared_state& shared_instance()
+  {
+    // intentionally leaked, blocks may still be freed during static destruction
+    static auto* instance = new shared_state{};
+    return *instance;
+  }
+
+  static local_cache& local_instance()
+  {
+    thread_local auto instance = local_cache{};
+    return instance;
+  }
+
+  // Set when the calling thread's cache has been destroyed, i.e. while the thread's other
+  // thread local objects or, on the main thread, the static objects are destroyed. Being
+  // trivially destructible, the flag can still be accessed at that time.
+  static bool& local_destroyed()
+  {
+    thread_local auto destroyed = false;
+    return destroyed;
+  }
+
+  static batch allocate_chunk(shared_state& shared)
+  {
+    auto* chunk = static_cast<std::byte*>(::operator new(
+      block_size * batch_size * batches_per_chunk, std::align_val_t{block_align}));
+
+    auto result = batch{};
+    for (std::size_t i = 0; i < batches_per_chunk; ++i)
+    {
+      auto current = batch{};
+      for (std::size_t j = batch_size; j > 0; --j)
+      {
+        auto* block = new (chunk + (i * batch_size + j - 1) * block_size) free_block{};
+        block->next = std::exchange(current.head, block);
+        ++current.count;
+      }
+
+      if (i == 0)
+      {
+        result = current;
+      }
+      else
+      {
+        shared.batches.push_back(current);
+      }
+    }
+
+    return result;
+  }
+
+  static batch pop_batch(shared_state& shared)
+  {
+    if (shared.batches.empty())
+    {
+      return allocate_chunk(shared);
+    }
+
+    const auto result = shared.batches.back();
+    shared.batches.pop_back();
+    return result;
+  }
+
+  static void refill(local_cache& cache)
+  {
+    assert(cache.head == nullptr);
+
+    auto& shared = shared_instance();
+    const auto lock = std::lock_guard{shared.mutex};
+
+    const auto next = pop_batch(shared);
+    cache.head = next.head;
+    cache.count = next.count;
+  }
+
+  static void release_batch(local_cache& cache)
+  {
+    auto released = batch{cache.head, batch_size};
+
+    auto* last = cache.head;
+    for (std::size_t i = 1; i < batch_size; ++i)
+    {
+      last = last->next;
+    }
+
+    cache.head = std::exchange(last->next, nullptr);
+    cache.count -= batch_size;
+
+    auto& shared = shared_instance();
+    const auto lock = std::lock_guard{shared.mutex};
+    shared.batches.push_back(released);
+  }
+
+  static void* allocate_shared()
+  {
+    auto& shared = shared_instance();
+    const auto lock = std::lock_guard{shared.mutex};
+
+    const auto next = pop_batch(shared);
+    auto* block = next.head;
+    if (next.count > 1)
+    {
+      shared.batches.push_back(batch{block->next, next.count - 1});
+    }
+    return block;
+  }
+
+  static void deallocate_shared(void* ptr)
+  {
+    auto* block = new (ptr) free_block{nullptr};
+
+    auto& shared = shared_instance();
+    const auto lock = std::lock_guard{shared.mutex};
+    shared.batches.push_back(batch{block, 1});
+  }
+
+public:
+  static void* allocate()
+  {
+    if (local_destroyed())
+    {
+      return allocate_shared();
+    }
+
+    auto& cache = local_instance();
+    if (!cache.head)
+    {
+      refill(cache);
+    }
+
+    auto* block = cache.head;
+    cache.head = block->next;
+    --cache.count;
+    return block;
+  }
+
+  static void deallocate(void* ptr) noexcept
+  {
+    if (!ptr)
+    {
+      return;
+    }
+
+    if (local_destroyed())
+    {
+      deallocate_shared(ptr);
+      return;
+    }
+
+    auto& cache = local_instance();
+    auto* block = new (ptr) free_block{cache.head};
+    cache.head = block;
+
+    // keep the cache from growing without bounds if a thread frees many blocks that were
+    // allocated by other threads
+    if (++cache.count >= 2 * batch_size)
+    {
+      release_batch(cache);
+    }
+  }
+};
+
+} // namespace tb
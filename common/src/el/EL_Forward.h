@@ -25,6 +25,7 @@ class Value;
 enum class ValueType;
 
 class ExpressionNode;
+class CompiledExpression;
 
 class EvaluationContext;
 class EvaluationTrace;
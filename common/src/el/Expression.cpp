@@ -19,10 +19,12 @@
 
 #include "Expression.h"
 
+#include "Macros.h"
 #include "Value.h"
 #include "el/ELExceptions.h"
 #include "el/EvaluationContext.h"
 #include "el/EvaluationTrace.h"
+#include "el/VariableStore.h"
 
 #include "kdl/map_utils.h"
 #include "kdl/overload.h"
@@ -32,7 +34,14 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <iterator>
+#include <optional>
 #include <ranges>
+#include <span>
 #include <sstream>
 
 namespace tb::el
@@ -1050,6 +1059,395 @@ Expression optimizeExpression(const Expression& expression)
 }
 
 
+class Compiler
+{
+private:
+  using Opcode = CompiledExpression::Opcode;
+  using Instruction = CompiledExpression::Instruction;
+
+  std::vector<Instruction> m_instructions;
+  std::vector<Value> m_constants;
+  std::vector<std::string> m_variableNames;
+  std::vector<std::string> m_keys;
+  size_t m_stackSize = 0;
+  size_t m_maxStackSize = 0;
+
+public:
+  void compile(const ExpressionNode& node)
+  {
+    node.accept([&](const auto& expression) { compile(expression); });
+  }
+
+  CompiledExpression result() &&
+  {
+    assert(m_stackSize == 1);
+
+    // variables that are loaded only once are not stored in their slots
+    auto loadCounts = std::vector<std::uint32_t>(m_variableNames.size(), 0);
+    for (const auto& instruction : m_instructions)
+    {
+      if (instruction.opcode == Opcode::LoadVariable)
+      {
+        ++loadCounts[instruction.operand];
+      }
+    }
+    for (auto& instruction : m_instructions)
+    {
+      if (instruction.opcode == Opcode::LoadVariable)
+      {
+        instruction.count = loadCounts[instruction.operand];
+      }
+    }
+
+    return CompiledExpression{
+      std::move(m_instructions),
+      std::move(m_constants),
+      std::move(m_variableNames),
+      std::move(m_keys),
+      m_maxStackSize};
+  }
+
+private:
+  void compile(const LiteralExpression& expression)
+  {
+    emitLoadConstant(expression.value);
+  }
+
+  void compile(const VariableExpression& expression)
+  {
+    const auto it = std::ranges::find(m_variableNames, expression.variableName);
+    const auto slot = std::distance(m_variableNames.begin(), it);
+    if (it == m_variableNames.end())
+    {
+      m_variableNames.push_back(expression.variableName);
+    }
+
+    emit(Opcode::LoadVariable, size_t(slot));
+    push(1);
+  }
+
+  void compile(const ArrayExpression& expression)
+  {
+    for (const auto& element : expression.elements)
+    {
+      compile(element);
+    }
+
+    emit(Opcode::MakeArray, 0, expression.elements.size());
+    pop(expression.elements.size());
+    push(1);
+  }
+
+  void compile(const MapExpression& expression)
+  {
+    const auto firstKey = m_keys.size();
+    for (const auto& [key, element] : expression.elements)
+    {
+      m_keys.push_back(key);
+      compile(element);
+    }
+
+    emit(Opcode::MakeMap, firstKey, expression.elements.size());
+    pop(expression.elements.size());
+    push(1);
+  }
+
+  void compile(const UnaryExpression& expression)
+  {
+    compile(expression.operand);
+    emit(Opcode::Unary, size_t(expression.operation));
+  }
+
+  void compile(const BinaryExpression& expression)
+  {
+    compile(expression.leftOperand);
+
+    switch (expression.operation)
+    {
+    case BinaryOperation::LogicalAnd:
+      compileShortCircuit(expression, Opcode::BeginLogicalAnd, Opcode::EndLogicalAnd);
+      break;
+    case BinaryOperation::LogicalOr:
+      compileShortCircuit(expression, Opcode::BeginLogicalOr, Opcode::EndLogicalOr);
+      break;
+    case BinaryOperation::Case: {
+      const auto begin = emit(Opcode::BeginCase);
+      pop(1);
+      compile(expression.rightOperand);
+      patchJump(begin);
+      break;
+    }
+    case BinaryOperation::Addition:
+    case BinaryOperation::Subtraction:
+    case BinaryOperation::Multiplication:
+    case BinaryOperation::Division:
+    case BinaryOperation::Modulus:
+    case BinaryOperation::BitwiseAnd:
+    case BinaryOperation::BitwiseXOr:
+    case BinaryOperation::BitwiseOr:
+    case BinaryOperation::BitwiseShiftLeft:
+    case BinaryOperation::BitwiseShiftRight:
+    case BinaryOperation::Less:
+    case BinaryOperation::LessOrEqual:
+    case BinaryOperation::Greater:
+    case BinaryOperation::GreaterOrEqual:
+    case BinaryOperation::Equal:
+    case BinaryOperation::NotEqual:
+    case BinaryOperation::BoundedRange:
+      compile(expression.rightOperand);
+      emit(Opcode::Binary, size_t(expression.operation));
+      pop(1);
+      break;
+      switchDefault();
+    }
+  }
+
+  void compile(const SubscriptExpression& expression)
+  {
+    compile(expression.leftOperand);
+    compile(expression.rightOperand);
+    emit(Opcode::Subscript);
+    pop(1);
+  }
+
+  void compile(const SwitchExpression& expression)
+  {
+    auto ends = std::vector<size_t>{};
+    for (const auto& case_ : expression.cases)
+    {
+      compile(case_);
+      ends.push_back(emit(Opcode::EndSwitchCase));
+      pop(1);
+    }
+
+    emitLoadConstant(Value::Undefined);
+    std::ranges::for_each(ends, [&](const auto i) { patchJump(i); });
+  }
+
+  void compileShortCircuit(
+    const BinaryExpression& expression, const Opcode beginOpcode, const Opcode endOpcode)
+  {
+    const auto begin = emit(beginOpcode);
+    compile(expression.rightOperand);
+    emit(endOpcode);
+    pop(1);
+    patchJump(begin);
+  }
+
+  void emitLoadConstant(Value value)
+  {
+    emit(Opcode::LoadConstant, constantIndex(std::move(value)));
+    push(1);
+  }
+
+  size_t constantIndex(Value value)
+  {
+    // 0 and -0 compare equal, but they are not interchangeable
+    const auto isSameConstant = [&](const Value& constant) {
+      return constant == value
+             && (value.type() != ValueType::Number
+                 || std::signbit(constant.numberValue()) == std::signbit(value.numberValue()));
+    };
+
+    if (const auto it = std::ranges::find_if(m_constants, isSameConstant);
+        it != m_constants.end())
+    {
+      return static_cast<size_t>(std::distance(m_constants.begin(), it));
+    }
+
+    m_constants.push_back(std::move(value));
+    return m_constants.size() - 1;
+  }
+
+  size_t emit(const Opcode opcode, const size_t operand = 0, const size_t count = 0)
+  {
+    m_instructions.push_back(Instruction{
+      opcode, static_cast<std::uint32_t>(operand), static_cast<std::uint32_t>(count)});
+    return m_instructions.size() - 1;
+  }
+
+  void patchJump(const size_t i)
+  {
+    m_instructions[i].operand = static_cast<std::uint32_t>(m_instructions.size());
+  }
+
+  void push(const size_t count)
+  {
+    m_stackSize += count;
+    m_maxStackSize = std::max(m_maxStackSize, m_stackSize);
+  }
+
+  void pop(const size_t count)
+  {
+    assert(m_stackSize >= count);
+    m_stackSize -= count;
+  }
+};
+
+/**
+ * The stack of a compiled expression's evaluation. The variable slots are stored below
+ * the stack. Typical expressions fit into the inline storage, so that evaluating them does
+ * not allocate memory for the stack.
+ */
+class ValueStack
+{
+private:
+  static constexpr size_t InlineCapacity = 16;
+
+  std::array<std::optional<Value>, InlineCapacity> m_inlineValues;
+  std::vector<std::optional<Value>> m_heapValues;
+  std::span<std::optional<Value>> m_values;
+  size_t m_slotCount;
+  size_t m_size;
+
+public:
+  ValueStack(const size_t slotCount, const size_t maxSize)
+    : m_slotCount{slotCount}
+    , m_size{slotCount}
+  {
+    const auto capacity = slotCount + maxSize;
+    if (capacity > InlineCapacity)
+    {
+      m_heapValues.resize(capacity);
+      m_values = m_heapValues;
+    }
+    else
+    {
+      m_values = m_inlineValues;
+    }
+  }
+
+  std::optional<Value>& slot(const size_t i) { return m_values[i]; }
+
+  size_t size() const { return m_size - m_slotCount; }
+
+  Value& back(const size_t offset = 0) { return *m_values[m_size - offset - 1]; }
+
+  std::span<std::optional<Value>> top(const size_t count)
+  {
+    return m_values.subspan(m_size - count, count);
+  }
+
+  void push(Value value) { m_values[m_size++] = std::move(value); }
+
+  void pop(const size_t count)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      m_values[--m_size].reset();
+    }
+  }
+
+  void replaceTop(const size_t count, Value value)
+  {
+    pop(count);
+    push(std::move(value));
+  }
+
+  deleteCopyAndMove(ValueStack);
+};
+
+const auto True = Value{true};
+const auto False = Value{false};
+
+/**
+ * Converts the given value to a boolean without creating a value for the common cases.
+ */
+bool isTrue(const Value& value)
+{
+  switch (value.type())
+  {
+  case ValueType::Boolean:
+    return value.booleanValue();
+  case ValueType::Number:
+    return value.numberValue() != 0.0;
+  case ValueType::String:
+  case ValueType::Array:
+  case ValueType::Map:
+  case ValueType::Range:
+  case ValueType::Null:
+  case ValueType::Undefined:
+    break;
+  }
+  return value.convertTo(ValueType::Boolean).booleanValue();
+}
+
+/**
+ * Evaluates the given comparison without creating a value for its result.
+ */
+std::optional<Value> tryEvaluateComparison(
+  const BinaryOperation operation, const Value& lhs, const Value& rhs)
+{
+  switch (operation)
+  {
+  case BinaryOperation::Less:
+    return evaluateCompare(lhs, rhs) < 0 ? True : False;
+  case BinaryOperation::LessOrEqual:
+    return evaluateCompare(lhs, rhs) <= 0 ? True : False;
+  case BinaryOperation::Greater:
+    return evaluateCompare(lhs, rhs) > 0 ? True : False;
+  case BinaryOperation::GreaterOrEqual:
+    return evaluateCompare(lhs, rhs) >= 0 ? True : False;
+  case BinaryOperation::Equal:
+    return evaluateCompare(lhs, rhs) == 0 ? True : False;
+  case BinaryOperation::NotEqual:
+    return evaluateCompare(lhs, rhs) != 0 ? True : False;
+  case BinaryOperation::Addition:
+  case BinaryOperation::Subtraction:
+  case BinaryOperation::Multiplication:
+  case BinaryOperation::Division:
+  case BinaryOperation::Modulus:
+  case BinaryOperation::LogicalAnd:
+  case BinaryOperation::LogicalOr:
+  case BinaryOperation::BitwiseAnd:
+  case BinaryOperation::BitwiseXOr:
+  case BinaryOperation::BitwiseOr:
+  case BinaryOperation::BitwiseShiftLeft:
+  case BinaryOperation::BitwiseShiftRight:
+  case BinaryOperation::BoundedRange:
+  case BinaryOperation::Case:
+    break;
+  }
+  return std::nullopt;
+}
+
+/**
+ * Returns the value of a logical and if it is decided by its left operand alone.
+ */
+std::optional<Value> shortCircuitLogicalAnd(const Value& lhs)
+{
+  if (lhs.hasType(ValueType::Undefined))
+  {
+    return Value::Undefined;
+  }
+
+  if (lhs.hasType(ValueType::Boolean, ValueType::Null) && !isTrue(lhs))
+  {
+    return False;
+  }
+
+  return std::nullopt;
+}
+
+/**
+ * Returns the value of a logical or if it is decided by its left operand alone.
+ */
+std::optional<Value> shortCircuitLogicalOr(const Value& lhs)
+{
+  if (lhs.hasType(ValueType::Undefined))
+  {
+    return Value::Undefined;
+  }
+
+  if (lhs.hasType(ValueType::Boolean, ValueType::Null) && isTrue(lhs))
+  {
+    return True;
+  }
+
+  return std::nullopt;
+}
+
+
 size_t precedence(const BinaryOperation operation)
 {
   switch (operation)
@@ -1177,6 +1575,13 @@ ExpressionNode ExpressionNode::optimize() const
     std::make_shared<Expression>(optimizeExpression(*m_expression)), m_location};
 }
 
+CompiledExpression ExpressionNode::compile() const
+{
+  auto compiler = Compiler{};
+  compiler.compile(*this);
+  return std::move(compiler).result();
+}
+
 const std::optional<FileLocation>& ExpressionNode::location() const
 {
   return m_location;
@@ -1191,7 +1596,8 @@ std::string ExpressionNode::asString() const
 
 bool operator==(const ExpressionNode& lhs, const ExpressionNode& rhs)
 {
-  return *lhs.m_expression == *rhs.m_expression;
+  // copies of an expression node share their expression
+  return lhs.m_expression == rhs.m_expression || *lhs.m_expression == *rhs.m_expression;
 }
 
 bool operator!=(const ExpressionNode& lhs, const ExpressionNode& rhs)
@@ -1199,6 +1605,203 @@ bool operator!=(const ExpressionNode& lhs, const ExpressionNode& rhs)
   return !(lhs == rhs);
 }
 
+CompiledExpression::CompiledExpression(
+  std::vector<Instruction> instructions,
+  std::vector<Value> constants,
+  std::vector<std::string> variableNames,
+  std::vector<std::string> keys,
+  const size_t maxStackSize)
+  : m_instructions{std::move(instructions)}
+  , m_constants{std::move(constants)}
+  , m_variableNames{std::move(variableNames)}
+  , m_keys{std::move(keys)}
+  , m_maxStackSize{maxStackSize}
+{
+}
+
+const std::vector<CompiledExpression::Instruction>& CompiledExpression::instructions()
+  const
+{
+  return m_instructions;
+}
+
+const std::vector<Value>& CompiledExpression::constants() const
+{
+  return m_constants;
+}
+
+Value CompiledExpression::evaluate(const EvaluationContext& context) const
+{
+  return evaluateWith([&](const auto& name) { return context.variableValue(name); });
+}
+
+Value CompiledExpression::evaluate(const VariableStore& store) const
+{
+  return evaluateWith([&](const auto& name) { return store.value(name); });
+}
+
+template <typename LookupVariable>
+Value CompiledExpression::evaluateWith(const LookupVariable& lookupVariable) const
+{
+  if (m_instructions.size() == 1)
+  {
+    const auto& instruction = m_instructions.front();
+    if (instruction.opcode == Opcode::LoadConstant)
+    {
+      return m_constants[instruction.operand];
+    }
+    if (instruction.opcode == Opcode::LoadVariable)
+    {
+      return lookupVariable(m_variableNames[instruction.operand]);
+    }
+  }
+
+  auto stack = ValueStack{m_variableNames.size(), m_maxStackSize};
+
+  auto i = size_t(0);
+  while (i < m_instructions.size())
+  {
+    const auto& instruction = m_instructions[i++];
+    switch (instruction.opcode)
+    {
+    case Opcode::LoadConstant:
+      stack.push(m_constants[instruction.operand]);
+      break;
+    case Opcode::LoadVariable: {
+      const auto& name = m_variableNames[instruction.operand];
+      if (instruction.count == 1)
+      {
+        stack.push(lookupVariable(name));
+      }
+      else
+      {
+        auto& variable = stack.slot(instruction.operand);
+        if (!variable)
+        {
+          variable = lookupVariable(name);
+        }
+        stack.push(*variable);
+      }
+      break;
+    }
+    case Opcode::MakeArray: {
+      auto array = ArrayType{};
+      array.reserve(instruction.count);
+      for (auto& value : stack.top(instruction.count))
+      {
+        if (value->hasType(ValueType::Range))
+        {
+          const auto& range = std::get<BoundedRange>(value->rangeValue());
+          array.reserve(array.size() + range.length());
+          range.forEach([&](const auto j) { array.emplace_back(j); });
+        }
+        else
+        {
+          array.push_back(std::move(*value));
+        }
+      }
+
+      stack.replaceTop(instruction.count, Value{std::move(array)});
+      break;
+    }
+    case Opcode::MakeMap: {
+      auto map = MapType{};
+      auto key = std::next(m_keys.begin(), std::ptrdiff_t(instruction.operand));
+      for (auto& value : stack.top(instruction.count))
+      {
+        map.emplace(*key++, std::move(*value));
+      }
+
+      stack.replaceTop(instruction.count, Value{std::move(map)});
+      break;
+    }
+    case Opcode::Unary:
+      stack.back() = evaluateUnaryExpression(
+        static_cast<UnaryOperation>(instruction.operand), stack.back());
+      break;
+    case Opcode::Binary: {
+      const auto operation = static_cast<BinaryOperation>(instruction.operand);
+      const auto& lhs = stack.back(1);
+      const auto& rhs = stack.back();
+      if (auto value = tryEvaluateComparison(operation, lhs, rhs))
+      {
+        stack.replaceTop(2, std::move(*value));
+      }
+      else
+      {
+        stack.replaceTop(
+          2,
+          evaluateBinaryExpression(
+            operation,
+            [&]() -> const Value& { return lhs; },
+            [&]() -> const Value& { return rhs; }));
+      }
+      break;
+    }
+    case Opcode::Subscript:
+      stack.replaceTop(2, stack.back(1)[stack.back()]);
+      break;
+    case Opcode::BeginLogicalAnd:
+      if (auto value = shortCircuitLogicalAnd(stack.back()))
+      {
+        stack.back() = std::move(*value);
+        i = instruction.operand;
+      }
+      break;
+    case Opcode::EndLogicalAnd: {
+      const auto& lhs = stack.back(1);
+      const auto& rhs = stack.back();
+      stack.replaceTop(
+        2,
+        evaluateLogicalAnd(
+          [&]() -> const Value& { return lhs; }, [&]() -> const Value& { return rhs; }));
+      break;
+    }
+    case Opcode::BeginLogicalOr:
+      if (auto value = shortCircuitLogicalOr(stack.back()))
+      {
+        stack.back() = std::move(*value);
+        i = instruction.operand;
+      }
+      break;
+    case Opcode::EndLogicalOr: {
+      const auto& lhs = stack.back(1);
+      const auto& rhs = stack.back();
+      stack.replaceTop(
+        2,
+        evaluateLogicalOr(
+          [&]() -> const Value& { return lhs; }, [&]() -> const Value& { return rhs; }));
+      break;
+    }
+    case Opcode::BeginCase:
+      if (stack.back().type() != ValueType::Undefined && isTrue(stack.back()))
+      {
+        stack.pop(1);
+      }
+      else
+      {
+        stack.back() = Value::Undefined;
+        i = instruction.operand;
+      }
+      break;
+    case Opcode::EndSwitchCase:
+      if (stack.back() != Value::Undefined)
+      {
+        i = instruction.operand;
+      }
+      else
+      {
+        stack.pop(1);
+      }
+      break;
+      switchDefault();
+    }
+  }
+
+  assert(stack.size() == 1);
+  return std::move(stack.back());
+}
+
 std::ostream& operator<<(std::ostream& lhs, const ExpressionNode& rhs)
 {
   lhs << *rhs.m_expression;
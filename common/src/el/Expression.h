@@ -23,6 +23,7 @@
 #include "el/EL_Forward.h"
 #include "el/Value.h"
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -125,6 +126,13 @@ public:
 
   ExpressionNode optimize() const;
 
+  /**
+   * Lowers this expression to a flat sequence of instructions that can be evaluated
+   * without visiting the expression tree. Optimize the expression first to fold its
+   * constant subexpressions.
+   */
+  CompiledExpression compile() const;
+
   const std::optional<FileLocation>& location() const;
 
   std::string asString() const;
@@ -263,6 +271,86 @@ bool operator!=(const SwitchExpression& lhs, const SwitchExpression& rhs);
 
 std::ostream& operator<<(std::ostream& lhs, const SwitchExpression& rhs);
 
+
+/**
+ * An expression that was lowered to a flat sequence of instructions for a stack machine.
+ * Evaluating a compiled expression yields the same value as evaluating the expression it
+ * was compiled from, but every variable is given a slot when compiling and is looked up
+ * at most once per evaluation.
+ *
+ * Compiled expressions cannot be traced.
+ */
+class CompiledExpression
+{
+public:
+  enum class Opcode : std::uint8_t
+  {
+    /** Pushes the constant at index operand. */
+    LoadConstant,
+    /** Pushes the variable in slot operand, which is loaded count times in total. */
+    LoadVariable,
+    /** Replaces the top count values with an array, expanding any ranges. */
+    MakeArray,
+    /** Replaces the top count values with a map using the keys starting at operand. */
+    MakeMap,
+    /** Applies the UnaryOperation operand to the top value. */
+    Unary,
+    /** Applies the non short circuiting BinaryOperation operand to the top two values. */
+    Binary,
+    /** Replaces the top two values with the left value subscripted by the right one. */
+    Subscript,
+    /** Jumps to operand if the left operand on top decides a logical and by itself. */
+    BeginLogicalAnd,
+    /** Replaces the top two values with their logical and. */
+    EndLogicalAnd,
+    /** Jumps to operand if the left operand on top decides a logical or by itself. */
+    BeginLogicalOr,
+    /** Replaces the top two values with their logical or. */
+    EndLogicalOr,
+    /** Pops the top value if it is true, otherwise replaces it and jumps to operand. */
+    BeginCase,
+    /** Jumps to operand if the top value is defined, otherwise pops it. */
+    EndSwitchCase,
+  };
+
+  struct Instruction
+  {
+    Opcode opcode;
+    std::uint32_t operand = 0;
+    std::uint32_t count = 0;
+  };
+
+private:
+  std::vector<Instruction> m_instructions;
+  std::vector<Value> m_constants;
+  std::vector<std::string> m_variableNames;
+  std::vector<std::string> m_keys;
+  size_t m_maxStackSize = 0;
+
+public:
+  CompiledExpression(
+    std::vector<Instruction> instructions,
+    std::vector<Value> constants,
+    std::vector<std::string> variableNames,
+    std::vector<std::string> keys,
+    size_t maxStackSize);
+
+  const std::vector<Instruction>& instructions() const;
+  const std::vector<Value>& constants() const;
+
+  Value evaluate(const EvaluationContext& context) const;
+
+  /**
+   * Evaluates this expression by looking up the variables in the given store directly,
+   * which avoids the copy of the store that an EvaluationContext makes.
+   */
+  Value evaluate(const VariableStore& store) const;
+
+private:
+  template <typename LookupVariable>
+  Value evaluateWith(const LookupVariable& lookupVariable) const;
+};
+
 template <typename Visitor>
 VisitorResultType_t<Visitor> ExpressionNode::accept(const Visitor& visitor) const
 {
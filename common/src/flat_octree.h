@@ -0,0 +1,1008 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Exceptions.h"
+#include "octree.h"
+
+#include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tb
+{
+
+/**
+ * A spatial index with the same semantics as octree, but with a flat memory layout.
+ *
+ * The nodes are stored in a contiguous pool, and the eight children of a node are stored
+ * next to each other. The bounds of the nodes are stored in separate arrays per axis so
+ * that testing the children of a node against a query only touches the bounds. The data
+ * of all nodes is stored in a single array where every node owns a contiguous slice. A
+ * node's slice is moved to the end of the array when it runs out of room, and the array
+ * is compacted when too much of it is unused.
+ *
+ * Unlike octree, the tree is not path compressed: every node on the path from the root to
+ * the container of a data item is present.
+ *
+ * The query functions pass the found data items to a visitor and do not allocate memory.
+ *
+ * @tparam T the floating point type
+ * @tparam U the node data to store in the nodes, must be default constructible
+ */
+template <typename T, typename U>
+class flat_octree
+{
+private:
+  static constexpr auto invalid_index = std::numeric_limits<uint32_t>::max();
+  static constexpr auto min_data_capacity = uint32_t(4);
+  // the tree is rebuilt if more than this fraction of its items move in a batched update
+  static constexpr auto rebuild_divisor = size_t(4);
+
+  struct node
+  {
+    detail::node_address address;
+    uint32_t parent = invalid_index;
+    // the index of the first of the eight children of this node, if any
+    uint32_t children = invalid_index;
+    // the number of data items stored in this node and its descendants
+    uint32_t item_count = 0;
+    // the slice of m_data that contains the data stored in this node
+    uint32_t data_offset = 0;
+    uint32_t data_size = 0;
+    uint32_t data_capacity = 0;
+  };
+
+  struct data_location
+  {
+    uint32_t node;
+    uint32_t slot;
+  };
+
+  T m_min_size;
+
+  std::vector<node> m_nodes;
+  std::array<std::vector<T>, 3> m_node_min;
+  std::array<std::vector<T>, 3> m_node_max;
+  std::vector<uint32_t> m_free_children;
+
+  std::vector<U> m_data;
+  size_t m_unused_data = 0;
+  std::unordered_map<U, data_location> m_location_for_data;
+
+public:
+  explicit flat_octree(const T min_size)
+    : m_min_size{min_size}
+  {
+  }
+
+  /**
+   * Indicates whether a node with the given data exists in this tree.
+   *
+   * @param data the data to find
+   * @return true if a node with the given data exists and false otherwise
+   */
+  bool contains(const U& data) const { return m_location_for_data.count(data) > 0; }
+
+  /**
+   * Replaces the contents of this tree with the given data items.
+   *
+   * The items are sorted by the Morton codes of their node addresses, which is the order
+   * in which a depth first traversal visits their nodes. Consecutive items then share
+   * most of their path from the root, so every node is found by walking up and down a
+   * few levels from the previous item's node. All nodes are created before any data is
+   * stored, and the data of every node is stored in a slice that fits exactly, so this is
+   * faster than inserting the items one by one and the resulting tree is more compact.
+   *
+   * @param items the bounds and data of the items to store
+   *
+   * @throws NodeTreeException if any bounds are invalid or if any data occurs twice
+   */
+  void build(const std::vector<std::pair<vm::bbox<T, 3>, U>>& items)
+  {
+    auto addressed_items = std::vector<std::pair<detail::node_address, U>>{};
+    addressed_items.reserve(items.size());
+    for (const auto& [bounds, data] : items)
+    {
+      check(bounds);
+      addressed_items.emplace_back(detail::get_container(bounds, m_min_size), data);
+    }
+
+    build_at(std::move(addressed_items));
+  }
+
+  void insert(const vm::bbox<T, 3>& bounds, U data)
+  {
+    check(bounds);
+
+    if (contains(data))
+    {
+      throw NodeTreeException("Data already in tree");
+    }
+
+    insert_at(detail::get_container(bounds, m_min_size), std::move(data));
+  }
+
+  /**
+   * Removes the node with the given data from this tree.
+   *
+   * @param data the data to remove
+   * @return true if a node with the given data was removed, and false otherwise
+   */
+  bool remove(const U& data)
+  {
+    const auto i_location = m_location_for_data.find(data);
+    if (i_location == m_location_for_data.end())
+    {
+      return false;
+    }
+
+    const auto location = i_location->second;
+    m_location_for_data.erase(i_location);
+
+    if (m_location_for_data.empty())
+    {
+      clear();
+      return true;
+    }
+
+    // move the last data of the node into the vacated slot
+    auto& node = m_nodes[location.node];
+    const auto last_slot = --node.data_size;
+    if (location.slot != last_slot)
+    {
+      auto& moved_data = m_data[node.data_offset + location.slot];
+      moved_data = std::move(m_data[node.data_offset + last_slot]);
+      m_location_for_data[moved_data].slot = location.slot;
+    }
+    m_data[node.data_offset + last_slot] = U{};
+
+    for (auto node_index = location.node; node_index != invalid_index;
+         node_index = m_nodes[node_index].parent)
+    {
+      auto& ancestor = m_nodes[node_index];
+      --ancestor.item_count;
+
+      // the children of an empty node are empty, and their children have already been
+      // released
+      if (ancestor.item_count == 0 && ancestor.children != invalid_index)
+      {
+        release_children(node_index);
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Updates the node with the given data with the given new bounds.
+   *
+   * @param newBounds the new bounds of the node
+   * @param data the node data of the node to update
+   *
+   * @throws NodeTreeException if no node with the given data can be found in this tree
+   */
+  void update(const vm::bbox<T, 3>& newBounds, const U& data)
+  {
+    check(newBounds);
+
+    const auto i_location = m_location_for_data.find(data);
+    if (i_location == m_location_for_data.end())
+    {
+      throw NodeTreeException("node not found");
+    }
+
+    const auto address = detail::get_container(newBounds, m_min_size);
+    if (!is_in_place(i_location->second.node, address))
+    {
+      auto data_ = data;
+      remove(data_);
+      insert_at(address, std::move(data_));
+    }
+  }
+
+  /**
+   * Updates the nodes with the given data with the given new bounds in one pass.
+   *
+   * Items that remain in their nodes are not touched. If many items have to move to
+   * other nodes, the tree is rebuilt from scratch, otherwise the moved items are removed
+   * and inserted again.
+   *
+   * @param items the new bounds and the data of the nodes to update, every data item
+   * must occur at most once
+   *
+   * @throws NodeTreeException if any bounds are invalid or if no node with any of the
+   * given data can be found in this tree
+   */
+  void update(const std::vector<std::pair<vm::bbox<T, 3>, U>>& items)
+  {
+    auto moved_items = std::vector<std::pair<detail::node_address, U>>{};
+    auto moved_locations = std::vector<data_location>{};
+    for (const auto& [bounds, data] : items)
+    {
+      check(bounds);
+
+      const auto i_location = m_location_for_data.find(data);
+      if (i_location == m_location_for_data.end())
+      {
+        throw NodeTreeException("node not found");
+      }
+
+      const auto address = detail::get_container(bounds, m_min_size);
+      if (!is_in_place(i_location->second.node, address))
+      {
+        moved_items.emplace_back(address, data);
+        moved_locations.push_back(i_location->second);
+      }
+    }
+
+    if (moved_items.size() > m_location_for_data.size() / rebuild_divisor)
+    {
+      auto new_addresses = std::vector<std::optional<detail::node_address>>(m_data.size());
+      for (size_t i = 0; i < moved_items.size(); ++i)
+      {
+        const auto& location = moved_locations[i];
+        new_addresses[m_nodes[location.node].data_offset + location.slot] =
+          moved_items[i].first;
+      }
+
+      // the data in the root node is stored at the root address again
+      auto all_items = std::vector<std::pair<detail::node_address, U>>{};
+      all_items.reserve(m_location_for_data.size());
+      visit_nodes(0, [&](const node& current) {
+        for (auto i = current.data_offset; i < current.data_offset + current.data_size;
+             ++i)
+        {
+          all_items.emplace_back(
+            new_addresses[i].value_or(current.address), std::move(m_data[i]));
+        }
+      });
+
+      build_at(std::move(all_items));
+    }
+    else
+    {
+      for (auto& [address, data] : moved_items)
+      {
+        remove(data);
+        insert_at(address, std::move(data));
+      }
+    }
+  }
+
+  /**
+   * Clears this node tree.
+   */
+  void clear()
+  {
+    m_nodes.clear();
+    for (size_t i = 0; i < 3; ++i)
+    {
+      m_node_min[i].clear();
+      m_node_max[i].clear();
+    }
+    m_free_children.clear();
+    m_data.clear();
+    m_unused_data = 0;
+    m_location_for_data.clear();
+  }
+
+  /**
+   * Indicates whether this tree is empty.
+   *
+   * @return true if this tree is empty and false otherwise
+   */
+  bool empty() const { return m_nodes.empty(); }
+
+  /**
+   * Passes every data item in this tree whose bounding box intersects with the given ray
+   * to the given visitor.
+   *
+   * @tparam F the visitor type
+   * @param ray the ray to test
+   * @param visitor the visitor to call for every found data item
+   */
+  template <typename F>
+  void visit_intersectors(const vm::ray<T, 3>& ray, const F& visitor) const
+  {
+    const auto inverse_direction = vm::vec<T, 3>{
+      T(1) / ray.direction.x(), T(1) / ray.direction.y(), T(1) / ray.direction.z()};
+
+    visit_if(
+      [&](const uint32_t first_node_index, auto& hits) {
+        intersect_ray(ray, inverse_direction, first_node_index, hits);
+      },
+      visitor);
+  }
+
+  /**
+   * Passes every data item in this tree whose bounding box intersects with the given
+   * bbox to the given visitor.
+   *
+   * @tparam F the visitor type
+   * @param bbox the bbox to test
+   * @param visitor the visitor to call for every found data item
+   */
+  template <typename F>
+  void visit_intersectors(const vm::bbox<T, 3>& bbox, const F& visitor) const
+  {
+    visit_if(
+      [&](const uint32_t first_node_index, auto& hits) {
+        intersect_bbox(bbox, first_node_index, hits);
+      },
+      visitor);
+  }
+
+  /**
+   * Passes every data item in this tree whose bounding box contains the given point to
+   * the given visitor.
+   *
+   * @tparam F the visitor type
+   * @param point the point to test
+   * @param visitor the visitor to call for every found data item
+   */
+  template <typename F>
+  void visit_containers(const vm::vec<T, 3>& point, const F& visitor) const
+  {
+    visit_if(
+      [&](const uint32_t first_node_index, auto& hits) {
+        contains_point(point, first_node_index, hits);
+      },
+      visitor);
+  }
+
+  /**
+   * Passes every data item in this tree whose bounding box may not be contained in the
+   * given bbox to the given visitor.
+   *
+   * Since every item is stored in a node whose bounds contain the item's bounds, any
+   * subtree whose bounds are contained in the given bbox is skipped entirely. Items that
+   * are stored in a node which straddles the boundary of the given bbox are visited even
+   * if their bounds are contained in it, so the visitor must check the items itself.
+   *
+   * @tparam F the visitor type
+   * @param bbox the bbox to test
+   * @param visitor the visitor to call for every found data item
+   */
+  template <typename F>
+  void visit_non_containees(const vm::bbox<T, 3>& bbox, const F& visitor) const
+  {
+    visit_if(
+      [&](const uint32_t first_node_index, auto& hits) {
+        not_contained_in_bbox(bbox, first_node_index, hits);
+      },
+      visitor);
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given ray
+   * and returns a list of those items.
+   *
+   * @param ray the ray to test
+   * @return a list containing all found data items
+   */
+  std::vector<U> find_intersectors(const vm::ray<T, 3>& ray) const
+  {
+    auto result = std::vector<U>{};
+    find_intersectors(ray, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given ray
+   * and appends it to the given output iterator.
+   *
+   * @tparam O the output iterator type
+   * @param ray the ray to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_intersectors(const vm::ray<T, 3>& ray, O out) const
+  {
+    visit_intersectors(ray, [&](const U& data) { *out++ = data; });
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given bbox
+   * and returns a list of those items.
+   *
+   * @param bbox the bbox to test
+   * @return a list containing all found data items
+   */
+  std::vector<U> find_intersectors(const vm::bbox<T, 3>& bbox) const
+  {
+    auto result = std::vector<U>{};
+    find_intersectors(bbox, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given bbox
+   * and appends it to the given output iterator.
+   *
+   * @tparam O the output iterator type
+   * @param bbox the bbox to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_intersectors(const vm::bbox<T, 3>& bbox, O out) const
+  {
+    visit_intersectors(bbox, [&](const U& data) { *out++ = data; });
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box contains the given point and
+   * returns a list of those items.
+   *
+   * @param point the point to test
+   * @return a list containing all found data items
+   */
+  std::vector<U> find_containers(const vm::vec<T, 3>& point) const
+  {
+    auto result = std::vector<U>{};
+    find_containers(point, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box contains the given point and
+   * appends it to the given output iterator.
+   *
+   * @tparam O the output iterator type
+   * @param point the point to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_containers(const vm::vec<T, 3>& point, O out) const
+  {
+    visit_containers(point, [&](const U& data) { *out++ = data; });
+  }
+
+private:
+  static detail::node_address get_required_root(const detail::node_address& address)
+  {
+    return is_root(address) ? address : get_root(address);
+  }
+
+  /**
+   * Returns a key that orders node addresses in the order in which a depth first
+   * traversal of the tree with the given root visits them: by the Morton code of their
+   * minimum corners relative to the root, and larger nodes before the nodes they contain.
+   * Data with a root address is stored in the root node and comes first.
+   */
+  static uint64_t get_depth_first_key(
+    const detail::node_address& root_address, const detail::node_address& address)
+  {
+    if (is_root(address))
+    {
+      return 0;
+    }
+
+    // spreads the lower 16 bits of the given value so that there are two zero bits
+    // between every two bits
+    const auto spread_bits = [](uint64_t v) {
+      v &= 0xffff;
+      v = (v | (v << 16)) & 0x0000'0000'ff00'00ff;
+      v = (v | (v << 8)) & 0x0000'00f0'0f00'f00f;
+      v = (v | (v << 4)) & 0x0000'0c30'c30c'30c3;
+      v = (v | (v << 2)) & 0x0000'2492'4924'9249;
+      return v;
+    };
+
+    const auto x = uint64_t(address.x - root_address.x);
+    const auto y = uint64_t(address.y - root_address.y);
+    const auto z = uint64_t(address.z - root_address.z);
+    const auto morton_code =
+      spread_bits(x) | (spread_bits(y) << 1) | (spread_bits(z) << 2);
+
+    // the size is at most 16 and takes 5 bits, the morton code takes 48 bits
+    return 1 + ((morton_code << 5) | uint64_t(31 - address.size));
+  }
+
+  bool is_in_place(const uint32_t node_index, const detail::node_address& address) const
+  {
+    return is_root(address)
+             ? node_index == 0 && m_nodes[node_index].address.contains(address)
+             : m_nodes[node_index].address == address;
+  }
+
+  void build_at(std::vector<std::pair<detail::node_address, U>> items)
+  {
+    clear();
+
+    if (items.empty())
+    {
+      return;
+    }
+
+    auto root_address = get_required_root(items.front().first);
+    for (const auto& [address, data] : items)
+    {
+      const auto required_root_address = get_required_root(address);
+      if (root_address.size < required_root_address.size)
+      {
+        root_address = required_root_address;
+      }
+    }
+
+    auto keys = std::vector<uint64_t>{};
+    keys.reserve(items.size());
+    for (const auto& [address, data] : items)
+    {
+      keys.push_back(get_depth_first_key(root_address, address));
+    }
+
+    auto order = std::vector<uint32_t>(items.size());
+    std::iota(order.begin(), order.end(), uint32_t(0));
+    std::ranges::sort(order, {}, [&](const auto i) { return keys[i]; });
+
+    add_node(root_address, invalid_index);
+
+    // the nodes on the path from the root to the previous item's node
+    auto path = std::vector<uint32_t>{0};
+    auto node_indices = std::vector<uint32_t>(items.size());
+    for (const auto i : order)
+    {
+      const auto& address = items[i].first;
+      if (is_root(address))
+      {
+        node_indices[i] = 0;
+      }
+      else
+      {
+        while (!m_nodes[path.back()].address.contains(address))
+        {
+          path.pop_back();
+        }
+        while (m_nodes[path.back()].address != address)
+        {
+          path.push_back(find_or_create_child(path.back(), address));
+        }
+        node_indices[i] = path.back();
+      }
+      ++m_nodes[node_indices[i]].data_capacity;
+    }
+
+    auto data_offset = uint32_t(0);
+    for (auto& node : m_nodes)
+    {
+      node.data_offset = data_offset;
+      data_offset += node.data_capacity;
+    }
+
+    m_data.resize(items.size());
+    m_location_for_data.reserve(items.size());
+    for (const auto i : order)
+    {
+      const auto node_index = node_indices[i];
+      auto& node = m_nodes[node_index];
+      const auto slot = node.data_size++;
+
+      if (!m_location_for_data.emplace(items[i].second, data_location{node_index, slot})
+             .second)
+      {
+        clear();
+        throw NodeTreeException("Data already in tree");
+      }
+
+      m_data[node.data_offset + slot] = std::move(items[i].second);
+      node.item_count = node.data_size;
+    }
+
+    // children are always created after their parents
+    for (auto i = m_nodes.size() - 1; i > 0; --i)
+    {
+      m_nodes[m_nodes[i].parent].item_count += m_nodes[i].item_count;
+    }
+  }
+
+  uint32_t add_node(const detail::node_address& address, const uint32_t parent)
+  {
+    const auto node_index = uint32_t(m_nodes.size());
+    m_nodes.push_back(node{address, parent});
+
+    const auto bounds = address.to_bounds(m_min_size);
+    for (size_t i = 0; i < 3; ++i)
+    {
+      m_node_min[i].push_back(bounds.min[i]);
+      m_node_max[i].push_back(bounds.max[i]);
+    }
+
+    return node_index;
+  }
+
+  void set_node(
+    const uint32_t node_index,
+    const detail::node_address& address,
+    const uint32_t parent)
+  {
+    m_nodes[node_index] = node{address, parent};
+
+    const auto bounds = address.to_bounds(m_min_size);
+    for (size_t i = 0; i < 3; ++i)
+    {
+      m_node_min[i][node_index] = bounds.min[i];
+      m_node_max[i][node_index] = bounds.max[i];
+    }
+  }
+
+  void create_children(const uint32_t node_index)
+  {
+    assert(m_nodes[node_index].children == invalid_index);
+
+    const auto address = m_nodes[node_index].address;
+    if (!m_free_children.empty())
+    {
+      const auto first_child = m_free_children.back();
+      m_free_children.pop_back();
+
+      for (uint32_t i = 0; i < 8; ++i)
+      {
+        set_node(first_child + i, get_child(address, i), node_index);
+      }
+      m_nodes[node_index].children = first_child;
+    }
+    else
+    {
+      const auto first_child = add_node(get_child(address, 0), node_index);
+      for (uint32_t i = 1; i < 8; ++i)
+      {
+        add_node(get_child(address, i), node_index);
+      }
+      m_nodes[node_index].children = first_child;
+    }
+  }
+
+  void release_children(const uint32_t node_index)
+  {
+    auto& node = m_nodes[node_index];
+    for (auto child_index = node.children; child_index < node.children + 8; ++child_index)
+    {
+      m_unused_data += m_nodes[child_index].data_capacity;
+    }
+
+    m_free_children.push_back(node.children);
+    node.children = invalid_index;
+  }
+
+  /**
+   * Returns the index of the node with the given address, creating it and its ancestors
+   * if necessary. Data with a root address is stored in the root node.
+   */
+  uint32_t find_or_create_node(const detail::node_address& address)
+  {
+    assert(!m_nodes.empty());
+    assert(m_nodes.front().address.contains(address));
+
+    auto node_index = uint32_t(0);
+    if (!is_root(address))
+    {
+      while (m_nodes[node_index].address != address)
+      {
+        node_index = find_or_create_child(node_index, address);
+      }
+    }
+    return node_index;
+  }
+
+  /**
+   * Returns the index of the child of the given node that contains the given address,
+   * creating the children of the given node if necessary.
+   */
+  uint32_t find_or_create_child(
+    const uint32_t node_index, const detail::node_address& address)
+  {
+    const auto quadrant = get_quadrant(m_nodes[node_index].address, address);
+    assert(quadrant.has_value());
+
+    if (m_nodes[node_index].children == invalid_index)
+    {
+      create_children(node_index);
+    }
+    return m_nodes[node_index].children + uint32_t(*quadrant);
+  }
+
+  void insert_at(const detail::node_address& address, U data)
+  {
+    if (m_nodes.empty())
+    {
+      add_node(get_required_root(address), invalid_index);
+    }
+    else if (!m_nodes.front().address.contains(address))
+    {
+      grow_root(get_required_root(address));
+    }
+
+    const auto node_index = find_or_create_node(address);
+    if (m_nodes[node_index].data_size == m_nodes[node_index].data_capacity)
+    {
+      grow_data(node_index);
+    }
+
+    auto& node = m_nodes[node_index];
+    const auto slot = node.data_size++;
+    m_data[node.data_offset + slot] = data;
+    m_location_for_data.emplace(std::move(data), data_location{node_index, slot});
+
+    for (auto i = node_index; i != invalid_index; i = m_nodes[i].parent)
+    {
+      ++m_nodes[i].item_count;
+    }
+  }
+
+  /**
+   * Moves the data of the given node to a larger slice at the end of m_data.
+   */
+  void grow_data(const uint32_t node_index)
+  {
+    if (m_unused_data > m_data.size() / 2)
+    {
+      compact_data();
+    }
+
+    auto& node = m_nodes[node_index];
+    const auto data_offset = uint32_t(m_data.size());
+    const auto data_capacity = std::max(min_data_capacity, 2 * node.data_capacity);
+
+    m_data.resize(m_data.size() + data_capacity);
+    std::move(
+      std::next(m_data.begin(), node.data_offset),
+      std::next(m_data.begin(), node.data_offset + node.data_size),
+      std::next(m_data.begin(), data_offset));
+
+    m_unused_data += node.data_capacity;
+    node.data_offset = data_offset;
+    node.data_capacity = data_capacity;
+  }
+
+  /**
+   * Copies the data slices of all nodes into a new array in depth first order, dropping
+   * the slices that are no longer used.
+   */
+  void compact_data()
+  {
+    auto data = std::vector<U>{};
+    data.reserve(m_data.size() - m_unused_data);
+
+    visit_nodes(0, [&](node& current) {
+      const auto data_offset = uint32_t(data.size());
+      data.insert(
+        data.end(),
+        std::make_move_iterator(std::next(m_data.begin(), current.data_offset)),
+        std::make_move_iterator(
+          std::next(m_data.begin(), current.data_offset + current.data_capacity)));
+      current.data_offset = data_offset;
+    });
+
+    m_data = std::move(data);
+    m_unused_data = 0;
+  }
+
+  /**
+   * Rebuilds this tree with a larger root node. This happens rarely because the root
+   * only grows when data is inserted outside of the bounds of every previous item.
+   */
+  void grow_root(const detail::node_address& root_address)
+  {
+    assert(root_address.contains(m_nodes.front().address));
+
+    // the data in the root node is moved to the new root node
+    auto items = std::vector<std::pair<detail::node_address, U>>{};
+    items.reserve(m_location_for_data.size());
+    visit_nodes(0, [&](const node& current) {
+      const auto& address = is_root(current.address) ? root_address : current.address;
+      for (auto i = current.data_offset; i < current.data_offset + current.data_size; ++i)
+      {
+        items.emplace_back(address, std::move(m_data[i]));
+      }
+    });
+
+    clear();
+    add_node(root_address, invalid_index);
+
+    for (auto& [address, data] : items)
+    {
+      insert_at(address, std::move(data));
+    }
+  }
+
+  template <typename F>
+  void visit_nodes(const uint32_t node_index, const F& f)
+  {
+    f(m_nodes[node_index]);
+
+    const auto children = m_nodes[node_index].children;
+    if (children != invalid_index)
+    {
+      for (auto child_index = children; child_index < children + 8; ++child_index)
+      {
+        visit_nodes(child_index, f);
+      }
+    }
+  }
+
+  /**
+   * Tests the given ray against the bounds of N consecutive nodes. The loops are free of
+   * branches that depend on the nodes so that the compiler can vectorize them.
+   */
+  template <size_t N>
+  void intersect_ray(
+    const vm::ray<T, 3>& ray,
+    const vm::vec<T, 3>& inverse_direction,
+    const uint32_t first_node_index,
+    std::array<bool, N>& hits) const
+  {
+    auto t_min = std::array<T, N>{};
+    auto t_max = std::array<T, N>{};
+    t_max.fill(std::numeric_limits<T>::max());
+    hits.fill(true);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+      const auto* min = m_node_min[i].data() + first_node_index;
+      const auto* max = m_node_max[i].data() + first_node_index;
+      const auto origin = ray.origin[i];
+
+      if (ray.direction[i] == T(0))
+      {
+        for (size_t j = 0; j < N; ++j)
+        {
+          hits[j] = hits[j] && origin >= min[j] && origin <= max[j];
+        }
+      }
+      else
+      {
+        for (size_t j = 0; j < N; ++j)
+        {
+          const auto t1 = (min[j] - origin) * inverse_direction[i];
+          const auto t2 = (max[j] - origin) * inverse_direction[i];
+          t_min[j] = std::max(t_min[j], std::min(t1, t2));
+          t_max[j] = std::min(t_max[j], std::max(t1, t2));
+        }
+      }
+    }
+
+    for (size_t j = 0; j < N; ++j)
+    {
+      hits[j] = hits[j] && t_min[j] <= t_max[j];
+    }
+  }
+
+  template <size_t N>
+  void intersect_bbox(
+    const vm::bbox<T, 3>& bbox,
+    const uint32_t first_node_index,
+    std::array<bool, N>& hits) const
+  {
+    hits.fill(true);
+    for (size_t i = 0; i < 3; ++i)
+    {
+      const auto* min = m_node_min[i].data() + first_node_index;
+      const auto* max = m_node_max[i].data() + first_node_index;
+      for (size_t j = 0; j < N; ++j)
+      {
+        hits[j] = hits[j] && bbox.max[i] >= min[j] && bbox.min[i] <= max[j];
+      }
+    }
+  }
+
+  template <size_t N>
+  void not_contained_in_bbox(
+    const vm::bbox<T, 3>& bbox,
+    const uint32_t first_node_index,
+    std::array<bool, N>& hits) const
+  {
+    hits.fill(false);
+    for (size_t i = 0; i < 3; ++i)
+    {
+      const auto* min = m_node_min[i].data() + first_node_index;
+      const auto* max = m_node_max[i].data() + first_node_index;
+      for (size_t j = 0; j < N; ++j)
+      {
+        hits[j] = hits[j] || min[j] < bbox.min[i] || max[j] > bbox.max[i];
+      }
+    }
+  }
+
+  template <size_t N>
+  void contains_point(
+    const vm::vec<T, 3>& point,
+    const uint32_t first_node_index,
+    std::array<bool, N>& hits) const
+  {
+    hits.fill(true);
+    for (size_t i = 0; i < 3; ++i)
+    {
+      const auto* min = m_node_min[i].data() + first_node_index;
+      const auto* max = m_node_max[i].data() + first_node_index;
+      for (size_t j = 0; j < N; ++j)
+      {
+        hits[j] = hits[j] && point[i] >= min[j] && point[i] <= max[j];
+      }
+    }
+  }
+
+  /**
+   * Visits the data of every node for which the given predicate holds, provided that the
+   * predicate holds for all of its ancestors. The predicate tests a batch of consecutive
+   * nodes at once: either the root node or the eight children of a node.
+   */
+  template <typename P, typename F>
+  void visit_if(const P& predicate, const F& visitor) const
+  {
+    if (!m_nodes.empty())
+    {
+      auto hits = std::array<bool, 1>{};
+      predicate(uint32_t(0), hits);
+      if (hits[0])
+      {
+        visit_node_if(0, predicate, visitor);
+      }
+    }
+  }
+
+  template <typename P, typename F>
+  void visit_node_if(
+    const uint32_t node_index, const P& predicate, const F& visitor) const
+  {
+    const auto& node = m_nodes[node_index];
+    for (auto i = node.data_offset; i < node.data_offset + node.data_size; ++i)
+    {
+      visitor(m_data[i]);
+    }
+
+    if (node.children != invalid_index)
+    {
+      auto hits = std::array<bool, 8>{};
+      predicate(node.children, hits);
+
+      for (uint32_t i = 0; i < 8; ++i)
+      {
+        const auto child_index = node.children + i;
+        if (hits[i] && m_nodes[child_index].item_count > 0)
+        {
+          visit_node_if(child_index, predicate, visitor);
+        }
+      }
+    }
+  }
+
+  void check(const vm::bbox<T, 3>& bounds) const
+  {
+    if (vm::is_nan(bounds.min) || vm::is_nan(bounds.max))
+    {
+      throw NodeTreeException("Cannot add node to octree with invalid bounds");
+    }
+  }
+};
+
+} // namespace tb
@@ -80,7 +80,7 @@ Result<std::shared_ptr<File>> DiskFileSystem::doOpenFile(
 {
   return makeAbsolute(path) | kdl::and_then(Disk::openFile)
          | kdl::transform(
-           [](auto cFile) { return std::static_pointer_cast<File>(cFile); });
+           [](auto file) { return std::static_pointer_cast<File>(file); });
 }
 
 WritableDiskFileSystem::WritableDiskFileSystem(const std::filesystem::path& root)
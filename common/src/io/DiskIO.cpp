@@ -143,7 +143,7 @@ Result<std::vector<std::filesystem::path>> find(
   return result;
 }
 
-Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path)
+Result<std::shared_ptr<MappedFile>> openFile(const std::filesystem::path& path)
 {
   const auto fixedPath = fixPath(path);
   if (pathInfo(fixedPath) != PathInfo::File)
@@ -152,7 +152,7 @@ Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path)
       "Failed to open '" + fixedPath.string() + "': path does not denote a file"};
   }
 
-  return createCFile(fixedPath);
+  return createMappedFile(fixedPath);
 }
 
 Result<bool> createDirectory(const std::filesystem::path& path)
@@ -48,7 +48,7 @@ Result<std::vector<std::filesystem::path>> find(
   const TraversalMode& traversalMode,
   const PathMatcher& pathMatcher = matchAnyPath);
 
-Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path);
+Result<std::shared_ptr<MappedFile>> openFile(const std::filesystem::path& path);
 
 template <typename Stream, typename F>
 auto withStream(
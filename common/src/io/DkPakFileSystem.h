@@ -24,9 +24,9 @@
 
 namespace tb::io
 {
-class CFile;
+class MappedFile;
 
-class DkPakFileSystem : public ImageFileSystem<CFile>
+class DkPakFileSystem : public ImageFileSystem<MappedFile>
 {
 public:
   using ImageFileSystem::ImageFileSystem;
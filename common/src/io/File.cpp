@@ -23,9 +23,23 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+#include <io.h>
+#include <system_error>
+#else
+#include <sys/mman.h>
+#endif
+
 namespace tb::io
 {
 
@@ -76,6 +90,113 @@ Result<kdl::resource<std::FILE*>> openPathAsFILE(
   return kdl::resource{file, std::fclose};
 }
 
+struct MappedRegion
+{
+  std::shared_ptr<const char> data;
+  size_t size;
+};
+
+#ifdef _WIN32
+Error makeMappingError(const std::filesystem::path& path)
+{
+  return Error{fmt::format(
+    "Failed to map '{}': {}",
+    path.string(),
+    std::system_category().message(int(GetLastError())))};
+}
+
+Result<MappedRegion> mapFile(const CFile& file, const std::filesystem::path& path)
+{
+  if (file.size() == 0)
+  {
+    // empty files cannot be mapped
+    return MappedRegion{nullptr, 0};
+  }
+
+  // the handle is owned by the file and must not be closed here
+  auto* handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file.file())));
+  if (handle == INVALID_HANDLE_VALUE)
+  {
+    return makeMappingError(path);
+  }
+
+  // the view keeps the mapping object alive, so its handle can be closed after mapping
+  auto mapping = kdl::resource{
+    CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr),
+    [](HANDLE mappingHandle) {
+      if (mappingHandle)
+      {
+        CloseHandle(mappingHandle);
+      }
+    }};
+  if (!*mapping)
+  {
+    return makeMappingError(path);
+  }
+
+  const auto* data =
+    static_cast<const char*>(MapViewOfFile(*mapping, FILE_MAP_READ, 0, 0, 0));
+  if (!data)
+  {
+    return makeMappingError(path);
+  }
+
+  return MappedRegion{
+    std::shared_ptr<const char>{data, [](const char* p) { UnmapViewOfFile(p); }},
+    file.size()};
+}
+#else
+Error makeMappingError(const std::filesystem::path& path)
+{
+  return Error{
+    fmt::format("Failed to map '{}': {}", path.string(), std::strerror(errno))};
+}
+
+Result<MappedRegion> mapFile(const CFile& file, const std::filesystem::path& path)
+{
+  const auto size = file.size();
+  if (size == 0)
+  {
+    // empty files cannot be mapped
+    return MappedRegion{nullptr, 0};
+  }
+
+  auto* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileno(file.file()), 0);
+  if (data == MAP_FAILED)
+  {
+    return makeMappingError(path);
+  }
+
+  return MappedRegion{
+    std::shared_ptr<const char>{
+      static_cast<const char*>(data),
+      [size](const char* p) { ::munmap(const_cast<char*>(p), size); }},
+    size};
+}
+#endif
+
+struct FileStatus
+{
+  size_t size;
+  std::time_t modificationTime;
+};
+
+Result<FileStatus> fileStatus(std::FILE* file)
+{
+#ifdef _WIN32
+  struct _stat64 info;
+  if (_fstat64(_fileno(file), &info) != 0)
+#else
+  struct stat info;
+  if (::fstat(fileno(file), &info) != 0)
+#endif
+  {
+    return Error{fmt::format("fstat failed: {}", std::strerror(errno))};
+  }
+
+  return FileStatus{static_cast<size_t>(info.st_size), info.st_mtime};
+}
+
 Result<size_t> fileSize(std::FILE* file)
 {
   const auto pos = std::ftell(file);
@@ -195,6 +316,81 @@ Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path)
          });
 }
 
+MappedFile::MappedFile(
+  std::shared_ptr<CFile> file,
+  std::shared_ptr<const char> data,
+  const size_t size,
+  const std::time_t modificationTime)
+  : m_file{std::move(file)}
+  , m_data{std::move(data)}
+  , m_size{size}
+  , m_modificationTime{modificationTime}
+{
+}
+
+Reader MappedFile::reader() const
+{
+  return Reader::from(*this);
+}
+
+size_t MappedFile::size() const
+{
+  return m_size;
+}
+
+bool MappedFile::isModified() const
+{
+  if (!m_modified)
+  {
+    // once the file has been modified, it remains modified even if it's restored
+    m_modified = fileStatus(m_file->file()) | kdl::transform([&](const auto& status) {
+                   return status.size != m_size
+                          || status.modificationTime != m_modificationTime;
+                 })
+                 | kdl::value_or(true);
+  }
+  return m_modified;
+}
+
+const char* MappedFile::begin() const
+{
+  return m_data.get();
+}
+
+const char* MappedFile::end() const
+{
+  return m_data.get() + m_size;
+}
+
+std::unique_ptr<OwningBufferFile> MappedFile::buffer() const
+{
+  if (isModified())
+  {
+    return m_file->buffer();
+  }
+
+  auto buffer = std::make_unique<char[]>(m_size);
+  std::copy(begin(), end(), buffer.get());
+  return std::make_unique<OwningBufferFile>(std::move(buffer), m_size);
+}
+
+Result<std::shared_ptr<MappedFile>> createMappedFile(const std::filesystem::path& path)
+{
+  // the file is kept open so that it can be read if it is modified while it is mapped
+  return createCFile(path) | kdl::and_then([&](auto file) {
+           return fileStatus(file->file()) | kdl::and_then([&](const auto& status) {
+                    return mapFile(*file, path) | kdl::transform([&](auto region) {
+                             // NOLINTNEXTLINE
+                             return std::shared_ptr<MappedFile>{new MappedFile{
+                               std::move(file),
+                               std::move(region.data),
+                               region.size,
+                               status.modificationTime}};
+                           });
+                  });
+         });
+}
+
 FileView::FileView(std::shared_ptr<File> file, const size_t offset, const size_t length)
   : m_file{std::move(file)}
   , m_offset{offset}
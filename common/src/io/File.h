@@ -24,7 +24,9 @@
 
 #include "kdl/resource.h"
 
+#include <atomic>
 #include <cstdio>
+#include <ctime>
 #include <filesystem>
 #include <memory>
 #include <mutex>
@@ -126,6 +128,74 @@ private:
 
 Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path);
 
+/**
+ * A file that is backed by a physical file on the disk which is mapped into memory. The
+ * file is mapped in its entirety when it is created and unmapped when the file and all
+ * readers that were created for it have been destroyed.
+ *
+ * Readers access the mapped memory directly, so reading from a mapped file does not copy
+ * its contents into a buffer and does not require any synchronization. Use buffer() to
+ * obtain a copy of the contents that does not depend on the file.
+ *
+ * The file on the disk must not be modified while it is mapped. On POSIX systems,
+ * accessing the mapped memory of a file that was truncated raises SIGBUS. To guard
+ * against this, the file remains open and reader() checks the file's size and
+ * modification time. Once the file has been modified, it is read through a CFile instead
+ * of the mapping. Readers that were created earlier still access the mapped memory. On
+ * Windows, the mapping prevents the file from being truncated or overwritten for as long
+ * as it exists.
+ */
+class MappedFile : public File
+{
+private:
+  std::shared_ptr<CFile> m_file;
+  std::shared_ptr<const char> m_data;
+  size_t m_size;
+  std::time_t m_modificationTime;
+  mutable std::atomic<bool> m_modified = false;
+
+  /**
+   * Creates a new file with the given mapped memory region and size in bytes. The given
+   * file must be the file that was mapped, and the given modification time must be the
+   * time at which it was mapped.
+   */
+  MappedFile(
+    std::shared_ptr<CFile> file,
+    std::shared_ptr<const char> data,
+    size_t size,
+    std::time_t modificationTime);
+
+public:
+  friend Result<std::shared_ptr<MappedFile>> createMappedFile(
+    const std::filesystem::path& path);
+
+  Reader reader() const override;
+  size_t size() const override;
+
+  /**
+   * Indicates whether the file on the disk has been modified since it was mapped.
+   */
+  bool isModified() const;
+
+  /**
+   * Returns the beginning of the mapped memory region. Must not be accessed if the file
+   * has been modified.
+   */
+  const char* begin() const;
+
+  /**
+   * Returns the end of the mapped memory region.
+   */
+  const char* end() const;
+
+  std::unique_ptr<OwningBufferFile> buffer() const;
+
+private:
+  friend class Reader;
+};
+
+Result<std::shared_ptr<MappedFile>> createMappedFile(const std::filesystem::path& path);
+
 /**
  * A file that is backed by a portion of a physical file.
  */
@@ -24,9 +24,9 @@
 
 namespace tb::io
 {
-class CFile;
+class MappedFile;
 
-class IdPakFileSystem : public ImageFileSystem<CFile>
+class IdPakFileSystem : public ImageFileSystem<MappedFile>
 {
 public:
   using ImageFileSystem::ImageFileSystem;
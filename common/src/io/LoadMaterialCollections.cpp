@@ -48,11 +48,16 @@
 #include "kdl/result_fold.h"
 #include "kdl/string_compare.h"
 #include "kdl/string_format.h"
+#include "kdl/task_manager.h"
 #include "kdl/vector_utils.h"
 
 #include <fmt/format.h>
 
+#include <functional>
+#include <mutex>
+#include <ranges>
 #include <string>
+#include <unordered_map>
 
 namespace tb::io
 {
@@ -393,6 +398,41 @@ std::vector<mdl::MaterialCollection> groupMaterialsIntoCollections(
   });
 }
 
+using ShaderIndex = std::
+  unordered_map<std::filesystem::path, const mdl::Quake3Shader*, kdl::path_hash>;
+
+ShaderIndex makeShaderIndex(const std::vector<mdl::Quake3Shader>& shaders)
+{
+  auto result = ShaderIndex{};
+  result.reserve(shaders.size());
+  for (const auto& shader : shaders)
+  {
+    // the first shader with a given path wins
+    result.try_emplace(shader.shaderPath, &shader);
+  }
+  return result;
+}
+
+Result<mdl::Material> loadMaterial(
+  const FileSystem& fs,
+  const mdl::MaterialConfig& materialConfig,
+  const std::filesystem::path& materialPath,
+  const mdl::CreateTextureResource& createResource,
+  const mdl::Quake3Shader* shader,
+  const std::optional<Result<mdl::Palette>>& paletteResult)
+{
+  return (shader ? loadShaderMaterial(*shader, fs, materialConfig, createResource)
+                 : loadTextureMaterial(
+                   materialPath, fs, materialConfig, createResource, paletteResult))
+         | kdl::transform([&](auto material) {
+             fs.makeAbsolute(materialPath)
+               | kdl::transform([&](auto absPath) { material.setAbsolutePath(absPath); })
+               | kdl::or_else([](auto) { return kdl::void_success; });
+             material.setRelativePath(materialPath);
+             return material;
+           });
+}
+
 } // namespace
 
 
@@ -410,17 +450,13 @@ Result<mdl::Material> loadMaterial(
       return shader.shaderPath == materialPathStem;
     });
 
-  return (iShader != shaders.end()
-            ? loadShaderMaterial(*iShader, fs, materialConfig, createResource)
-            : loadTextureMaterial(
-                materialPath, fs, materialConfig, createResource, paletteResult))
-         | kdl::transform([&](auto material) {
-             fs.makeAbsolute(materialPath)
-               | kdl::transform([&](auto absPath) { material.setAbsolutePath(absPath); })
-               | kdl::or_else([](auto) { return kdl::void_success; });
-             material.setRelativePath(materialPath);
-             return material;
-           });
+  return loadMaterial(
+    fs,
+    materialConfig,
+    materialPath,
+    createResource,
+    iShader != shaders.end() ? &*iShader : nullptr,
+    paletteResult);
 }
 
 Result<std::vector<mdl::MaterialCollection>> loadMaterialCollections(
@@ -441,18 +477,33 @@ Result<std::vector<mdl::MaterialCollection>> loadMaterialCollections(
          | kdl::and_then([&](auto shaders) {
              return findAllMaterialPaths(fs, materialConfig, shaders)
                     | kdl::and_then([&](const auto& materialPaths) {
-                        return kdl::vec_transform(
-                                 materialPaths,
-                                 [&](const auto& materialPath) {
-                                   return loadMaterial(
-                                     fs,
-                                     materialConfig,
-                                     materialPath,
-                                     createResource,
-                                     shaders,
-                                     paletteResult);
-                                 })
-                               | kdl::fold;
+                        const auto shaderIndex = makeShaderIndex(shaders);
+
+                        // the materials are loaded in parallel, but the resources must be
+                        // created one at a time
+                        auto createResourceMutex = std::mutex{};
+                        const auto createResourceSerially =
+                          mdl::CreateTextureResource{[&](auto resourceLoader) {
+                            const auto lock = std::lock_guard{createResourceMutex};
+                            return createResource(std::move(resourceLoader));
+                          }};
+
+                        auto tasks =
+                          materialPaths | std::views::transform([&](const auto& path) {
+                            return std::function{[&]() {
+                              const auto shaderIt =
+                                shaderIndex.find(kdl::path_remove_extension(path));
+                              return loadMaterial(
+                                fs,
+                                materialConfig,
+                                path,
+                                createResourceSerially,
+                                shaderIt != shaderIndex.end() ? shaderIt->second
+                                                              : nullptr,
+                                paletteResult);
+                            }};
+                          });
+                        return taskManager.run_tasks_and_wait(tasks) | kdl::fold;
                       });
            })
          | kdl::transform([&](auto materials) {
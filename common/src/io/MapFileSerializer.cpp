@@ -28,6 +28,7 @@
 #include "mdl/EntityNode.h"
 #include "mdl/EntityProperties.h"
 #include "mdl/GroupNode.h"
+#include "mdl/Layer.h"
 #include "mdl/LayerNode.h"
 #include "mdl/PatchNode.h"
 #include "mdl/WorldNode.h"
@@ -38,6 +39,8 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <cassert>
 #include <iterator>
 #include <memory>
 #include <sstream>
@@ -309,60 +312,33 @@ MapFileSerializer::MapFileSerializer(std::ostream& stream)
 {
 }
 
+MapFileSerializer::~MapFileSerializer()
+{
+  // the pending tasks refer to this serializer
+  waitForPendingChunks();
+}
+
 void MapFileSerializer::doBeginFile(
   const std::vector<const mdl::Node*>& rootNodes, kdl::task_manager& taskManager)
 {
-  ensure(m_nodeToPrecomputedString.empty(), "MapFileSerializer may not be reused");
-
-  // collect nodes
-  std::vector<std::variant<const mdl::BrushNode*, const mdl::PatchNode*>>
-    nodesToSerialize;
-  nodesToSerialize.reserve(rootNodes.size());
-
-  mdl::Node::visitAll(
-    rootNodes,
-    kdl::overload(
-      [](auto&& thisLambda, const mdl::WorldNode* world) {
-        world->visitChildren(thisLambda);
-      },
-      [](auto&& thisLambda, const mdl::LayerNode* layer) {
-        layer->visitChildren(thisLambda);
-      },
-      [](auto&& thisLambda, const mdl::GroupNode* group) {
-        group->visitChildren(thisLambda);
-      },
-      [](auto&& thisLambda, const mdl::EntityNode* entity) {
-        entity->visitChildren(thisLambda);
-      },
-      [&](const mdl::BrushNode* brush) { nodesToSerialize.emplace_back(brush); },
-      [&](const mdl::PatchNode* patchNode) {
-        nodesToSerialize.emplace_back(patchNode);
-      }));
-
-  // serialize brushes to strings in parallel
-  using Entry = std::pair<const mdl::Node*, PrecomputedString>;
-  auto tasks = nodesToSerialize | std::views::transform([&](const auto& node) {
-                 return std::function{[&]() {
-                   return std::visit(
-                     kdl::overload(
-                       [&](const mdl::BrushNode* brushNode) {
-                         return Entry{brushNode, writeBrushFaces(brushNode->brush())};
-                       },
-                       [&](const mdl::PatchNode* patchNode) {
-                         return Entry{patchNode, writePatch(patchNode->patch())};
-                       }),
-                     node);
-                 }};
-               });
-
-  // render strings and move them into a map
-  for (auto& entry : taskManager.run_tasks_and_wait(std::move(tasks)))
+  ensure(m_taskManager == nullptr, "MapFileSerializer may not be reused");
+  m_taskManager = &taskManager;
+
+  for (const auto* node : rootNodes)
+  {
+    collectNodesToSerialize(node);
+  }
+
+  // start formatting brushes in parallel; the window is refilled as chunks are written
+  while (m_pendingChunks.size() < WindowSize && scheduleNextChunk())
   {
-    m_nodeToPrecomputedString.insert(std::move(entry));
   }
 }
 
-void MapFileSerializer::doEndFile() {}
+void MapFileSerializer::doEndFile()
+{
+  waitForPendingChunks();
+}
 
 void MapFileSerializer::doBeginEntity(const mdl::Node* /* node */)
 {
@@ -399,13 +375,13 @@ void MapFileSerializer::doBrush(const mdl::BrushNode* brush)
   ++m_line;
 
   // write pre-serialized brush faces
-  auto it = m_nodeToPrecomputedString.find(brush);
-  ensure(
-    it != std::end(m_nodeToPrecomputedString),
-    "attempted to serialize a brush which was not passed to doBeginFile");
-  const PrecomputedString& precomputedString = it->second;
-  m_stream << precomputedString.string;
-  m_line += precomputedString.lineCount;
+  auto precomputedString = takePrecomputedString(brush);
+  if (!precomputedString)
+  {
+    precomputedString = writeBrushFaces(brush->brush());
+  }
+  m_stream << precomputedString->string;
+  m_line += precomputedString->lineCount;
 
   fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "}}\n");
   ++m_line;
@@ -427,17 +403,142 @@ void MapFileSerializer::doPatch(const mdl::PatchNode* patchNode)
   m_startLineStack.push_back(m_line);
 
   // write pre-serialized patch
-  auto it = m_nodeToPrecomputedString.find(patchNode);
-  ensure(
-    it != std::end(m_nodeToPrecomputedString),
-    "attempted to serialize a patch which was not passed to doBeginFile");
-  const PrecomputedString& precomputedString = it->second;
-  m_stream << precomputedString.string;
-  m_line += precomputedString.lineCount;
+  auto precomputedString = takePrecomputedString(patchNode);
+  if (!precomputedString)
+  {
+    precomputedString = writePatch(patchNode->patch());
+  }
+  m_stream << precomputedString->string;
+  m_line += precomputedString->lineCount;
 
   setFilePosition(patchNode);
 }
 
+void MapFileSerializer::collectNodesToSerialize(const mdl::Node* node)
+{
+  node->accept(kdl::overload(
+    [&](const mdl::WorldNode* world) { collectChildrenToSerialize(world); },
+    [&](const mdl::LayerNode* layer) {
+      if (!(exporting() && layer->layer().omitFromExport()))
+      {
+        collectChildrenToSerialize(layer);
+      }
+    },
+    [&](const mdl::GroupNode* group) { collectChildrenToSerialize(group); },
+    [&](const mdl::EntityNode* entity) { collectChildrenToSerialize(entity); },
+    [&](const mdl::BrushNode* brush) { m_nodesToSerialize.emplace_back(brush); },
+    [&](const mdl::PatchNode* patchNode) { m_nodesToSerialize.emplace_back(patchNode); }));
+}
+
+/**
+ * Collects the children of the given node in the order in which NodeSerializer writes
+ * them: the brushes and patches of an entity, group or layer come before its nested
+ * groups and entities.
+ */
+void MapFileSerializer::collectChildrenToSerialize(const mdl::Node* parent)
+{
+  parent->visitChildren(kdl::overload(
+    [](const mdl::WorldNode*) {},
+    [](const mdl::LayerNode*) {},
+    [](const mdl::GroupNode*) {},
+    [](const mdl::EntityNode*) {},
+    [&](const mdl::BrushNode* brush) { m_nodesToSerialize.emplace_back(brush); },
+    [&](const mdl::PatchNode* patchNode) { m_nodesToSerialize.emplace_back(patchNode); }));
+
+  parent->visitChildren(kdl::overload(
+    [&](const mdl::WorldNode* world) { collectNodesToSerialize(world); },
+    [&](const mdl::LayerNode* layer) { collectNodesToSerialize(layer); },
+    [&](const mdl::GroupNode* group) { collectNodesToSerialize(group); },
+    [&](const mdl::EntityNode* entity) { collectNodesToSerialize(entity); },
+    [](const mdl::BrushNode*) {},
+    [](const mdl::PatchNode*) {}));
+}
+
+bool MapFileSerializer::scheduleNextChunk()
+{
+  const auto first = m_nextNodeToSchedule;
+  if (first >= m_nodesToSerialize.size())
+  {
+    return false;
+  }
+
+  const auto last = std::min(first + ChunkSize, m_nodesToSerialize.size());
+  m_nextNodeToSchedule = last;
+
+  m_pendingChunks.push_back(m_taskManager->run_task([&, first, last]() {
+    auto strings = std::vector<PrecomputedString>{};
+    strings.reserve(last - first);
+
+    for (auto i = first; i < last; ++i)
+    {
+      strings.push_back(std::visit(
+        kdl::overload(
+          [&](const mdl::BrushNode* brushNode) {
+            return writeBrushFaces(brushNode->brush());
+          },
+          [&](const mdl::PatchNode* patchNode) {
+            return writePatch(patchNode->patch());
+          }),
+        m_nodesToSerialize[i]));
+    }
+
+    return strings;
+  }));
+
+  return true;
+}
+
+/**
+ * Returns the precomputed string for the given node if it is the next node in the order
+ * in which the nodes were collected. Otherwise, returns an empty optional and the caller
+ * must format the node itself.
+ */
+std::optional<MapFileSerializer::PrecomputedString> MapFileSerializer::
+  takePrecomputedString(const mdl::Node* node)
+{
+  if (m_nextNodeToWrite >= m_nodesToSerialize.size())
+  {
+    return std::nullopt;
+  }
+
+  const auto* nextNode = std::visit(
+    [](const auto* n) -> const mdl::Node* { return n; },
+    m_nodesToSerialize[m_nextNodeToWrite]);
+  if (nextNode != node)
+  {
+    return std::nullopt;
+  }
+
+  const auto indexInChunk = m_nextNodeToWrite % ChunkSize;
+  if (indexInChunk == 0)
+  {
+    assert(!m_pendingChunks.empty());
+    m_currentChunk = m_taskManager->wait_for(m_pendingChunks.front());
+    m_pendingChunks.pop_front();
+    scheduleNextChunk();
+  }
+
+  ++m_nextNodeToWrite;
+  return std::move(m_currentChunk[indexInChunk]);
+}
+
+void MapFileSerializer::waitForPendingChunks()
+{
+  for (auto& chunk : m_pendingChunks)
+  {
+    try
+    {
+      // use the task manager to wait so that this cannot deadlock on a worker thread
+      m_taskManager->wait_for(chunk);
+    }
+    catch (...)
+    {
+      // the chunk is discarded, so any error it produced is irrelevant
+    }
+  }
+  m_pendingChunks.clear();
+}
+
 void MapFileSerializer::setFilePosition(const mdl::Node* node)
 {
   const size_t start = startLine();
@@ -22,9 +22,14 @@
 #include "io/NodeSerializer.h"
 #include "mdl/MapFormat.h"
 
+#include <cstddef>
+#include <deque>
+#include <future>
 #include <iosfwd>
 #include <memory>
-#include <unordered_map>
+#include <optional>
+#include <string>
+#include <variant>
 #include <vector>
 
 
@@ -55,12 +60,40 @@ private:
     std::string string;
     size_t lineCount;
   };
-  std::unordered_map<const mdl::Node*, PrecomputedString> m_nodeToPrecomputedString;
+
+  /**
+   * Brushes and patches are formatted by worker threads in chunks of this many nodes.
+   */
+  static constexpr size_t ChunkSize = 64;
+
+  /**
+   * The maximum number of chunks that are formatted ahead of the writer. This bounds the
+   * memory held by formatted strings that have not been written yet.
+   */
+  static constexpr size_t WindowSize = 32;
+
+  using NodeToSerialize = std::variant<const mdl::BrushNode*, const mdl::PatchNode*>;
+  using PrecomputedChunk = std::future<std::vector<PrecomputedString>>;
+
+  kdl::task_manager* m_taskManager = nullptr;
+
+  /**
+   * The brushes and patches passed to doBeginFile, in the order in which they are
+   * expected to be written.
+   */
+  std::vector<NodeToSerialize> m_nodesToSerialize;
+  size_t m_nextNodeToSchedule = 0;
+  size_t m_nextNodeToWrite = 0;
+
+  std::deque<PrecomputedChunk> m_pendingChunks;
+  std::vector<PrecomputedString> m_currentChunk;
 
 public:
   static std::unique_ptr<NodeSerializer> create(
     mdl::MapFormat format, std::ostream& stream);
 
+  ~MapFileSerializer() override;
+
 protected:
   explicit MapFileSerializer(std::ostream& stream);
 
@@ -79,6 +112,13 @@ private:
   void doPatch(const mdl::PatchNode* patchNode) override;
 
 private:
+  void collectNodesToSerialize(const mdl::Node* node);
+  void collectChildrenToSerialize(const mdl::Node* parent);
+
+  bool scheduleNextChunk();
+  std::optional<PrecomputedString> takePrecomputedString(const mdl::Node* node);
+  void waitForPendingChunks();
+
   void setFilePosition(const mdl::Node* node);
   size_t startLine();
 
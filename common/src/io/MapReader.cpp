@@ -20,8 +20,10 @@
 #include "MapReader.h"
 
 #include "Error.h" // IWYU pragma: keep
+#include "Exceptions.h"
 #include "FileLocation.h"
 #include "Uuid.h"
+#include "io/BufferedParserStatus.h"
 #include "io/ParserStatus.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
@@ -36,17 +38,22 @@
 #include "mdl/VisibilityState.h"
 #include "mdl/WorldNode.h"
 
+#include "kdl/overload.h"
 #include "kdl/result.h"
 #include "kdl/string_format.h"
 #include "kdl/string_utils.h"
 #include "kdl/task_manager.h"
+#include "kdl/vector_utils.h"
 
 #include "vm/mat_io.h"
 
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <ostream>
 #include <string>
@@ -70,21 +77,100 @@ auto getFilePosition(const T& info)
 
 } // namespace
 
+/**
+ * Parses a single chunk of a map file and records the object infos without creating any
+ * nodes.
+ */
+class MapReader::ChunkReader : public MapReader
+{
+public:
+  ChunkReader(
+    const EntityChunk& chunk,
+    const mdl::MapFormat sourceMapFormat,
+    const mdl::MapFormat targetMapFormat)
+    : MapReader{chunk.str, chunk.startLocation, sourceMapFormat, targetMapFormat}
+  {
+  }
+
+  /**
+   * Parses the given chunk. The parent indices of the returned object infos refer to the
+   * returned vector, except for brush chunks, where they are 0 and must be replaced with
+   * the index of the entity info of the corresponding entity start chunk.
+   *
+   * @throws ParserException if parsing fails
+   */
+  std::vector<ObjectInfo> read(const EntityChunk& chunk, ParserStatus& status)
+  {
+    switch (chunk.type)
+    {
+    case EntityChunkType::Entities:
+      parseEntities(status);
+      break;
+    case EntityChunkType::EntityStart:
+      // the chunk ends before the closing brace, so we must end the entity here
+      parseEntities(status);
+      assert(m_currentEntityInfo == 0);
+      std::get<EntityInfo>(m_objectInfos.front()).endLocation = chunk.endLocation;
+      m_currentEntityInfo = std::nullopt;
+      break;
+    case EntityChunkType::EntityBrushes:
+      m_currentEntityInfo = 0;
+      parseBrushesOrPatches(status);
+      m_currentEntityInfo = std::nullopt;
+      break;
+      switchDefault();
+    }
+
+    return std::move(m_objectInfos);
+  }
+
+private:
+  mdl::Node* onWorldNode(std::unique_ptr<mdl::WorldNode>, ParserStatus&) override
+  {
+    return nullptr;
+  }
+  void onLayerNode(std::unique_ptr<mdl::Node>, ParserStatus&) override {}
+  void onNode(mdl::Node*, std::unique_ptr<mdl::Node>, ParserStatus&) override {}
+};
+
+namespace
+{
+/**
+ * The approximate size of the chunks that a map file is split into for parsing. Files
+ * smaller than this are parsed sequentially.
+ */
+constexpr auto EntityChunkSize = size_t(256 * 1024);
+} // namespace
+
 MapReader::MapReader(
   const std::string_view str,
   const mdl::MapFormat sourceMapFormat,
   const mdl::MapFormat targetMapFormat,
   mdl::EntityPropertyConfig entityPropertyConfig)
   : StandardMapParser{str, sourceMapFormat, targetMapFormat}
+  , m_str{str}
   , m_entityPropertyConfig{std::move(entityPropertyConfig)}
 {
 }
 
+MapReader::MapReader(
+  const std::string_view str,
+  const FileLocation& startLocation,
+  const mdl::MapFormat sourceMapFormat,
+  const mdl::MapFormat targetMapFormat)
+  : StandardMapParser{str, startLocation, sourceMapFormat, targetMapFormat}
+  , m_str{str}
+{
+}
+
 void MapReader::readEntities(
   const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager)
 {
   m_worldBounds = worldBounds;
-  parseEntities(status);
+  if (!parseEntityChunks(status, taskManager))
+  {
+    parseEntities(status);
+  }
   createNodes(status, taskManager);
 }
 
@@ -904,6 +990,106 @@ std::unordered_map<mdl::Node*, mdl::Node*> buildNodeToParentMap(
 }
 } // namespace
 
+/**
+ * Splits the file into chunks at entity boundaries and parses the chunks in parallel. The
+ * object infos of the chunks are then merged in file order, and the messages logged while
+ * parsing each chunk are forwarded to the given status in the same order. The progress is
+ * reported to the given status whenever a chunk and all chunks preceding it are parsed.
+ *
+ * Returns false if the file is too small to be split or if any chunk could not be parsed.
+ * In that case, nothing is recorded and the caller must parse the file sequentially,
+ * which reports parse errors exactly as before.
+ */
+bool MapReader::parseEntityChunks(ParserStatus& status, kdl::task_manager& taskManager)
+{
+  const auto chunks = splitIntoEntityChunks(m_str, EntityChunkSize);
+  if (!chunks || chunks->size() < 2)
+  {
+    return false;
+  }
+
+  auto chunkStatuses = kdl::vec_transform(*chunks, [&](const auto&) {
+    return std::make_unique<BufferedParserStatus>(status);
+  });
+
+  using ChunkResult = std::optional<std::vector<ObjectInfo>>;
+
+  auto tasks = std::vector<std::function<ChunkResult()>>{};
+  tasks.reserve(chunks->size());
+  for (size_t i = 0; i < chunks->size(); ++i)
+  {
+    tasks.emplace_back([&, i]() -> ChunkResult {
+      try
+      {
+        const auto& chunk = (*chunks)[i];
+        auto reader = ChunkReader{chunk, m_sourceMapFormat, m_targetMapFormat};
+        return reader.read(chunk, *chunkStatuses[i]);
+      }
+      catch (const ParserException&)
+      {
+        return std::nullopt;
+      }
+    });
+  }
+
+  // wait for the chunks in file order so that the progress can be reported on this
+  // thread as the chunks are done
+  auto futures = taskManager.run_tasks(std::move(tasks));
+  auto results = std::vector<ChunkResult>{};
+  results.reserve(futures.size());
+  for (size_t i = 0; i < futures.size(); ++i)
+  {
+    results.push_back(taskManager.wait_for(futures[i]));
+
+    // everything up to the start of the next chunk has been parsed
+    const auto parsedSize = i + 1 < chunks->size()
+                              ? size_t((*chunks)[i + 1].str.data() - m_str.data())
+                              : m_str.size();
+    status.progress(double(parsedSize) / double(m_str.size()));
+  }
+
+  if (!std::ranges::all_of(
+        results, [](const auto& result) { return result.has_value(); }))
+  {
+    return false;
+  }
+
+  auto entityStartIndex = size_t(0);
+  for (size_t i = 0; i < chunks->size(); ++i)
+  {
+    const auto chunkType = (*chunks)[i].type;
+    const auto offset = m_objectInfos.size();
+    if (chunkType == EntityChunkType::EntityStart)
+    {
+      entityStartIndex = offset;
+    }
+
+    const auto remapParentIndex = [&](auto& info) {
+      if (info.parentIndex)
+      {
+        info.parentIndex = chunkType == EntityChunkType::EntityBrushes
+                             ? entityStartIndex
+                             : *info.parentIndex + offset;
+      }
+    };
+
+    for (auto& objectInfo : *results[i])
+    {
+      std::visit(
+        kdl::overload(
+          [](EntityInfo&) {},
+          [&](BrushInfo& brushInfo) { remapParentIndex(brushInfo); },
+          [&](PatchInfo& patchInfo) { remapParentIndex(patchInfo); }),
+        objectInfo);
+      m_objectInfos.push_back(std::move(objectInfo));
+    }
+
+    chunkStatuses[i]->flush();
+  }
+
+  return true;
+}
+
 /**
  * Creates nodes from the recorded object infos and resolves parent / child relationships.
  *
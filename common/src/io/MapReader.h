@@ -105,6 +105,9 @@ public: // only public so that helper methods can see these declarations
   using ObjectInfo = std::variant<EntityInfo, BrushInfo, PatchInfo>;
 
 private:
+  class ChunkReader;
+
+  std::string_view m_str;
   mdl::EntityPropertyConfig m_entityPropertyConfig;
   vm::bbox3d m_worldBounds;
 
@@ -129,9 +132,24 @@ protected:
     mdl::MapFormat targetMapFormat,
     mdl::EntityPropertyConfig entityPropertyConfig);
 
+private:
+  /**
+   * Creates a reader for a chunk of a map file that starts at the given location.
+   */
+  MapReader(
+    std::string_view str,
+    const FileLocation& startLocation,
+    mdl::MapFormat sourceMapFormat,
+    mdl::MapFormat targetMapFormat);
+
+protected:
+
   /**
    * Attempts to parse as one or more entities.
    *
+   * Large files are split into chunks at entity boundaries, and the chunks are parsed in
+   * parallel using the given task manager.
+   *
    * @throws ParserException if parsing fails
    */
   void readEntities(
@@ -187,6 +205,7 @@ protected: // implement MapParser interface
     ParserStatus& status) override;
 
 private: // helper methods
+  bool parseEntityChunks(ParserStatus& status, kdl::task_manager& taskManager);
   void createNodes(ParserStatus& status, kdl::task_manager& taskManager);
 
 private: // subclassing interface - these will be called in the order that nodes should be
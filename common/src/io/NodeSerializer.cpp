@@ -63,11 +63,31 @@ void NodeSerializer::setExporting(const bool exporting)
   m_exporting = exporting;
 }
 
+void NodeSerializer::setProgressCallback(ProgressCallback progressCallback)
+{
+  m_progressCallback = std::move(progressCallback);
+}
+
+bool NodeSerializer::stopped() const
+{
+  return m_stopped;
+}
+
 void NodeSerializer::beginFile(
   const std::vector<const mdl::Node*>& rootNodes, kdl::task_manager& taskManager)
 {
   m_entityNo = 0;
   m_brushNo = 0;
+
+  // layers are written as entities, so every node is counted once
+  m_nodeCount = 0;
+  m_writtenNodeCount = 0;
+  m_stopped = false;
+  for (const auto* node : rootNodes)
+  {
+    m_nodeCount += node->descendantCount() + 1;
+  }
+
   doBeginFile(rootNodes, taskManager);
 }
 
@@ -159,6 +179,11 @@ void NodeSerializer::entity(
   const std::vector<mdl::EntityProperty>& extraProperties,
   const mdl::Node* brushParent)
 {
+  if (!continueWriting())
+  {
+    return;
+  }
+
   beginEntity(node, properties, extraProperties);
 
   brushParent->visitChildren(kdl::overload(
@@ -178,11 +203,25 @@ void NodeSerializer::entity(
   const std::vector<mdl::EntityProperty>& extraProperties,
   const std::vector<mdl::BrushNode*>& entityBrushes)
 {
+  if (!continueWriting())
+  {
+    return;
+  }
+
   beginEntity(node, properties, extraProperties);
   brushes(entityBrushes);
   endEntity(node);
 }
 
+bool NodeSerializer::continueWriting()
+{
+  if (!m_stopped && m_progressCallback)
+  {
+    m_stopped = !m_progressCallback(m_writtenNodeCount++, m_nodeCount);
+  }
+  return !m_stopped;
+}
+
 void NodeSerializer::beginEntity(
   const mdl::Node* node,
   const std::vector<mdl::EntityProperty>& properties,
@@ -228,12 +267,22 @@ void NodeSerializer::brushes(const std::vector<mdl::BrushNode*>& brushNodes)
 
 void NodeSerializer::brush(const mdl::BrushNode* brushNode)
 {
+  if (!continueWriting())
+  {
+    return;
+  }
+
   doBrush(brushNode);
   ++m_brushNo;
 }
 
 void NodeSerializer::patch(const mdl::PatchNode* patchNode)
 {
+  if (!continueWriting())
+  {
+    return;
+  }
+
   doPatch(patchNode);
   ++m_brushNo;
 }
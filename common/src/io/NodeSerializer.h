@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -51,6 +52,7 @@ namespace io
  *
  * - construct a NodeSerializer
  * - call setExporting() to configure whether to write "omit from export" layers
+ * - optionally call setProgressCallback() to observe and stop the serialization
  * - call beginFile() with all of the nodes that will be later serialized
  *   so subclasses can parallelize precomputing the serialization
  * - call e.g defaultLayer() to write that layer to the output
@@ -60,6 +62,15 @@ namespace io
  */
 class NodeSerializer
 {
+public:
+  /**
+   * Called before an entity, brush or patch is written with the number of entities,
+   * brushes and patches that were written before it and the total number of nodes to
+   * write. If the callback returns false, the serializer skips all remaining nodes, so
+   * the output is incomplete.
+   */
+  using ProgressCallback = std::function<bool(size_t, size_t)>;
+
 protected:
   using ObjectNo = unsigned int;
 
@@ -68,6 +79,11 @@ private:
   ObjectNo m_brushNo = 0;
   bool m_exporting = false;
 
+  ProgressCallback m_progressCallback;
+  size_t m_nodeCount = 0;
+  size_t m_writtenNodeCount = 0;
+  bool m_stopped = false;
+
 public:
   virtual ~NodeSerializer();
 
@@ -79,16 +95,25 @@ public:
   bool exporting() const;
   void setExporting(bool exporting);
 
+  void setProgressCallback(ProgressCallback progressCallback);
+
+  /**
+   * Indicates whether the progress callback has stopped the serialization.
+   */
+  bool stopped() const;
+
 public:
   /**
    * Prepares to serialize the given nodes and all of their children.
-   * The order is ignored.
    *
    * The rootNodes parameter allows subclasses to optionally precompute the
-   * serializations of all nodes in parallel.
+   * serializations of the nodes in parallel. Subclasses may precompute them in the order
+   * in which they are given and in which their children are written, so passing the
+   * nodes in the order in which they are later serialized lets the precomputation keep
+   * ahead of the output.
    *
-   * Any nodes serialized after calling beginFile() must have either been
-   * in the rootNodes vector or be a descendant of one of these nodes.
+   * Any nodes serialized after calling beginFile() should either be in the rootNodes
+   * vector or be a descendant of one of these nodes.
    */
   void beginFile(
     const std::vector<const mdl::Node*>& rootNodes, kdl::task_manager& taskManager);
@@ -113,6 +138,8 @@ public:
     const std::vector<mdl::BrushNode*>& entityBrushes);
 
 private:
+  bool continueWriting();
+
   void beginEntity(
     const mdl::Node* node,
     const std::vector<mdl::EntityProperty>& properties,
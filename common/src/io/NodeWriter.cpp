@@ -106,6 +106,11 @@ void NodeWriter::setExporting(const bool exporting)
   m_serializer->setExporting(exporting);
 }
 
+void NodeWriter::setProgressCallback(NodeSerializer::ProgressCallback progressCallback)
+{
+  m_serializer->setProgressCallback(std::move(progressCallback));
+}
+
 void NodeWriter::writeMap(kdl::task_manager& taskManager)
 {
   m_serializer->beginFile({&m_world}, taskManager);
@@ -145,8 +150,6 @@ void NodeWriter::writeCustomLayer(const mdl::LayerNode* layerNode)
 void NodeWriter::writeNodes(
   const std::vector<mdl::Node*>& nodes, kdl::task_manager& taskManager)
 {
-  m_serializer->beginFile(kdl::vec_static_cast<const mdl::Node*>(nodes), taskManager);
-
   // Assort nodes according to their type and, in case of brushes, whether they are entity
   // or world brushes.
   std::vector<mdl::Node*> groups;
@@ -174,6 +177,20 @@ void NodeWriter::writeNodes(
       [](mdl::PatchNode*) {}));
   }
 
+  // pass the nodes in the order in which they are written so that the serializer can
+  // format them ahead of the writer
+  auto orderedNodes = std::vector<const mdl::Node*>{};
+  orderedNodes.reserve(nodes.size());
+  orderedNodes.insert(orderedNodes.end(), worldBrushes.begin(), worldBrushes.end());
+  for (const auto& [entityNode, brushes] : entityBrushes)
+  {
+    orderedNodes.insert(orderedNodes.end(), brushes.begin(), brushes.end());
+  }
+  orderedNodes.insert(orderedNodes.end(), groups.begin(), groups.end());
+  orderedNodes.insert(orderedNodes.end(), entities.begin(), entities.end());
+
+  m_serializer->beginFile(orderedNodes, taskManager);
+
   writeWorldBrushes(worldBrushes);
   writeEntityBrushes(entityBrushes);
 
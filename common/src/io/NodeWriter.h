@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include "io/NodeSerializer.h"
+
 #include <map>
 #include <memory>
 #include <vector>
@@ -40,7 +42,6 @@ class WorldNode;
 
 namespace tb::io
 {
-class NodeSerializer;
 
 class NodeWriter
 {
@@ -56,6 +57,7 @@ public:
   ~NodeWriter();
 
   void setExporting(bool exporting);
+  void setProgressCallback(NodeSerializer::ProgressCallback progressCallback);
   void writeMap(kdl::task_manager& taskManager);
 
 private:
@@ -36,6 +36,8 @@ private:
   Logger& m_logger;
   std::string m_prefix;
 
+  friend class BufferedParserStatus;
+
 protected:
   ParserStatus(Logger& logger, std::string prefix);
 
@@ -149,18 +149,31 @@ public:
   }
 };
 
+/**
+ * A reader source that reads from a memory region and shares ownership of the memory
+ * region with other reader sources. The memory region is released when the last reader
+ * source that owns it is destroyed.
+ */
 class OwningBufferReaderSource : public BufferReaderSource
 {
 private:
-  CFile::BufferType m_buffer;
+  std::shared_ptr<const void> m_buffer;
 
 public:
-  OwningBufferReaderSource(CFile::BufferType buffer, const char* begin, const char* end)
+  OwningBufferReaderSource(
+    std::shared_ptr<const void> buffer, const char* begin, const char* end)
     : BufferReaderSource{begin, end}
     , m_buffer{std::move(buffer)}
   {
   }
 
+  std::shared_ptr<ReaderSource> subSource(
+    const size_t offset, const size_t length) const override
+  {
+    return std::make_shared<OwningBufferReaderSource>(
+      m_buffer, begin() + offset, begin() + offset + length);
+  }
+
   std::shared_ptr<BufferReaderSource> buffer() const override
   {
     return std::make_shared<OwningBufferReaderSource>(m_buffer, begin(), end());
@@ -176,6 +189,8 @@ class FileReaderSource : public ReaderSource
 {
 private:
   const CFile& m_file;
+  // set if this source shares ownership of the file
+  std::shared_ptr<const CFile> m_owner;
   size_t m_offset;
   size_t m_length;
 
@@ -195,6 +210,18 @@ public:
   {
   }
 
+  /**
+   * Creates a new reader source that shares ownership of the given file.
+   */
+  FileReaderSource(
+    std::shared_ptr<const CFile> file, const size_t offset, const size_t length)
+    : m_file{*file}
+    , m_owner{std::move(file)}
+    , m_offset{offset}
+    , m_length{length}
+  {
+  }
+
 public:
   size_t size() const override { return m_length; }
 
@@ -208,7 +235,9 @@ public:
   std::shared_ptr<ReaderSource> subSource(
     const size_t offset, const size_t length) const override
   {
-    return std::make_shared<FileReaderSource>(m_file, m_offset + offset, length);
+    return m_owner
+             ? std::make_shared<FileReaderSource>(m_owner, m_offset + offset, length)
+             : std::make_shared<FileReaderSource>(m_file, m_offset + offset, length);
   }
 
   std::shared_ptr<BufferReaderSource> buffer() const override
@@ -238,6 +267,18 @@ Reader Reader::from(const CFile& file, const size_t size)
   return Reader{std::make_shared<FileReaderSource>(file, 0, size)};
 }
 
+Reader Reader::from(const MappedFile& file)
+{
+  if (file.isModified())
+  {
+    // accessing the mapping of a truncated file raises SIGBUS
+    return Reader{std::make_shared<FileReaderSource>(file.m_file, 0, file.m_size)};
+  }
+
+  return Reader{
+    std::make_shared<OwningBufferReaderSource>(file.m_data, file.begin(), file.end())};
+}
+
 Reader Reader::from(const char* begin, const char* end)
 {
   return Reader{std::make_shared<BufferReaderSource>(begin, end)};
@@ -31,6 +31,7 @@ namespace tb::io
 class BufferedReader;
 class BufferReaderSource;
 class CFile;
+class MappedFile;
 class ReaderSource;
 
 /**
@@ -64,6 +65,17 @@ public:
    */
   static Reader from(const CFile& file, size_t size);
 
+  /**
+   * Creates a new reader that reads from the given memory mapped file. The reader shares
+   * ownership of the mapped memory region with the file, so it remains valid even if it
+   * outlives the file. If the file has been modified on the disk, the reader reads from
+   * the file instead of the mapped memory region.
+   *
+   * @param file the file to read from
+   * @return the reader
+   */
+  static Reader from(const MappedFile& file);
+
   /**
    * Creates a new reader that reads from the given memory region.
    *
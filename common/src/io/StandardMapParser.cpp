@@ -31,6 +31,424 @@
 
 namespace tb::io
 {
+namespace
+{
+
+/**
+ * Scans a map file for entity boundaries. The scanner recognizes the same tokens as
+ * QuakeMapTokenizer, but it only keeps track of braces and doesn't produce any tokens.
+ */
+class EntityChunkScanner
+{
+private:
+  struct Position
+  {
+    size_t offset;
+    FileLocation location;
+  };
+
+  std::string_view m_str;
+  size_t m_chunkSize;
+
+  size_t m_offset = 0;
+  size_t m_line = 1;
+  size_t m_lineStart = 0;
+
+  std::vector<EntityChunk> m_chunks;
+  std::optional<Position> m_pendingEntitiesStart;
+  size_t m_pendingEntitiesEnd = 0;
+
+public:
+  EntityChunkScanner(const std::string_view str, const size_t chunkSize)
+    : m_str{str}
+    , m_chunkSize{chunkSize}
+  {
+  }
+
+  std::optional<std::vector<EntityChunk>> scan()
+  {
+    skipIgnored();
+    while (!eof())
+    {
+      if (curChar() != '{' || !scanEntity())
+      {
+        return std::nullopt;
+      }
+      skipIgnored();
+    }
+
+    flushPendingEntities();
+    return std::move(m_chunks);
+  }
+
+private:
+  bool scanEntity()
+  {
+    const auto entityStart = position();
+    advance();
+
+    // the positions at which the entity is split
+    auto splitPositions = std::vector<Position>{};
+    auto chunkStart = entityStart.offset;
+    auto hasBrushes = false;
+    auto splittable = true;
+
+    auto depth = size_t(1);
+    while (depth > 0)
+    {
+      skipIgnored();
+      if (eof())
+      {
+        return false;
+      }
+
+      if (depth == 1 && curChar() != '{' && curChar() != '}' && hasBrushes)
+      {
+        // properties or comments after the first brush prevent splitting the entity
+        // because the brush chunks could not be parsed on their own
+        splittable = false;
+      }
+
+      switch (curChar())
+      {
+      case '{':
+        if (!isBrace())
+        {
+          // a material name such as {fence
+          skipWord();
+          break;
+        }
+        if (depth == 1)
+        {
+          if (hasBrushes && m_offset - chunkStart >= m_chunkSize)
+          {
+            splitPositions.push_back(position());
+            chunkStart = m_offset;
+          }
+          hasBrushes = true;
+        }
+        ++depth;
+        advance();
+        break;
+      case '}':
+        --depth;
+        if (depth == 0)
+        {
+          if (splittable && !splitPositions.empty())
+          {
+            addSplitEntity(entityStart, splitPositions, position());
+          }
+          else
+          {
+            addEntity(entityStart, m_offset + 1);
+          }
+        }
+        advance();
+        break;
+      case '"':
+        if (!skipQuotedString())
+        {
+          return false;
+        }
+        break;
+      case '/':
+        // only a comment token remains, all other comments were skipped
+        advance(3);
+        break;
+      case '(':
+      case ')':
+      case '[':
+      case ']':
+        advance();
+        break;
+      default:
+        skipWord();
+        break;
+      }
+    }
+
+    return true;
+  }
+
+  void addEntity(const Position& entityStart, const size_t entityEnd)
+  {
+    if (!m_pendingEntitiesStart)
+    {
+      m_pendingEntitiesStart = entityStart;
+    }
+    m_pendingEntitiesEnd = entityEnd;
+
+    if (m_pendingEntitiesEnd - m_pendingEntitiesStart->offset >= m_chunkSize)
+    {
+      flushPendingEntities();
+    }
+  }
+
+  void addSplitEntity(
+    const Position& entityStart,
+    const std::vector<Position>& splitPositions,
+    const Position& entityEnd)
+  {
+    flushPendingEntities();
+
+    m_chunks.push_back(EntityChunk{
+      EntityChunkType::EntityStart,
+      substr(entityStart.offset, splitPositions.front().offset),
+      entityStart.location,
+      entityEnd.location,
+    });
+
+    for (size_t i = 0; i < splitPositions.size(); ++i)
+    {
+      const auto chunkEnd = i + 1 < splitPositions.size() ? splitPositions[i + 1].offset
+                                                          : entityEnd.offset;
+      m_chunks.push_back(EntityChunk{
+        EntityChunkType::EntityBrushes,
+        substr(splitPositions[i].offset, chunkEnd),
+        splitPositions[i].location,
+      });
+    }
+  }
+
+  void flushPendingEntities()
+  {
+    if (m_pendingEntitiesStart)
+    {
+      m_chunks.push_back(EntityChunk{
+        EntityChunkType::Entities,
+        substr(m_pendingEntitiesStart->offset, m_pendingEntitiesEnd),
+        m_pendingEntitiesStart->location,
+      });
+      m_pendingEntitiesStart = std::nullopt;
+    }
+  }
+
+  /**
+   * Material names are read as words by the parser even if they start with a brace, so
+   * we only consider an opening brace a token if it isn't directly followed by a word.
+   */
+  bool isBrace() const
+  {
+    const auto next = lookAhead(1);
+    return next == 0 || isWhitespace(next) || next == '{' || next == '}' || next == '"'
+           || next == '(' || next == '/';
+  }
+
+  /**
+   * Skips whitespace and comments that QuakeMapTokenizer discards. Stops at the start of
+   * a comment token (three slashes followed by a space).
+   */
+  void skipIgnored()
+  {
+    while (!eof())
+    {
+      switch (curChar())
+      {
+      case ' ':
+      case '\t':
+      case '\n':
+      case '\r':
+        advance();
+        break;
+      case ';':
+        skipUntilEol();
+        break;
+      case '/':
+        if (lookAhead(1) != '/')
+        {
+          // the tokenizer skips single slashes
+          advance();
+          break;
+        }
+        if (lookAhead(2) == '/' && lookAhead(3) == ' ')
+        {
+          return;
+        }
+        skipUntilEol();
+        break;
+      default:
+        return;
+      }
+    }
+  }
+
+  /**
+   * Skips a quoted string using the same escaping rules as QuakeMapTokenizer. Returns
+   * false if the string is not terminated.
+   */
+  bool skipQuotedString()
+  {
+    advance();
+
+    auto escaped = false;
+    while (!eof())
+    {
+      const auto c = curChar();
+      if (c == '"')
+      {
+        if (!escaped)
+        {
+          break;
+        }
+        if (lookAhead(1) == '\n' || lookAhead(1) == '}')
+        {
+          // a path with a trailing backslash, see QuakeMapTokenizer
+          break;
+        }
+      }
+
+      if (c == '\n' || (c == '\r' && lookAhead(1) != '\n'))
+      {
+        escaped = false;
+      }
+      else if (c != '\r')
+      {
+        escaped = c == '\\' ? !escaped : false;
+      }
+      advance();
+    }
+
+    if (eof())
+    {
+      return false;
+    }
+
+    advance();
+    return true;
+  }
+
+  /**
+   * Skips an integer, a decimal or a word. Numbers end at whitespace or at a closing
+   * parenthesis, words end at whitespace only.
+   */
+  void skipWord()
+  {
+    if (const auto end = numberEnd())
+    {
+      advance(*end - m_offset);
+      return;
+    }
+
+    do
+    {
+      advance();
+    } while (!eof() && !isWhitespace(curChar()));
+  }
+
+  std::optional<size_t> numberEnd() const
+  {
+    const auto isNumberDelim = [&](const size_t i) {
+      return i >= m_str.size() || isWhitespace(m_str[i]) || m_str[i] == ')';
+    };
+    const auto isDigit = [&](const size_t i) {
+      return i < m_str.size() && m_str[i] >= '0' && m_str[i] <= '9';
+    };
+    const auto isAnyOf = [&](const size_t i, const std::string_view chars) {
+      return i < m_str.size() && chars.find(m_str[i]) != std::string_view::npos;
+    };
+    const auto skipDigits = [&](size_t i) {
+      while (isDigit(i))
+      {
+        ++i;
+      }
+      return i;
+    };
+
+    // integer
+    auto i = m_offset;
+    if (isAnyOf(i, "+-") || isDigit(i))
+    {
+      i = skipDigits(isAnyOf(i, "+-") ? i + 1 : i);
+      if (isNumberDelim(i))
+      {
+        return i;
+      }
+    }
+
+    // decimal
+    i = m_offset;
+    if (isAnyOf(i, "+-.") || isDigit(i))
+    {
+      if (!isAnyOf(i, "."))
+      {
+        i = skipDigits(i + 1);
+      }
+      if (isAnyOf(i, "."))
+      {
+        i = skipDigits(i + 1);
+      }
+      if (isAnyOf(i, "eE"))
+      {
+        ++i;
+        if (isAnyOf(i, "+-") || isDigit(i))
+        {
+          i = skipDigits(i + 1);
+        }
+      }
+      if (isNumberDelim(i))
+      {
+        return i;
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  void skipUntilEol()
+  {
+    while (!eof() && curChar() != '\n' && curChar() != '\r')
+    {
+      advance();
+    }
+  }
+
+  bool eof() const { return m_offset >= m_str.size(); }
+
+  char curChar() const { return m_str[m_offset]; }
+
+  char lookAhead(const size_t offset) const
+  {
+    return m_offset + offset < m_str.size() ? m_str[m_offset + offset] : 0;
+  }
+
+  static bool isWhitespace(const char c)
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+  }
+
+  void advance(const size_t count = 1)
+  {
+    for (size_t i = 0; i < count && !eof(); ++i)
+    {
+      // a carriage return followed by a line feed is counted as one line break
+      const auto c = curChar();
+      ++m_offset;
+      if (c == '\n' || (c == '\r' && (eof() || curChar() != '\n')))
+      {
+        ++m_line;
+        m_lineStart = m_offset;
+      }
+    }
+  }
+
+  Position position() const
+  {
+    return {m_offset, {m_line, m_offset - m_lineStart + 1}};
+  }
+
+  std::string_view substr(const size_t begin, const size_t end) const
+  {
+    return m_str.substr(begin, end - begin);
+  }
+};
+
+} // namespace
+
+std::optional<std::vector<EntityChunk>> splitIntoEntityChunks(
+  const std::string_view str, const size_t chunkSize)
+{
+  return EntityChunkScanner{str, chunkSize}.scan();
+}
 
 const std::string& QuakeMapTokenizer::NumberDelim()
 {
@@ -38,8 +456,9 @@ const std::string& QuakeMapTokenizer::NumberDelim()
   return numberDelim;
 }
 
-QuakeMapTokenizer::QuakeMapTokenizer(const std::string_view str)
-  : Tokenizer{str, "\"", '\\'}
+QuakeMapTokenizer::QuakeMapTokenizer(
+  const std::string_view str, const size_t line, const size_t column)
+  : Tokenizer{str, "\"", '\\', line, column}
 {
 }
 
@@ -152,7 +571,16 @@ StandardMapParser::StandardMapParser(
   const std::string_view str,
   const mdl::MapFormat sourceMapFormat,
   const mdl::MapFormat targetMapFormat)
-  : m_tokenizer{str}
+  : StandardMapParser{str, FileLocation{1, 1}, sourceMapFormat, targetMapFormat}
+{
+}
+
+StandardMapParser::StandardMapParser(
+  const std::string_view str,
+  const FileLocation& startLocation,
+  const mdl::MapFormat sourceMapFormat,
+  const mdl::MapFormat targetMapFormat)
+  : m_tokenizer{str, startLocation.line, startLocation.column.value_or(1)}
   , m_sourceMapFormat{sourceMapFormat}
   , m_targetMapFormat{targetMapFormat}
 {
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "FileLocation.h"
 #include "io/MapParser.h"
 #include "io/Parser.h"
 #include "io/Tokenizer.h"
@@ -28,15 +29,11 @@
 
 #include "vm/vec.h"
 
+#include <optional>
 #include <string_view>
 #include <tuple>
 #include <vector>
 
-namespace tb
-{
-struct FileLocation;
-}
-
 namespace tb::io
 {
 class ParserStatus;
@@ -66,7 +63,7 @@ private:
   bool m_skipEol = true;
 
 public:
-  explicit QuakeMapTokenizer(std::string_view str);
+  explicit QuakeMapTokenizer(std::string_view str, size_t line = 1, size_t column = 1);
 
   void setSkipEol(bool skipEol);
 
@@ -74,6 +71,49 @@ private:
   Token emitToken() override;
 };
 
+enum class EntityChunkType
+{
+  /** One or more complete entities. */
+  Entities,
+  /**
+   * The opening brace and properties of an entity and its first brushes and patches, but
+   * not its closing brace.
+   */
+  EntityStart,
+  /**
+   * Brushes and patches of the entity started by the preceding EntityStart chunk. The
+   * last such chunk of an entity ends before the entity's closing brace.
+   */
+  EntityBrushes,
+};
+
+/**
+ * A part of a map file that can be parsed independently of the other parts.
+ */
+struct EntityChunk
+{
+  EntityChunkType type;
+  std::string_view str;
+  FileLocation startLocation;
+
+  /** The location of the entity's closing brace if this is an EntityStart chunk. */
+  std::optional<FileLocation> endLocation = std::nullopt;
+};
+
+/**
+ * Splits the given map file into chunks of roughly the given size at entity boundaries.
+ * Consecutive small entities are joined into one chunk, and entities that are larger than
+ * the given size are split between their brushes and patches.
+ *
+ * The file is scanned according to the rules of QuakeMapTokenizer, so braces in quoted
+ * strings, comments and material names are skipped.
+ *
+ * Returns std::nullopt if the file doesn't consist of a sequence of entities. In that
+ * case, the file should be parsed sequentially to report the appropriate errors.
+ */
+std::optional<std::vector<EntityChunk>> splitIntoEntityChunks(
+  std::string_view str, size_t chunkSize);
+
 class StandardMapParser : public MapParser, public Parser<QuakeMapToken::Type>
 {
 private:
@@ -104,6 +144,16 @@ public:
   ~StandardMapParser() override;
 
 protected:
+  /**
+   * Creates a new parser for a part of a map file, where the given string starts at the
+   * given location in the file.
+   */
+  StandardMapParser(
+    std::string_view str,
+    const FileLocation& startLocation,
+    mdl::MapFormat sourceMapFormat,
+    mdl::MapFormat targetMapFormat);
+
   void parseEntities(ParserStatus& status);
   void parseBrushesOrPatches(ParserStatus& status);
   void parseBrushFaces(ParserStatus& status);
@@ -54,7 +54,7 @@ namespace WadEntryType
 // static const char WEPalette   = '@';
 }
 
-WadFileSystem::WadFileSystem(std::shared_ptr<CFile> file)
+WadFileSystem::WadFileSystem(std::shared_ptr<MappedFile> file)
   : ImageFileSystem{file->buffer()}
 {
 }
@@ -25,12 +25,17 @@
 namespace tb::io
 {
 class FileSystem;
+class MappedFile;
 class OwningBufferFile;
 
 class WadFileSystem : public ImageFileSystem<OwningBufferFile>
 {
 public:
-  explicit WadFileSystem(std::shared_ptr<CFile> file);
+  /**
+   * Creates a file system for the given wad file. The contents of the file are copied so
+   * that the wad file can be modified or replaced while the file system exists.
+   */
+  explicit WadFileSystem(std::shared_ptr<MappedFile> file);
 
 private:
   Result<void> doReadDirectory() override;
@@ -20,6 +20,8 @@
 #include "ZipFileSystem.h"
 
 #include "io/File.h"
+#include "io/Reader.h"
+#include "io/ReaderException.h"
 
 #include "kdl/result.h"
 
@@ -53,61 +55,140 @@ std::string filename(mz_zip_archive& archive, const mz_uint fileIndex)
 
   return result;
 }
+
+size_t readArchive(void* opaque, const mz_uint64 offset, void* buffer, const size_t size)
+{
+  auto& reader = *static_cast<Reader*>(opaque);
+  try
+  {
+    reader.seekFromBegin(static_cast<size_t>(offset));
+    reader.read(static_cast<char*>(buffer), size);
+    return size;
+  }
+  catch (const ReaderException&)
+  {
+    return 0;
+  }
+}
+
+Result<std::shared_ptr<File>> extractFile(
+  mz_zip_archive& archive, const mz_uint fileIndex, const std::filesystem::path& path)
+{
+  auto stat = mz_zip_archive_file_stat{};
+  if (!mz_zip_reader_file_stat(&archive, fileIndex, &stat))
+  {
+    return Error{"mz_zip_reader_file_stat failed for " + path.string()};
+  }
+
+  const auto uncompressedSize = static_cast<size_t>(stat.m_uncomp_size);
+  auto data = std::make_unique<char[]>(uncompressedSize);
+  auto* begin = data.get();
+
+  if (!mz_zip_reader_extract_to_mem(&archive, fileIndex, begin, uncompressedSize, 0))
+  {
+    return Error{"mz_zip_reader_extract_to_mem failed for " + path.string()};
+  }
+
+  return std::static_pointer_cast<File>(
+    std::make_shared<OwningBufferFile>(std::move(data), uncompressedSize));
+}
 } // namespace
 
-ZipFileSystem::~ZipFileSystem()
+void ZipFileSystem::ArchiveDeleter::operator()(Archive* archive) const
 {
-  mz_zip_reader_end(&m_archive);
+  mz_zip_reader_end(&archive->zip);
+  delete archive;
 }
 
+ZipFileSystem::~ZipFileSystem() = default;
+
 Result<void> ZipFileSystem::doReadDirectory()
 {
-  mz_zip_zero_struct(&m_archive);
-
-  if (mz_zip_reader_init_cfile(&m_archive, m_file->file(), m_file->size(), 0) != MZ_TRUE)
   {
-    return Error{"Error calling mz_zip_reader_init_cfile"};
+    auto lock = std::lock_guard{m_archivesMutex};
+    m_archives.clear();
   }
 
-  const auto numFiles = mz_zip_reader_get_num_files(&m_archive);
-  for (mz_uint i = 0; i < numFiles; ++i)
+  return acquireArchive() | kdl::and_then([&](auto archive) -> Result<void> {
+           const auto numFiles = mz_zip_reader_get_num_files(&archive->zip);
+           for (mz_uint i = 0; i < numFiles; ++i)
+           {
+             if (!mz_zip_reader_is_file_a_directory(&archive->zip, i))
+             {
+               const auto path = std::filesystem::path{filename(archive->zip, i)};
+               addFile(path, [&, i, path]() -> Result<std::shared_ptr<File>> {
+                 return acquireArchive() | kdl::and_then([&](auto fileArchive) {
+                          auto file = extractFile(fileArchive->zip, i, path);
+                          releaseArchive(std::move(fileArchive));
+                          return file;
+                        });
+               });
+             }
+           }
+
+           const auto err = mz_zip_get_last_error(&archive->zip);
+           if (err != MZ_ZIP_NO_ERROR)
+           {
+             return Error{
+               std::string{"Error while reading compressed file: "}
+               + mz_zip_get_error_string(err)};
+           }
+
+           releaseArchive(std::move(archive));
+           return kdl::void_success;
+         });
+}
+
+Result<ZipFileSystem::ArchivePtr> ZipFileSystem::acquireArchive()
+{
+  const auto readFromFile = m_file->isModified();
+
   {
-    if (!mz_zip_reader_is_file_a_directory(&m_archive, i))
+    auto lock = std::lock_guard{m_archivesMutex};
+    if (readFromFile)
+    {
+      // the mapped memory must not be accessed once the archive has been modified
+      std::erase_if(m_archives, [](const auto& archive) { return !archive->reader; });
+    }
+
+    if (!m_archives.empty())
     {
-      const auto path = std::filesystem::path{filename(m_archive, i)};
-      addFile(path, [&, i, path]() -> Result<std::shared_ptr<File>> {
-        auto loadFileGoard = std::lock_guard{m_mutex};
-
-        auto stat = mz_zip_archive_file_stat{};
-        if (!mz_zip_reader_file_stat(&m_archive, i, &stat))
-        {
-          return Error{"mz_zip_reader_file_stat failed for " + path.string()};
-        }
-
-        const auto uncompressedSize = static_cast<size_t>(stat.m_uncomp_size);
-        auto data = std::make_unique<char[]>(uncompressedSize);
-        auto* begin = data.get();
-
-        if (!mz_zip_reader_extract_to_mem(&m_archive, i, begin, uncompressedSize, 0))
-        {
-          return Error{"mz_zip_reader_extract_to_mem failed for " + path.string()};
-        }
-
-        return std::static_pointer_cast<File>(
-          std::make_shared<OwningBufferFile>(std::move(data), uncompressedSize));
-      });
+      auto archive = std::move(m_archives.back());
+      m_archives.pop_back();
+      return archive;
     }
   }
 
-  const auto err = mz_zip_get_last_error(&m_archive);
-  if (err != MZ_ZIP_NO_ERROR)
+  // creating a reader only parses the central directory of the archive
+  auto archive = ArchivePtr{new Archive{}};
+  if (readFromFile)
+  {
+    archive->reader = std::make_unique<Reader>(m_file->reader());
+    archive->zip.m_pRead = readArchive;
+    archive->zip.m_pIO_opaque = archive->reader.get();
+
+    if (mz_zip_reader_init(&archive->zip, m_file->size(), 0) != MZ_TRUE)
+    {
+      return Error{
+        std::string{"Error calling mz_zip_reader_init: "}
+        + mz_zip_get_error_string(mz_zip_get_last_error(&archive->zip))};
+    }
+  }
+  else if (
+    mz_zip_reader_init_mem(&archive->zip, m_file->begin(), m_file->size(), 0) != MZ_TRUE)
   {
     return Error{
-      std::string{"Error while reading compressed file: "}
-      + mz_zip_get_error_string(err)};
+      std::string{"Error calling mz_zip_reader_init_mem: "}
+      + mz_zip_get_error_string(mz_zip_get_last_error(&archive->zip))};
   }
 
-  return kdl::void_success;
+  return archive;
+}
+
+void ZipFileSystem::releaseArchive(ArchivePtr archive)
+{
+  auto lock = std::lock_guard{m_archivesMutex};
+  m_archives.push_back(std::move(archive));
 }
 
 } // namespace tb::io
@@ -24,17 +24,43 @@
 
 #include <miniz/miniz.h>
 
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace tb::io
 {
-class CFile;
+class MappedFile;
+class Reader;
 
-class ZipFileSystem : public ImageFileSystem<CFile>
+/**
+ * A file system that reads the contents of a zip archive.
+ *
+ * A miniz archive reader must not be used by multiple threads at once. To allow files to
+ * be extracted concurrently, the file system keeps a pool of archive readers which all
+ * read from the same memory mapped archive. A loader takes a reader from the pool, or
+ * creates a new one if the pool is empty, and returns it after extracting its file. If
+ * the archive is modified on the disk, the pooled readers are discarded and new readers
+ * read the archive through the file instead (see MappedFile).
+ */
+class ZipFileSystem : public ImageFileSystem<MappedFile>
 {
 private:
-  mz_zip_archive m_archive;
-  std::mutex m_mutex;
+  struct Archive
+  {
+    mz_zip_archive zip = {};
+    // if set, the archive is read through this reader instead of the mapped memory
+    std::unique_ptr<Reader> reader;
+  };
+
+  struct ArchiveDeleter
+  {
+    void operator()(Archive* archive) const;
+  };
+  using ArchivePtr = std::unique_ptr<Archive, ArchiveDeleter>;
+
+  std::vector<ArchivePtr> m_archives;
+  std::mutex m_archivesMutex;
 
 public:
   using ImageFileSystem::ImageFileSystem;
@@ -42,5 +68,8 @@ public:
 
 private:
   Result<void> doReadDirectory() override;
+
+  Result<ArchivePtr> acquireArchive();
+  void releaseArchive(ArchivePtr archive);
 };
 } // namespace tb::io
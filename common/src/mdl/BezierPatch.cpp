@@ -144,6 +144,12 @@ void BezierPatch::setMaterialName(std::string materialName)
   m_materialName = std::move(materialName);
 }
 
+size_t BezierPatch::sizeInBytes() const
+{
+  return sizeof(BezierPatch) + m_materialName.capacity()
+         + m_controlPoints.size() * sizeof(Point);
+}
+
 const Material* BezierPatch::material() const
 {
   return m_materialReference.get();
@@ -88,6 +88,11 @@ public: // control points:
   const std::string& materialName() const;
   void setMaterialName(std::string materialName);
 
+  /**
+   * Returns an estimate of the memory used by this patch, including its control points in bytes.
+   */
+  size_t sizeInBytes() const;
+
   const Material* material() const;
   bool setMaterial(Material* material);
 
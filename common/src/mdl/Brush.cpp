@@ -40,6 +40,7 @@
 #include "vm/vec_ext.h"
 
 #include <iterator>
+#include <optional>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -255,6 +256,24 @@ bool Brush::fullySpecified() const
   return true;
 }
 
+size_t Brush::sizeInBytes() const
+{
+  auto result = sizeof(Brush);
+  for (const auto& face : m_faces)
+  {
+    result += face.sizeInBytes();
+  }
+
+  if (m_geometry)
+  {
+    result += sizeof(BrushGeometry) + m_geometry->vertexCount() * sizeof(BrushVertex)
+              + m_geometry->edgeCount() * (sizeof(BrushEdge) + 2u * sizeof(BrushHalfEdge))
+              + m_geometry->faceCount() * sizeof(BrushFaceGeometry);
+  }
+
+  return result;
+}
+
 void Brush::cloneFaceAttributesFrom(const Brush& brush)
 {
   for (auto& destination : m_faces)
@@ -1164,19 +1183,87 @@ Result<void> Brush::intersect(const vm::bbox3d& worldBounds, const Brush& brush)
   return updateGeometryFromFaces(worldBounds);
 }
 
+/**
+ * Checks whether the given transformation maps the coordinate axes onto each other, i.e.,
+ * whether its linear part consists only of rotations by multiples of 90 degrees and
+ * flips, up to rounding errors. If so, returns the transformation with the linear part
+ * rounded to exact values, which maps integer coordinates to integer coordinates exactly
+ * if its translation is integral.
+ */
+static std::optional<vm::mat4x4d> snapToAxisAlignedTransformation(
+  const vm::mat4x4d& transformation)
+{
+  auto result = transformation;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    auto rowCount = size_t(0);
+    auto columnCount = size_t(0);
+    for (size_t j = 0; j < 3; ++j)
+    {
+      const auto value = vm::round(transformation[j][i]);
+      if (
+        vm::abs(transformation[j][i] - value) > vm::Cd::almost_zero()
+        || vm::abs(value) > 1.0)
+      {
+        return std::nullopt;
+      }
+      result[j][i] = value;
+
+      rowCount += value != 0.0 ? 1u : 0u;
+      columnCount += vm::round(transformation[i][j]) != 0.0 ? 1u : 0u;
+    }
+
+    if (rowCount != 1u || columnCount != 1u || transformation[i][3] != 0.0)
+    {
+      return std::nullopt;
+    }
+  }
+
+  return transformation[3][3] == 1.0 ? std::optional{result} : std::nullopt;
+}
+
 Result<void> Brush::transform(
   const vm::bbox3d& worldBounds,
   const vm::mat4x4d& transformation,
   const bool lockMaterials)
 {
+  // The faces must be transformed by the same matrix as the geometry if the geometry is
+  // transformed in place
+  const auto axisAlignedTransformation = snapToAxisAlignedTransformation(transformation);
+  const auto& faceTransformation =
+    axisAlignedTransformation ? *axisAlignedTransformation : transformation;
+
   for (auto& face : m_faces)
   {
-    if (!face.transform(transformation, lockMaterials).is_success())
+    if (!face.transform(faceTransformation, lockMaterials).is_success())
     {
       return Error{"Brush has invalid face"};
     }
   }
 
+  if (m_geometry && axisAlignedTransformation)
+  {
+    // The transformation does not change the topology of the geometry and it maps the
+    // vertices exactly if they and the translation are on the integer grid, so the
+    // geometry can be transformed in place instead of being rebuilt from the faces.
+    m_geometry->transform(*axisAlignedTransformation);
+    m_geometry->correctVertexPositions();
+
+    // The rebuilt geometry would be clipped by the world bounds
+    if (worldBounds.encloses(m_geometry->bounds()))
+    {
+      // Keep the faces in the order in which updateGeometryFromFaces would add them
+      BrushFace::sortFaces(m_faces);
+      for (size_t i = 0u; i < m_faces.size(); ++i)
+      {
+        m_faces[i].geometry()->setPayload(i);
+      }
+
+      assert(checkFaceLinks());
+      return kdl::void_success;
+    }
+  }
+
   return updateGeometryFromFaces(worldBounds);
 }
 
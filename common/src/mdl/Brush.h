@@ -104,6 +104,12 @@ public: // face management:
   bool closed() const;
   bool fullySpecified() const;
 
+  /**
+   * Returns an estimate of the memory used by this brush in bytes, including its faces
+   * and its geometry.
+   */
+  size_t sizeInBytes() const;
+
 public: // clone face attributes from matching faces of other brushes
   void cloneFaceAttributesFrom(const Brush& brush);
   void cloneFaceAttributesFrom(const std::vector<const Brush*>& brushes);
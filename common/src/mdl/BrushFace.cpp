@@ -827,6 +827,13 @@ std::optional<double> BrushFace::intersectWithRay(const vm::ray3d& ray) const
                          : std::nullopt;
 }
 
+size_t BrushFace::sizeInBytes() const
+{
+  // the material name is interned and shared with other faces, so it is not counted;
+  // the paraxial coord system is the larger of the two
+  return sizeof(BrushFace) + (m_uvCoordSystem ? sizeof(ParaxialUVCoordSystem) : 0u);
+}
+
 Result<void> BrushFace::setPoints(
   const vm::vec3d& point0, const vm::vec3d& point1, const vm::vec3d& point2)
 {
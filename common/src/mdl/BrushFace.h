@@ -268,6 +268,12 @@ public:
 
   std::optional<double> intersectWithRay(const vm::ray3d& ray) const;
 
+  /**
+   * Returns an estimate of the memory used by this face in bytes, including the memory
+   * owned by it. The face geometry is owned by the brush and is not included.
+   */
+  size_t sizeInBytes() const;
+
 private:
   Result<void> setPoints(
     const vm::vec3d& point0, const vm::vec3d& point1, const vm::vec3d& point2);
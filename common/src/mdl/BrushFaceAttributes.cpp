@@ -51,6 +51,11 @@ BrushFaceAttributes::BrushFaceAttributes(
 kdl_reflect_impl(BrushFaceAttributes);
 
 const std::string& BrushFaceAttributes::materialName() const
+{
+  return m_materialName.str();
+}
+
+const InternedString& BrushFaceAttributes::internedMaterialName() const
 {
   return m_materialName;
 }
@@ -134,9 +139,10 @@ bool BrushFaceAttributes::valid() const
 
 bool BrushFaceAttributes::setMaterialName(const std::string& materialName)
 {
-  if (materialName != m_materialName)
+  if (auto internedMaterialName = InternedString{materialName};
+      internedMaterialName != m_materialName)
   {
-    m_materialName = materialName;
+    m_materialName = internedMaterialName;
     return true;
   }
   return false;
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Color.h"
+#include "InternedString.h"
 
 #include "kdl/reflection_decl.h"
 
@@ -39,7 +40,7 @@ public:
   static const std::string NoMaterialName;
 
 private:
-  std::string m_materialName;
+  InternedString m_materialName;
 
   vm::vec2f m_offset = vm::vec2f{0, 0};
   vm::vec2f m_scale = vm::vec2f{1, 1};
@@ -67,6 +68,7 @@ public:
     m_color);
 
   const std::string& materialName() const;
+  const InternedString& internedMaterialName() const;
 
   const vm::vec2f& offset() const;
   float xOffset() const;
@@ -36,6 +36,7 @@
 #include "render/BrushRendererBrushCache.h"
 
 #include "kdl/overload.h"
+#include "kdl/vector_utils.h"
 
 #include "vm/intersection.h"
 #include "vm/util.h"
@@ -54,6 +55,7 @@ BrushNode::BrushNode(Brush brush)
   , m_brush(std::move(brush))
 {
   clearSelectedFaces();
+  updateFacePlanes();
 }
 
 BrushNode::~BrushNode() = default;
@@ -98,6 +100,7 @@ Brush BrushNode::setBrush(Brush brush)
   swap(m_brush, brush);
 
   updateSelectedFaceCount();
+  updateFacePlanes();
   invalidateIssues();
   invalidateVertexCache();
 
@@ -261,6 +264,12 @@ void BrushNode::updateSelectedFaceCount()
   }
 }
 
+void BrushNode::updateFacePlanes()
+{
+  m_facePlanes = PackedPlanes{kdl::vec_transform(
+    m_brush.faces(), [](const auto& face) { return face.boundary(); })};
+}
+
 const std::string& BrushNode::doGetName() const
 {
   static const std::string name("brush");
@@ -366,14 +375,7 @@ std::optional<std::tuple<double, size_t>> BrushNode::findFaceHit(
 {
   if (vm::intersect_ray_bbox(ray, logicalBounds()))
   {
-    for (size_t i = 0u; i < m_brush.faceCount(); ++i)
-    {
-      const auto& face = m_brush.face(i);
-      if (const auto distance = face.intersectWithRay(ray))
-      {
-        return std::tuple{*distance, i};
-      }
-    }
+    return m_facePlanes.intersectWithRay(ray);
   }
   return std::nullopt;
 }
@@ -393,6 +395,16 @@ GroupNode* BrushNode::doGetContainingGroup()
   return findContainingGroup(this);
 }
 
+void BrushNode::doLinkIdWillChange()
+{
+  removeFromLinkIdIndex(this, linkId());
+}
+
+void BrushNode::doLinkIdDidChange()
+{
+  addToLinkIdIndex(this, linkId());
+}
+
 void BrushNode::invalidateVertexCache()
 {
   m_brushRendererBrushCache->invalidateVertexCache();
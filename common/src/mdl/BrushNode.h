@@ -25,6 +25,7 @@
 #include "mdl/HitType.h"
 #include "mdl/Node.h"
 #include "mdl/Object.h"
+#include "mdl/PackedPlanes.h"
 #include "mdl/TagType.h"
 
 #include "vm/ray.h"
@@ -60,6 +61,7 @@ private:
   mutable std::unique_ptr<render::BrushRendererBrushCache>
     m_brushRendererBrushCache; // unique_ptr for breaking header dependencies
   Brush m_brush;               // must be destroyed before the brush renderer cache
+  PackedPlanes m_facePlanes;   // the face boundaries of m_brush, used for picking
   size_t m_selectedFaceCount = 0u;
 
 public:
@@ -87,6 +89,7 @@ public:
 private:
   void clearSelectedFaces();
   void updateSelectedFaceCount();
+  void updateFacePlanes();
 
 private: // implement Node interface
   const std::string& doGetName() const override;
@@ -120,6 +123,8 @@ private: // implement Object interface
   Node* doGetContainer() override;
   LayerNode* doGetContainingLayer() override;
   GroupNode* doGetContainingGroup() override;
+  void doLinkIdWillChange() override;
+  void doLinkIdDidChange() override;
 
 public: // renderer cache
   /**
@@ -63,16 +63,19 @@ kdl_reflect_impl(DecalSpecification);
 
 DecalDefinition::DecalDefinition()
   : m_expression{el::LiteralExpression{el::Value::Undefined}}
+  , m_compiledExpression{m_expression.compile()}
 {
 }
 
 DecalDefinition::DecalDefinition(const FileLocation& location)
   : m_expression{el::LiteralExpression{el::Value::Undefined}, location}
+  , m_compiledExpression{m_expression.compile()}
 {
 }
 
 DecalDefinition::DecalDefinition(el::ExpressionNode expression)
   : m_expression{std::move(expression)}
+  , m_compiledExpression{m_expression.compile()}
 {
 }
 
@@ -83,12 +86,13 @@ void DecalDefinition::append(const DecalDefinition& other)
   auto cases =
     std::vector<el::ExpressionNode>{std::move(m_expression), other.m_expression};
   m_expression = el::ExpressionNode{el::SwitchExpression{std::move(cases)}, location};
+  m_compiledExpression = m_expression.compile();
 }
 
 DecalSpecification DecalDefinition::decalSpecification(
   const el::VariableStore& variableStore) const
 {
-  return convertToDecal(m_expression.evaluate(el::EvaluationContext{variableStore}));
+  return convertToDecal(m_compiledExpression.evaluate(variableStore));
 }
 
 DecalSpecification DecalDefinition::defaultDecalSpecification() const
@@ -96,6 +100,11 @@ DecalSpecification DecalDefinition::defaultDecalSpecification() const
   return decalSpecification(el::NullVariableStore{});
 }
 
+const el::ExpressionNode& DecalDefinition::expression() const
+{
+  return m_expression;
+}
+
 kdl_reflect_impl(DecalDefinition);
 
 } // namespace tb::mdl
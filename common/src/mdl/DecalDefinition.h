@@ -20,6 +20,7 @@
 #pragma once
 
 #include "el/Expression.h"
+#include "mdl/DecalSpecification.h"
 
 #include "kdl/reflection_decl.h"
 
@@ -38,17 +39,11 @@ namespace DecalSpecificationKeys
 constexpr auto Material = "texture";
 } // namespace DecalSpecificationKeys
 
-struct DecalSpecification
-{
-  std::string materialName;
-
-  kdl_reflect_decl(DecalSpecification, materialName);
-};
-
 class DecalDefinition
 {
 private:
   el::ExpressionNode m_expression;
+  el::CompiledExpression m_compiledExpression;
 
 public:
   DecalDefinition();
@@ -77,6 +72,8 @@ public:
    */
   DecalSpecification defaultDecalSpecification() const;
 
+  const el::ExpressionNode& expression() const;
+
   kdl_reflect_decl(DecalDefinition, m_expression);
 };
 
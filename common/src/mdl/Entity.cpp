@@ -95,6 +95,19 @@ void Entity::setProperties(std::vector<EntityProperty> properties)
   m_cachedOrigin = std::nullopt;
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  m_cachedModelSpecification = std::nullopt;
+  m_cachedDecalSpecification = std::nullopt;
+}
+
+size_t Entity::sizeInBytes() const
+{
+  auto result = sizeof(Entity);
+  for (const auto& property : m_properties)
+  {
+    result +=
+      sizeof(EntityProperty) + property.key().capacity() + property.value().capacity();
+  }
+  return result;
 }
 
 const std::vector<std::string>& Entity::protectedProperties() const
@@ -153,6 +166,8 @@ void Entity::setDefinition(EntityDefinition* definition)
 
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  m_cachedModelSpecification = std::nullopt;
+  m_cachedDecalSpecification = std::nullopt;
 }
 
 const EntityModel* Entity::model() const
@@ -180,26 +195,34 @@ const EntityModelFrame* Entity::modelFrame() const
            : nullptr;
 }
 
-ModelSpecification Entity::modelSpecification() const
+const ModelSpecification& Entity::modelSpecification() const
 {
-  if (
-    const auto* pointDefinition =
-      dynamic_cast<const PointEntityDefinition*>(m_definition.get()))
-  {
-    const auto variableStore = EntityPropertiesVariableStore{*this};
-    return pointDefinition->modelDefinition().modelSpecification(variableStore);
-  }
-  else
+  if (!m_cachedModelSpecification)
   {
-    return ModelSpecification{};
+    if (
+      const auto* pointDefinition =
+        dynamic_cast<const PointEntityDefinition*>(m_definition.get()))
+    {
+      const auto variableStore = EntityPropertiesVariableStore{*this};
+      m_cachedModelSpecification =
+        pointDefinition->modelDefinition().modelSpecification(variableStore);
+    }
+    else
+    {
+      m_cachedModelSpecification = ModelSpecification{};
+    }
   }
+  return *m_cachedModelSpecification;
 }
 
 const vm::mat4x4d& Entity::modelTransformation(
   const std::optional<el::ExpressionNode>& defaultModelScaleExpression) const
 {
-  if (!m_cachedModelTransformation)
+  if (
+    !m_cachedModelTransformation
+    || m_cachedDefaultModelScaleExpression != defaultModelScaleExpression)
   {
+    m_cachedDefaultModelScaleExpression = defaultModelScaleExpression;
     if (
       const auto* pointDefinition =
         dynamic_cast<const PointEntityDefinition*>(m_definition.get()))
@@ -218,19 +241,24 @@ const vm::mat4x4d& Entity::modelTransformation(
   return *m_cachedModelTransformation;
 }
 
-DecalSpecification Entity::decalSpecification() const
+const DecalSpecification& Entity::decalSpecification() const
 {
-  if (
-    const auto* pointDefinition =
-      dynamic_cast<const PointEntityDefinition*>(m_definition.get()))
+  if (!m_cachedDecalSpecification)
   {
-    const auto variableStore = EntityPropertiesVariableStore{*this};
-    return pointDefinition->decalDefinition().decalSpecification(variableStore);
-  }
-  else
-  {
-    return DecalSpecification{};
+    if (
+      const auto* pointDefinition =
+        dynamic_cast<const PointEntityDefinition*>(m_definition.get()))
+    {
+      const auto variableStore = EntityPropertiesVariableStore{*this};
+      m_cachedDecalSpecification =
+        pointDefinition->decalDefinition().decalSpecification(variableStore);
+    }
+    else
+    {
+      m_cachedDecalSpecification = DecalSpecification{};
+    }
   }
+  return *m_cachedDecalSpecification;
 }
 
 void Entity::unsetEntityDefinitionAndModel()
@@ -244,6 +272,8 @@ void Entity::unsetEntityDefinitionAndModel()
   m_model = nullptr;
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  m_cachedModelSpecification = std::nullopt;
+  m_cachedDecalSpecification = std::nullopt;
 }
 
 void Entity::addOrUpdateProperty(
@@ -268,6 +298,8 @@ void Entity::addOrUpdateProperty(
   m_cachedOrigin = std::nullopt;
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  m_cachedModelSpecification = std::nullopt;
+  m_cachedDecalSpecification = std::nullopt;
 }
 
 void Entity::renameProperty(const std::string& oldKey, std::string newKey)
@@ -300,6 +332,8 @@ void Entity::renameProperty(const std::string& oldKey, std::string newKey)
     m_cachedOrigin = std::nullopt;
     m_cachedRotation = std::nullopt;
     m_cachedModelTransformation = std::nullopt;
+    m_cachedModelSpecification = std::nullopt;
+    m_cachedDecalSpecification = std::nullopt;
   }
 }
 
@@ -314,6 +348,8 @@ void Entity::removeProperty(const std::string& key)
     m_cachedOrigin = std::nullopt;
     m_cachedRotation = std::nullopt;
     m_cachedModelTransformation = std::nullopt;
+    m_cachedModelSpecification = std::nullopt;
+    m_cachedDecalSpecification = std::nullopt;
   }
 }
 
@@ -329,6 +365,8 @@ void Entity::removeNumberedProperty(const std::string& prefix)
     m_cachedOrigin = std::nullopt;
     m_cachedRotation = std::nullopt;
     m_cachedModelTransformation = std::nullopt;
+    m_cachedModelSpecification = std::nullopt;
+    m_cachedDecalSpecification = std::nullopt;
   }
 }
 
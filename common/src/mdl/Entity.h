@@ -19,9 +19,11 @@
 
 #pragma once
 
-#include "el/EL_Forward.h" // IWYU pragma: keep
+#include "el/Expression.h"
 #include "mdl/AssetReference.h"
+#include "mdl/DecalSpecification.h"
 #include "mdl/EntityProperties.h"
+#include "mdl/ModelSpecification.h"
 
 #include "kdl/reflection_decl.h"
 
@@ -35,12 +37,10 @@
 
 namespace tb::mdl
 {
-struct DecalSpecification;
 class Entity;
 class EntityDefinition;
 class EntityModel;
 class EntityModelFrame;
-struct ModelSpecification;
 
 enum class SetDefaultPropertyMode
 {
@@ -107,6 +107,18 @@ private:
   mutable std::optional<vm::mat4x4d> m_cachedRotation;
   mutable std::optional<vm::mat4x4d> m_cachedModelTransformation;
 
+  /**
+   * The default model scale expression that the cached model transformation was computed
+   * with. The cached transformation is discarded if a different expression is passed.
+   */
+  mutable std::optional<el::ExpressionNode> m_cachedDefaultModelScaleExpression;
+
+  /**
+   * The model and decal specifications depend only on the properties and the definition.
+   */
+  mutable std::optional<ModelSpecification> m_cachedModelSpecification;
+  mutable std::optional<DecalSpecification> m_cachedDecalSpecification;
+
 public:
   Entity();
   explicit Entity(std::vector<EntityProperty> properties);
@@ -123,6 +135,11 @@ public: // property management
   const std::vector<EntityProperty>& properties() const;
   void setProperties(std::vector<EntityProperty> properties);
 
+  /**
+   * Returns an estimate of the memory used by this entity, including its properties in bytes.
+   */
+  size_t sizeInBytes() const;
+
   /**
    * Sets the protected property keys of this entity.
    *
@@ -145,11 +162,11 @@ public: // property management
   void setModel(const EntityModel* model);
 
   const EntityModelFrame* modelFrame() const;
-  ModelSpecification modelSpecification() const;
+  const ModelSpecification& modelSpecification() const;
   const vm::mat4x4d& modelTransformation(
     const std::optional<el::ExpressionNode>& defaultModelScaleExpression) const;
 
-  DecalSpecification decalSpecification() const;
+  const DecalSpecification& decalSpecification() const;
 
   void unsetEntityDefinitionAndModel();
 
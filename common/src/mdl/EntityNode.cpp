@@ -264,6 +264,16 @@ GroupNode* EntityNode::doGetContainingGroup()
   return findContainingGroup(this);
 }
 
+void EntityNode::doLinkIdWillChange()
+{
+  removeFromLinkIdIndex(this, linkId());
+}
+
+void EntityNode::doLinkIdDidChange()
+{
+  addToLinkIdIndex(this, linkId());
+}
+
 void EntityNode::invalidateBounds()
 {
   m_cachedBounds = std::nullopt;
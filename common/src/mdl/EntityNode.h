@@ -101,6 +101,8 @@ private: // implement Object interface
   Node* doGetContainer() override;
   LayerNode* doGetContainingLayer() override;
   GroupNode* doGetContainingGroup() override;
+  void doLinkIdWillChange() override;
+  void doLinkIdDidChange() override;
 
 private:
   void invalidateBounds();
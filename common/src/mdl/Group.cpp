@@ -58,4 +58,9 @@ void Group::transform(const vm::mat4x4d& transformation)
   m_transformation = transformation * m_transformation;
 }
 
+size_t Group::sizeInBytes() const
+{
+  return sizeof(Group) + m_name.capacity();
+}
+
 } // namespace tb::mdl
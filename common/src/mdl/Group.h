@@ -47,6 +47,11 @@ public:
   const vm::mat4x4d& transformation() const;
   void setTransformation(const vm::mat4x4d& transformation);
   void transform(const vm::mat4x4d& transformation);
+
+  /**
+   * Returns an estimate of the memory used by this group in bytes.
+   */
+  size_t sizeInBytes() const;
 };
 
 } // namespace tb::mdl
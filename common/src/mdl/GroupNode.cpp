@@ -105,9 +105,29 @@ bool GroupNode::hasPendingChanges() const
   return m_hasPendingChanges;
 }
 
+const std::vector<Node*>& GroupNode::pendingChangedNodes() const
+{
+  return m_pendingChangedNodes;
+}
+
 void GroupNode::setHasPendingChanges(const bool hasPendingChanges)
 {
   m_hasPendingChanges = hasPendingChanges;
+  m_pendingChangedNodes.clear();
+}
+
+void GroupNode::addPendingChangedNodes(const std::vector<Node*>& changedNodes)
+{
+  if (!m_hasPendingChanges)
+  {
+    m_hasPendingChanges = true;
+    m_pendingChangedNodes = changedNodes;
+  }
+  else if (!m_pendingChangedNodes.empty())
+  {
+    m_pendingChangedNodes =
+      kdl::vec_concat(std::move(m_pendingChangedNodes), changedNodes);
+  }
 }
 
 void GroupNode::setEditState(const EditState editState)
@@ -294,6 +314,16 @@ GroupNode* GroupNode::doGetContainingGroup()
   return findContainingGroup(this);
 }
 
+void GroupNode::doLinkIdWillChange()
+{
+  removeFromLinkIdIndex(this, linkId());
+}
+
+void GroupNode::doLinkIdDidChange()
+{
+  addToLinkIdIndex(this, linkId());
+}
+
 void GroupNode::invalidateBounds()
 {
   m_boundsValid = false;
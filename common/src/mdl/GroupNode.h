@@ -65,6 +65,7 @@ private:
   std::optional<IdType> m_persistentId;
 
   bool m_hasPendingChanges = false;
+  std::vector<Node*> m_pendingChangedNodes;
 
 public:
   explicit GroupNode(Group group);
@@ -82,9 +83,29 @@ public:
   void setPersistentId(IdType persistentId);
   void resetPersistentId();
 
+  /**
+   * Indicates whether this group has changes that must be propagated to the other
+   * members of its link set.
+   */
   bool hasPendingChanges() const;
+
+  /**
+   * If this group's pending changes only affect the contents of some of its nodes, these
+   * nodes are returned. If the returned vector is empty, the entire group has changed.
+   */
+  const std::vector<Node*>& pendingChangedNodes() const;
+
+  /**
+   * Marks the entire group as changed or clears its pending changes.
+   */
   void setHasPendingChanges(bool hasPendingChanges);
 
+  /**
+   * Records that the contents of the given nodes have changed. If the entire group has
+   * already changed, this has no effect.
+   */
+  void addPendingChangedNodes(const std::vector<Node*>& changedNodes);
+
 private:
   void setEditState(EditState editState);
   void setAncestorEditState(EditState editState);
@@ -128,6 +149,8 @@ private: // implement methods inherited from Object
   Node* doGetContainer() override;
   LayerNode* doGetContainingLayer() override;
   GroupNode* doGetContainingGroup() override;
+  void doLinkIdWillChange() override;
+  void doLinkIdDidChange() override;
 
 private:
   void invalidateBounds();
@@ -89,6 +89,11 @@ void Layer::setOmitFromExport(const bool omitFromExport)
   m_omitFromExport = omitFromExport;
 }
 
+size_t Layer::sizeInBytes() const
+{
+  return sizeof(Layer) + m_name.capacity();
+}
+
 int Layer::invalidSortIndex()
 {
   return std::numeric_limits<int>::max();
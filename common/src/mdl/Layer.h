@@ -58,6 +58,11 @@ public:
   bool omitFromExport() const;
   void setOmitFromExport(bool omitFromExport);
 
+  /**
+   * Returns an estimate of the memory used by this layer in bytes.
+   */
+  size_t sizeInBytes() const;
+
   static int invalidSortIndex();
   static int defaultLayerSortIndex();
 };
@@ -32,8 +32,10 @@
 #include "kdl/task_manager.h"
 #include "kdl/zip_iterator.h"
 
+#include <algorithm>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace tb::mdl
 {
@@ -41,6 +43,15 @@ namespace tb::mdl
 std::vector<Node*> collectNodesWithLinkId(
   const std::vector<Node*>& nodes, const std::string& linkId)
 {
+  if (nodes.size() == 1)
+  {
+    if (const auto* worldNode = dynamic_cast<const WorldNode*>(nodes.front()))
+    {
+      // avoid traversing the entire world
+      return worldNode->findNodesWithLinkId(linkId);
+    }
+  }
+
   return collectNodesAndDescendants(
     nodes,
     kdl::overload(
@@ -53,6 +64,18 @@ std::vector<Node*> collectNodesWithLinkId(
 std::vector<GroupNode*> collectGroupsWithLinkId(
   const std::vector<Node*>& nodes, const std::string& linkId)
 {
+  if (nodes.size() == 1)
+  {
+    if (const auto* worldNode = dynamic_cast<const WorldNode*>(nodes.front()))
+    {
+      // avoid traversing the entire world
+      return kdl::vec_static_cast<GroupNode*>(
+        kdl::vec_filter(worldNode->findNodesWithLinkId(linkId), [](const auto* node) {
+          return dynamic_cast<const GroupNode*>(node) != nullptr;
+        }));
+    }
+  }
+
   return kdl::vec_static_cast<GroupNode*>(
     collectNodesAndDescendants(nodes, kdl::overload([&](const GroupNode* groupNode) {
                                  return groupNode->linkId() == linkId;
@@ -262,17 +285,17 @@ Result<std::unique_ptr<Node>> cloneAndTransformRecursive(
 }
 
 /**
- * Given a node, clones its children recursively and applies the given transform.
+ * Clones the given nodes recursively and applies the given transform.
  *
- * Returns a vector of the cloned direct children of `node`.
+ * Returns a vector of the clones of the given nodes.
  */
-Result<std::vector<std::unique_ptr<Node>>> cloneAndTransformChildren(
-  const Node& node,
+Result<std::vector<std::unique_ptr<Node>>> cloneAndTransformNodes(
+  const std::vector<Node*>& nodes,
   const vm::bbox3d& worldBounds,
   const vm::mat4x4d& transformation,
   kdl::task_manager& taskManager)
 {
-  auto nodesToClone = collectDescendants(std::vector{&node});
+  auto nodesToClone = collectNodesAndDescendants(nodes);
 
   using TransformResult = Result<std::pair<const Node*, NodeContents>>;
 
@@ -334,15 +357,30 @@ Result<std::vector<std::unique_ptr<Node>>> cloneAndTransformChildren(
              // creating a matching tree structure, and move in the contents
              // we've transformed above.
              return kdl::vec_transform(
-                      node.children(),
-                      [&](const auto* childNode) {
+                      nodes,
+                      [&](const auto* nodeToClone) {
                         return cloneAndTransformRecursive(
-                          childNode, resultsMap, worldBounds);
+                          nodeToClone, resultsMap, worldBounds);
                       })
                     | kdl::fold;
            });
 }
 
+/**
+ * Given a node, clones its children recursively and applies the given transform.
+ *
+ * Returns a vector of the cloned direct children of `node`.
+ */
+Result<std::vector<std::unique_ptr<Node>>> cloneAndTransformChildren(
+  const Node& node,
+  const vm::bbox3d& worldBounds,
+  const vm::mat4x4d& transformation,
+  kdl::task_manager& taskManager)
+{
+  return cloneAndTransformNodes(
+    node.children(), worldBounds, transformation, taskManager);
+}
+
 auto makeLinkIdToNodeMap(const std::vector<Node*>& nodes)
 {
   auto result = std::unordered_map<std::string_view, const Node*>{};
@@ -466,6 +504,292 @@ void preserveEntityProperties(
       [](const BrushNode*) {},
       [](const PatchNode*) {}));
 }
+/**
+ * Clones the children of the given source group node and transforms them into the given
+ * target group node. Group names and protected entity properties of the nodes in the
+ * target group node are preserved.
+ */
+Result<std::vector<std::unique_ptr<Node>>> cloneChildrenForTarget(
+  const GroupNode& sourceGroupNode,
+  const GroupNode& targetGroupNode,
+  const vm::mat4x4d& invertedSourceTransformation,
+  const vm::bbox3d& worldBounds,
+  kdl::task_manager& taskManager)
+{
+  const auto transformation =
+    targetGroupNode.group().transformation() * invertedSourceTransformation;
+  return cloneAndTransformChildren(
+           sourceGroupNode, worldBounds, transformation, taskManager)
+         | kdl::transform([&](auto newChildren) {
+             const auto linkIdToNodeMap = makeLinkIdToNodeMap(targetGroupNode.children());
+             preserveGroupNames(newChildren, linkIdToNodeMap);
+             preserveEntityProperties(newChildren, linkIdToNodeMap);
+             return newChildren;
+           });
+}
+
+const Group& getContents(const GroupNode& groupNode)
+{
+  return groupNode.group();
+}
+
+const Entity& getContents(const EntityNode& entityNode)
+{
+  return entityNode.entity();
+}
+
+const Brush& getContents(const BrushNode& brushNode)
+{
+  return brushNode.brush();
+}
+
+const BezierPatch& getContents(const PatchNode& patchNode)
+{
+  return patchNode.patch();
+}
+
+bool collectChangedContents(
+  const Node& clonedNode,
+  Node& targetNode,
+  std::vector<std::pair<Node*, NodeContents>>& changedContents);
+
+template <typename N>
+bool collectChangedContents(
+  const N& clonedNode,
+  Node& targetNode,
+  std::vector<std::pair<Node*, NodeContents>>& changedContents)
+{
+  auto* correspondingNode = dynamic_cast<N*>(&targetNode);
+  if (!correspondingNode || correspondingNode->linkId() != clonedNode.linkId())
+  {
+    return false;
+  }
+
+  if (getContents(clonedNode) != getContents(*correspondingNode))
+  {
+    changedContents.emplace_back(correspondingNode, NodeContents{getContents(clonedNode)});
+  }
+  return true;
+}
+
+/**
+ * Compares the given cloned node and its descendants with the given target node and its
+ * descendants by position, and collects the contents of every cloned node that differs
+ * from its counterpart.
+ *
+ * Returns false if the cloned node and the target node do not have the same structure,
+ * i.e. if the nodes differ in type, link ID or number of children.
+ */
+bool collectChangedContents(
+  const Node& clonedNode,
+  Node& targetNode,
+  std::vector<std::pair<Node*, NodeContents>>& changedContents)
+{
+  if (clonedNode.childCount() != targetNode.childCount())
+  {
+    return false;
+  }
+
+  const auto isSameNode = clonedNode.accept(kdl::overload(
+    [](const WorldNode*) { return false; },
+    [](const LayerNode*) { return false; },
+    [&](const GroupNode* clonedGroupNode) {
+      return collectChangedContents(*clonedGroupNode, targetNode, changedContents);
+    },
+    [&](const EntityNode* clonedEntityNode) {
+      return collectChangedContents(*clonedEntityNode, targetNode, changedContents);
+    },
+    [&](const BrushNode* clonedBrushNode) {
+      return collectChangedContents(*clonedBrushNode, targetNode, changedContents);
+    },
+    [&](const PatchNode* clonedPatchNode) {
+      return collectChangedContents(*clonedPatchNode, targetNode, changedContents);
+    }));
+
+  if (!isSameNode)
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < clonedNode.childCount(); ++i)
+  {
+    if (!collectChangedContents(
+          *clonedNode.children()[i], *targetNode.children()[i], changedContents))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool collectChangedContents(
+  const std::vector<std::unique_ptr<Node>>& clonedNodes,
+  const std::vector<Node*>& targetNodes,
+  std::vector<std::pair<Node*, NodeContents>>& changedContents)
+{
+  if (clonedNodes.size() != targetNodes.size())
+  {
+    return false;
+  }
+
+  const auto previousSize = changedContents.size();
+  for (size_t i = 0; i < clonedNodes.size(); ++i)
+  {
+    if (!collectChangedContents(*clonedNodes[i], *targetNodes[i], changedContents))
+    {
+      changedContents.erase(
+        std::next(changedContents.begin(), std::ptrdiff_t(previousSize)),
+        changedContents.end());
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Clones all children of the given source group node into the given target group node
+ * and collects the contents of the target's nodes that differ from their clones. If the
+ * structure of the target group node differs, its children are replaced entirely.
+ */
+Result<void> updateLinkedGroupIncrementally(
+  const GroupNode& sourceGroupNode,
+  GroupNode& targetGroupNode,
+  const vm::mat4x4d& invertedSourceTransformation,
+  const vm::bbox3d& worldBounds,
+  kdl::task_manager& taskManager,
+  IncrementalUpdateLinkedGroupsResult& result)
+{
+  return cloneChildrenForTarget(
+           sourceGroupNode,
+           targetGroupNode,
+           invertedSourceTransformation,
+           worldBounds,
+           taskManager)
+         | kdl::transform([&](auto newChildren) {
+             if (!collectChangedContents(
+                   newChildren, targetGroupNode.children(), result.swappedContents))
+             {
+               // the structure has changed, so all children are replaced
+               result.replacedChildren.emplace_back(
+                 &targetGroupNode, std::move(newChildren));
+             }
+           });
+}
+
+template <typename N>
+bool isCounterpart(const N& sourceNode, const Node& targetNode)
+{
+  const auto* correspondingNode = dynamic_cast<const N*>(&targetNode);
+  return correspondingNode && correspondingNode->linkId() == sourceNode.linkId();
+}
+
+bool isCounterpart(const Node& sourceNode, const Node& targetNode)
+{
+  return sourceNode.accept(kdl::overload(
+    [](const WorldNode*) { return false; },
+    [](const LayerNode*) { return false; },
+    [&](const GroupNode* sourceGroupNode) {
+      return isCounterpart(*sourceGroupNode, targetNode);
+    },
+    [&](const EntityNode* sourceEntityNode) {
+      return isCounterpart(*sourceEntityNode, targetNode);
+    },
+    [&](const BrushNode* sourceBrushNode) {
+      return isCounterpart(*sourceBrushNode, targetNode);
+    },
+    [&](const PatchNode* sourcePatchNode) {
+      return isCounterpart(*sourcePatchNode, targetNode);
+    }));
+}
+
+/**
+ * Removes duplicates and nodes that have an ancestor in the given vector, because these
+ * are cloned along with their ancestor.
+ */
+std::vector<Node*> removeDescendantsOfChangedNodes(const std::vector<Node*>& changedNodes)
+{
+  const auto changedNodeSet =
+    std::unordered_set<const Node*>{changedNodes.begin(), changedNodes.end()};
+  const auto hasChangedAncestor = [&](const Node* node) {
+    for (const auto* parentNode = node->parent(); parentNode;
+         parentNode = parentNode->parent())
+    {
+      if (changedNodeSet.contains(parentNode))
+      {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  auto result = std::vector<Node*>{};
+  auto addedNodes = std::unordered_set<const Node*>{};
+  for (auto* changedNode : changedNodes)
+  {
+    if (!hasChangedAncestor(changedNode) && addedNodes.insert(changedNode).second)
+    {
+      result.push_back(changedNode);
+    }
+  }
+  return result;
+}
+
+/**
+ * Clones the given changed nodes of the source group node into the given target group
+ * node and collects the contents of their counterparts that differ from the clones. The
+ * counterparts are found by their paths from the source group node and must match the
+ * changed nodes' types and link IDs. If a counterpart is missing or its structure
+ * differs, the entire target group node is updated instead.
+ */
+Result<void> updateChangedNodesIncrementally(
+  const GroupNode& sourceGroupNode,
+  const std::vector<Node*>& changedNodes,
+  const std::vector<NodePath>& changedNodePaths,
+  GroupNode& targetGroupNode,
+  const vm::mat4x4d& invertedSourceTransformation,
+  const vm::bbox3d& worldBounds,
+  kdl::task_manager& taskManager,
+  IncrementalUpdateLinkedGroupsResult& result)
+{
+  const auto updateEntireGroup = [&]() {
+    return updateLinkedGroupIncrementally(
+      sourceGroupNode,
+      targetGroupNode,
+      invertedSourceTransformation,
+      worldBounds,
+      taskManager,
+      result);
+  };
+
+  auto counterparts = std::vector<Node*>{};
+  counterparts.reserve(changedNodes.size());
+  for (size_t i = 0; i < changedNodes.size(); ++i)
+  {
+    auto* counterpart = targetGroupNode.resolvePath(changedNodePaths[i]);
+    if (!counterpart || !isCounterpart(*changedNodes[i], *counterpart))
+    {
+      return updateEntireGroup();
+    }
+    counterparts.push_back(counterpart);
+  }
+
+  const auto transformation =
+    targetGroupNode.group().transformation() * invertedSourceTransformation;
+  return cloneAndTransformNodes(changedNodes, worldBounds, transformation, taskManager)
+         | kdl::and_then([&](auto clonedNodes) -> Result<void> {
+             const auto linkIdToNodeMap = makeLinkIdToNodeMap(counterparts);
+             preserveGroupNames(clonedNodes, linkIdToNodeMap);
+             preserveEntityProperties(clonedNodes, linkIdToNodeMap);
+
+             if (!collectChangedContents(
+                   clonedNodes, counterparts, result.swappedContents))
+             {
+               return updateEntireGroup();
+             }
+             return kdl::void_success;
+           });
+}
+
 } // namespace
 
 Result<UpdateLinkedGroupsResult> updateLinkedGroups(
@@ -486,15 +810,13 @@ Result<UpdateLinkedGroupsResult> updateLinkedGroups(
   return kdl::vec_transform(
            targetGroupNodesToUpdate,
            [&](auto* targetGroupNode) {
-             const auto transformation =
-               targetGroupNode->group().transformation() * *invertedSourceTransformation;
-             return cloneAndTransformChildren(
-                      sourceGroupNode, worldBounds, transformation, taskManager)
+             return cloneChildrenForTarget(
+                      sourceGroupNode,
+                      *targetGroupNode,
+                      *invertedSourceTransformation,
+                      worldBounds,
+                      taskManager)
                     | kdl::transform([&](auto newChildren) {
-                        const auto linkIdToNodeMap =
-                          makeLinkIdToNodeMap(targetGroupNode->children());
-                        preserveGroupNames(newChildren, linkIdToNodeMap);
-                        preserveEntityProperties(newChildren, linkIdToNodeMap);
                         return std::pair{
                           static_cast<Node*>(targetGroupNode), std::move(newChildren)};
                       });
@@ -502,6 +824,87 @@ Result<UpdateLinkedGroupsResult> updateLinkedGroups(
          | kdl::fold;
 }
 
+Result<IncrementalUpdateLinkedGroupsResult> updateLinkedGroupsIncrementally(
+  const GroupNode& sourceGroupNode,
+  const std::vector<GroupNode*>& targetGroupNodes,
+  const vm::bbox3d& worldBounds,
+  kdl::task_manager& taskManager)
+{
+  const auto& sourceGroup = sourceGroupNode.group();
+  const auto invertedSourceTransformation = vm::invert(sourceGroup.transformation());
+  if (!invertedSourceTransformation)
+  {
+    return Error{"Group transformation is not invertible"};
+  }
+
+  auto result = IncrementalUpdateLinkedGroupsResult{};
+
+  const auto targetGroupNodesToUpdate =
+    kdl::vec_erase(targetGroupNodes, &sourceGroupNode);
+  return kdl::vec_transform(
+           targetGroupNodesToUpdate,
+           [&](auto* targetGroupNode) {
+             return updateLinkedGroupIncrementally(
+               sourceGroupNode,
+               *targetGroupNode,
+               *invertedSourceTransformation,
+               worldBounds,
+               taskManager,
+               result);
+           })
+         | kdl::fold | kdl::transform([&]() { return std::move(result); });
+}
+
+Result<IncrementalUpdateLinkedGroupsResult> updateLinkedGroupsIncrementally(
+  const GroupNode& sourceGroupNode,
+  const std::vector<Node*>& changedNodes,
+  const std::vector<GroupNode*>& targetGroupNodes,
+  const vm::bbox3d& worldBounds,
+  kdl::task_manager& taskManager)
+{
+  const auto nodesToUpdate = removeDescendantsOfChangedNodes(changedNodes);
+
+  const auto onlyDescendantsChanged =
+    !nodesToUpdate.empty()
+    && std::all_of(nodesToUpdate.begin(), nodesToUpdate.end(), [&](const auto* node) {
+         return node->isDescendantOf(&sourceGroupNode);
+       });
+  if (!onlyDescendantsChanged)
+  {
+    return updateLinkedGroupsIncrementally(
+      sourceGroupNode, targetGroupNodes, worldBounds, taskManager);
+  }
+
+  const auto paths = kdl::vec_transform(
+    nodesToUpdate, [&](const auto* node) { return node->pathFrom(sourceGroupNode); });
+
+  const auto& sourceGroup = sourceGroupNode.group();
+  const auto invertedSourceTransformation = vm::invert(sourceGroup.transformation());
+  if (!invertedSourceTransformation)
+  {
+    return Error{"Group transformation is not invertible"};
+  }
+
+  auto result = IncrementalUpdateLinkedGroupsResult{};
+
+  const auto targetGroupNodesToUpdate =
+    kdl::vec_erase(targetGroupNodes, &sourceGroupNode);
+  return kdl::vec_transform(
+           targetGroupNodesToUpdate,
+           [&](auto* targetGroupNode) {
+             return updateChangedNodesIncrementally(
+               sourceGroupNode,
+               nodesToUpdate,
+               paths,
+               *targetGroupNode,
+               *invertedSourceTransformation,
+               worldBounds,
+               taskManager,
+               result);
+           })
+         | kdl::fold | kdl::transform([&]() { return std::move(result); });
+}
+
 namespace
 {
 
@@ -25,6 +25,7 @@
 #include "mdl/EntityNode.h" // IWYU pragma: keep
 #include "mdl/GroupNode.h"
 #include "mdl/LayerNode.h"
+#include "mdl/NodeContents.h"
 #include "mdl/NodeVisitor.h"
 #include "mdl/PatchNode.h" // IWYU pragma: keep
 #include "mdl/WorldNode.h"
@@ -141,6 +142,62 @@ Result<UpdateLinkedGroupsResult> updateLinkedGroups(
   const vm::bbox3d& worldBounds,
   kdl::task_manager& taskManager);
 
+struct IncrementalUpdateLinkedGroupsResult
+{
+  /**
+   * Pairs of target group nodes and the new children that should replace their children.
+   */
+  UpdateLinkedGroupsResult replacedChildren;
+
+  /**
+   * Pairs of nodes in target groups and the new contents that should be swapped into them.
+   */
+  std::vector<std::pair<Node*, NodeContents>> swappedContents;
+};
+
+/**
+ * Updates the given target group nodes from the given source group node, but only replaces
+ * the nodes that have actually changed.
+ *
+ * The children of the source node are cloned and transformed into each target group node
+ * just like in updateLinkedGroups. If the cloned nodes have the same structure as the
+ * children of the target group node, i.e. the same node types and link IDs at the same
+ * positions, then the cloned nodes are compared to their counterparts in the target group
+ * node, and only the contents of the counterparts that differ are returned in
+ * swappedContents. Unchanged nodes are left as they are. If the structure differs, the
+ * children of the target group node are replaced entirely, and the new children are
+ * returned in replacedChildren.
+ *
+ * This operation fails under the same conditions as updateLinkedGroups.
+ */
+Result<IncrementalUpdateLinkedGroupsResult> updateLinkedGroupsIncrementally(
+  const GroupNode& sourceGroupNode,
+  const std::vector<mdl::GroupNode*>& targetGroupNodes,
+  const vm::bbox3d& worldBounds,
+  kdl::task_manager& taskManager);
+
+/**
+ * Updates the given target group nodes from the given source group node like the function
+ * above, but only clones and compares the given changed nodes of the source group node.
+ *
+ * The counterpart of each changed node in a target group node is the node at the same
+ * position, which must have the same type and link ID as the changed node. Each changed
+ * node is cloned together with its descendants and transformed into the target group
+ * node, and the contents of its counterpart and their descendants are swapped where they
+ * differ. Nodes that did not change are neither cloned nor compared.
+ *
+ * If a changed node has no counterpart in a target group node, or if the counterpart has
+ * a different structure, then the target group node is updated entirely as in the
+ * function above. The same happens for all target group nodes if no changed nodes are
+ * given or if the source group node itself has changed.
+ */
+Result<IncrementalUpdateLinkedGroupsResult> updateLinkedGroupsIncrementally(
+  const GroupNode& sourceGroupNode,
+  const std::vector<Node*>& changedNodes,
+  const std::vector<mdl::GroupNode*>& targetGroupNodes,
+  const vm::bbox3d& worldBounds,
+  kdl::task_manager& taskManager);
+
 std::vector<Error> initializeLinkIds(const std::vector<Node*>& nodes);
 
 /**
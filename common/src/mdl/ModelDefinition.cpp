@@ -38,16 +38,19 @@ namespace tb::mdl
 
 ModelDefinition::ModelDefinition()
   : m_expression{el::LiteralExpression{el::Value::Undefined}}
+  , m_compiledExpression{m_expression.compile()}
 {
 }
 
 ModelDefinition::ModelDefinition(const FileLocation& location)
   : m_expression{el::LiteralExpression{el::Value::Undefined}, location}
+  , m_compiledExpression{m_expression.compile()}
 {
 }
 
 ModelDefinition::ModelDefinition(el::ExpressionNode expression)
   : m_expression{std::move(expression)}
+  , m_compiledExpression{m_expression.compile()}
 {
 }
 
@@ -57,6 +60,7 @@ void ModelDefinition::append(ModelDefinition other)
 
   auto cases = std::vector{std::move(m_expression), std::move(other.m_expression)};
   m_expression = el::ExpressionNode{el::SwitchExpression{std::move(cases)}, location};
+  m_compiledExpression = m_expression.compile();
 }
 
 static std::filesystem::path path(const el::Value& value)
@@ -105,8 +109,7 @@ static ModelSpecification convertToModel(const el::Value& value)
 ModelSpecification ModelDefinition::modelSpecification(
   const el::VariableStore& variableStore) const
 {
-  const auto context = el::EvaluationContext{variableStore};
-  return convertToModel(m_expression.evaluate(context));
+  return convertToModel(m_compiledExpression.evaluate(variableStore));
 }
 
 ModelSpecification ModelDefinition::defaultModelSpecification() const
@@ -170,8 +173,7 @@ vm::vec3d ModelDefinition::scale(
   const el::VariableStore& variableStore,
   const std::optional<el::ExpressionNode>& defaultScaleExpression) const
 {
-  const auto context = el::EvaluationContext{variableStore};
-  const auto value = m_expression.evaluate(context);
+  const auto value = m_compiledExpression.evaluate(variableStore);
 
   switch (value.type())
   {
@@ -192,6 +194,7 @@ vm::vec3d ModelDefinition::scale(
 
   if (defaultScaleExpression)
   {
+    const auto context = el::EvaluationContext{variableStore};
     if (const auto scale = convertToScale(defaultScaleExpression->evaluate(context)))
     {
       return *scale;
@@ -201,6 +204,11 @@ vm::vec3d ModelDefinition::scale(
   return vm::vec3d{1, 1, 1};
 }
 
+const el::ExpressionNode& ModelDefinition::expression() const
+{
+  return m_expression;
+}
+
 kdl_reflect_impl(ModelDefinition);
 
 vm::vec3d safeGetModelScale(
@@ -48,6 +48,7 @@ class ModelDefinition
 {
 private:
   el::ExpressionNode m_expression;
+  el::CompiledExpression m_compiledExpression;
 
 public:
   ModelDefinition();
@@ -89,6 +90,8 @@ public:
     const el::VariableStore& variableStore,
     const std::optional<el::ExpressionNode>& defaultScaleExpression) const;
 
+  const el::ExpressionNode& expression() const;
+
   kdl_reflect_decl(ModelDefinition, m_expression);
 };
 
@@ -380,4 +380,36 @@ std::vector<EntityNode*> filterEntityNodes(const std::vector<Node*>& nodes)
   return result;
 }
 
+size_t computeSizeInBytes(const std::vector<Node*>& nodes)
+{
+  auto result = size_t(0);
+  for (const auto* node : nodes)
+  {
+    node->accept(kdl::overload(
+      [&](auto&& thisLambda, const WorldNode* worldNode) {
+        result += sizeof(WorldNode) + worldNode->entity().sizeInBytes();
+        worldNode->visitChildren(thisLambda);
+      },
+      [&](auto&& thisLambda, const LayerNode* layerNode) {
+        result += sizeof(LayerNode) + layerNode->layer().sizeInBytes();
+        layerNode->visitChildren(thisLambda);
+      },
+      [&](auto&& thisLambda, const GroupNode* groupNode) {
+        result += sizeof(GroupNode) + groupNode->group().sizeInBytes();
+        groupNode->visitChildren(thisLambda);
+      },
+      [&](auto&& thisLambda, const EntityNode* entityNode) {
+        result += sizeof(EntityNode) + entityNode->entity().sizeInBytes();
+        entityNode->visitChildren(thisLambda);
+      },
+      [&](const BrushNode* brushNode) {
+        result += sizeof(BrushNode) + brushNode->brush().sizeInBytes();
+      },
+      [&](const PatchNode* patchNode) {
+        result += sizeof(PatchNode) + patchNode->patch().sizeInBytes();
+      }));
+  }
+  return result;
+}
+
 } // namespace tb::mdl
@@ -80,4 +80,10 @@ vm::bbox3d computePhysicalBounds(
 std::vector<BrushNode*> filterBrushNodes(const std::vector<Node*>& nodes);
 std::vector<EntityNode*> filterEntityNodes(const std::vector<Node*>& nodes);
 
+/**
+ * Returns an estimate of the memory used by the given nodes and their descendants in
+ * bytes.
+ */
+size_t computeSizeInBytes(const std::vector<Node*>& nodes);
+
 } // namespace tb::mdl
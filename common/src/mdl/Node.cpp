@@ -834,9 +834,9 @@ void Node::validateIssues(const std::vector<const Validator*>& validators)
   {
     for (const auto* validator : validators)
     {
-      validator->validate(*this, m_issues);
+      validateIssues(*validator);
     }
-    m_issuesValid = true;
+    markIssuesValid();
   }
 }
 
@@ -846,6 +846,21 @@ void Node::invalidateIssues() const
   m_issuesValid = false;
 }
 
+bool Node::issuesValid() const
+{
+  return m_issuesValid;
+}
+
+void Node::validateIssues(const Validator& validator)
+{
+  validator.validate(*this, m_issues);
+}
+
+void Node::markIssuesValid()
+{
+  m_issuesValid = true;
+}
+
 const EntityPropertyConfig& Node::entityPropertyConfig() const
 {
   return doGetEntityPropertyConfig();
@@ -879,6 +894,16 @@ void Node::removeFromIndex(
   doRemoveFromIndex(node, key, value);
 }
 
+void Node::addToLinkIdIndex(Node* node, const std::string& linkId)
+{
+  doAddToLinkIdIndex(node, linkId);
+}
+
+void Node::removeFromLinkIdIndex(Node* node, const std::string& linkId)
+{
+  doRemoveFromLinkIdIndex(node, linkId);
+}
+
 Node* Node::doCloneRecursively(const vm::bbox3d& worldBounds) const
 {
   auto* clone = Node::clone(worldBounds);
@@ -967,4 +992,20 @@ void Node::doRemoveFromIndex(
   }
 }
 
+void Node::doAddToLinkIdIndex(Node* node, const std::string& linkId)
+{
+  if (m_parent)
+  {
+    m_parent->addToLinkIdIndex(node, linkId);
+  }
+}
+
+void Node::doRemoveFromLinkIdIndex(Node* node, const std::string& linkId)
+{
+  if (m_parent)
+  {
+    m_parent->removeFromLinkIdIndex(node, linkId);
+  }
+}
+
 } // namespace tb::mdl
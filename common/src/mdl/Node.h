@@ -357,6 +357,15 @@ public: // issue management
 public: // should only be called from this and from the world
   void invalidateIssues() const;
 
+  bool issuesValid() const;
+
+  /**
+   * Adds the issues found by the given validator to this node's issues. The issues are
+   * not considered valid until markIssuesValid() is called.
+   */
+  void validateIssues(const Validator& validator);
+  void markIssuesValid();
+
 private:
   void validateIssues(const std::vector<const Validator*>& validators);
 
@@ -502,6 +511,14 @@ protected: // index management
   void removeFromIndex(
     EntityNodeBase* node, const std::string& key, const std::string& value);
 
+  /**
+   * Adds the given node to the link ID index of the world. The index refers to the given
+   * link ID instead of copying it, so it must be the node's own link ID, and the node
+   * must be removed from the index before its link ID changes.
+   */
+  void addToLinkIdIndex(Node* node, const std::string& linkId);
+  void removeFromLinkIdIndex(Node* node, const std::string& linkId);
+
 private: // subclassing interface
   virtual const std::string& doGetName() const = 0;
   virtual const vm::bbox3d& doGetLogicalBounds() const = 0;
@@ -567,6 +584,9 @@ private: // subclassing interface
     EntityNodeBase* node, const std::string& key, const std::string& value);
   virtual void doRemoveFromIndex(
     EntityNodeBase* node, const std::string& key, const std::string& value);
+
+  virtual void doAddToLinkIdIndex(Node* node, const std::string& linkId);
+  virtual void doRemoveFromLinkIdIndex(Node* node, const std::string& linkId);
 };
 
 } // namespace tb::mdl
@@ -55,4 +55,10 @@ std::variant<Layer, Group, Entity, Brush, BezierPatch>& NodeContents::get()
   return m_contents;
 }
 
+size_t NodeContents::sizeInBytes() const
+{
+  return std::visit(
+    [](const auto& contents) { return contents.sizeInBytes(); }, m_contents);
+}
+
 } // namespace tb::mdl
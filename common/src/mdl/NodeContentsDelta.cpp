@@ -0,0 +1,156 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NodeContentsDelta.h"
+
+#include "Ensure.h"
+#include "mdl/BrushNode.h"
+#include "mdl/UVCoordSystem.h"
+
+#include "kdl/overload.h"
+
+#include <algorithm>
+#include <typeinfo>
+
+namespace tb::mdl
+{
+namespace
+{
+
+const Brush* getBrush(const Node& node)
+{
+  const auto* brushNode = dynamic_cast<const BrushNode*>(&node);
+  return brushNode ? &brushNode->brush() : nullptr;
+}
+
+const Brush* getBrush(const NodeContents& contents)
+{
+  return std::get_if<Brush>(&contents.get());
+}
+
+bool hasSameGeometry(const Brush& lhs, const Brush& rhs)
+{
+  return std::ranges::equal(
+           lhs.faces(),
+           rhs.faces(),
+           [](const auto& lhsFace, const auto& rhsFace) {
+             return lhsFace.points() == rhsFace.points();
+           })
+         && lhs.vertexPositions() == rhs.vertexPositions();
+}
+
+bool isSameFace(const BrushFace& lhs, const BrushFace& rhs)
+{
+  // the material references are not compared because they are unset in node contents
+  return lhs.points() == rhs.points() && lhs.attributes() == rhs.attributes()
+         && typeid(lhs.uvCoordSystem()) == typeid(rhs.uvCoordSystem())
+         && lhs.uvCoordSystem() == rhs.uvCoordSystem();
+}
+
+template <typename ChangedFaces>
+std::variant<NodeContents, ChangedFaces> createDelta(
+  NodeContents contents, const Brush* base)
+{
+  auto* brush = std::get_if<Brush>(&contents.get());
+  if (!brush || !base || !hasSameGeometry(*brush, *base))
+  {
+    return contents;
+  }
+
+  auto changedFaces = ChangedFaces{};
+  for (size_t i = 0; i < brush->faceCount(); ++i)
+  {
+    auto& face = brush->face(i);
+    if (!isSameFace(face, base->face(i)))
+    {
+      // the face geometry will be destroyed with the brush
+      face.setGeometry(nullptr);
+      changedFaces.emplace_back(i, std::move(face));
+    }
+  }
+  return changedFaces;
+}
+
+template <typename ChangedFaces>
+NodeContents restoreDelta(
+  std::variant<NodeContents, ChangedFaces> delta, const Brush* base)
+{
+  return std::visit(
+    kdl::overload(
+      [](NodeContents contents) { return contents; },
+      [&](ChangedFaces changedFaces) {
+        ensure(base != nullptr, "base is not a brush");
+
+        auto brush = *base;
+        for (auto& [index, changedFace] : changedFaces)
+        {
+          auto& face = brush.face(index);
+          auto* faceGeometry = face.geometry();
+          face = std::move(changedFace);
+          face.setGeometry(faceGeometry);
+        }
+        return NodeContents{std::move(brush)};
+      }),
+    std::move(delta));
+}
+
+} // namespace
+
+NodeContentsDelta::NodeContentsDelta(NodeContents contents, const Node& base)
+  : m_delta{createDelta<ChangedFaces>(std::move(contents), getBrush(base))}
+{
+}
+
+NodeContentsDelta::NodeContentsDelta(NodeContents contents, const NodeContents& base)
+  : m_delta{createDelta<ChangedFaces>(std::move(contents), getBrush(base))}
+{
+}
+
+bool NodeContentsDelta::storesChangedFacesOnly() const
+{
+  return std::holds_alternative<ChangedFaces>(m_delta);
+}
+
+size_t NodeContentsDelta::sizeInBytes() const
+{
+  return std::visit(
+    kdl::overload(
+      [](const NodeContents& contents) { return contents.sizeInBytes(); },
+      [](const ChangedFaces& changedFaces) {
+        auto result = sizeof(NodeContentsDelta);
+        for (const auto& [index, face] : changedFaces)
+        {
+          result += sizeof(index) + face.sizeInBytes();
+        }
+        return result;
+      }),
+    m_delta);
+}
+
+NodeContents NodeContentsDelta::restore(const Node& base) &&
+{
+  return restoreDelta(std::move(m_delta), getBrush(base));
+}
+
+NodeContents NodeContentsDelta::restore(const NodeContents& base) &&
+{
+  return restoreDelta(std::move(m_delta), getBrush(base));
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,82 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "mdl/BrushFace.h"
+#include "mdl/NodeContents.h"
+
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace tb::mdl
+{
+class Node;
+
+/**
+ * Stores node contents relative to a base, which is either a node or other node contents.
+ *
+ * If the contents and the base are brushes with identical geometry, then only those faces
+ * that differ from the faces of the base are stored. Otherwise, the contents are stored
+ * as they are.
+ *
+ * The contents can only be restored against the base that the delta was created for, or
+ * against a base that is equal to it.
+ */
+class NodeContentsDelta
+{
+private:
+  using ChangedFaces = std::vector<std::pair<size_t, BrushFace>>;
+  std::variant<NodeContents, ChangedFaces> m_delta;
+
+public:
+  /**
+   * Creates a delta of the given contents relative to the current contents of the given
+   * node.
+   */
+  NodeContentsDelta(NodeContents contents, const Node& base);
+
+  /**
+   * Creates a delta of the given contents relative to the given base contents.
+   */
+  NodeContentsDelta(NodeContents contents, const NodeContents& base);
+
+  /**
+   * Indicates whether this delta stores only the changed faces of a brush.
+   */
+  bool storesChangedFacesOnly() const;
+
+  /**
+   * Returns an estimate of the memory used by this delta in bytes.
+   */
+  size_t sizeInBytes() const;
+
+  /**
+   * Restores the contents against the current contents of the given node.
+   */
+  NodeContents restore(const Node& base) &&;
+
+  /**
+   * Restores the contents against the given base contents.
+   */
+  NodeContents restore(const NodeContents& base) &&;
+};
+
+} // namespace tb::mdl
@@ -26,6 +26,8 @@
 #include "mdl/MapFacade.h"
 #include "mdl/Polyhedron.h"
 
+#include <array>
+#include <cmath>
 #include <string>
 
 namespace tb::mdl
@@ -38,6 +40,55 @@ IssueQuickFix makeSnapVerticesQuickFix()
 {
   return {"Snap Vertices", [](auto& facade, const auto&) { facade.snapVertices(1); }};
 }
+
+constexpr auto BatchSize = size_t(32);
+
+/**
+ * Checks the given coordinates without branching on their values so that the compiler
+ * can vectorize the loop. Adding and subtracting 2^52 rounds a value below 2^52 to an
+ * integer, and every value above it is already an integer. This matches
+ * vm::is_integral for all finite values as long as the compiler does not reassociate
+ * floating point operations.
+ */
+bool hasNonIntegerCoordinate(
+  const std::array<double, 3 * BatchSize>& coords, const size_t count)
+{
+  constexpr auto Limit = 0x1p52;
+
+  auto result = false;
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto a = std::abs(coords[i]);
+    const auto rounded = (a + Limit) - Limit;
+    result |= (a < Limit) & (rounded != a);
+  }
+  return result;
+}
+
+bool hasNonIntegerVertices(const Brush& brush)
+{
+  auto coords = std::array<double, 3 * BatchSize>{};
+  auto count = size_t(0);
+
+  for (const auto* vertex : brush.vertices())
+  {
+    const auto& position = vertex->position();
+    coords[count++] = position.x();
+    coords[count++] = position.y();
+    coords[count++] = position.z();
+
+    if (count == coords.size())
+    {
+      if (hasNonIntegerCoordinate(coords, count))
+      {
+        return true;
+      }
+      count = 0;
+    }
+  }
+
+  return hasNonIntegerCoordinate(coords, count);
+}
 } // namespace
 
 NonIntegerVerticesValidator::NonIntegerVerticesValidator()
@@ -49,10 +100,7 @@ NonIntegerVerticesValidator::NonIntegerVerticesValidator()
 void NonIntegerVerticesValidator::doValidate(
   BrushNode& brushNode, std::vector<std::unique_ptr<Issue>>& issues) const
 {
-  const auto& vertices = brushNode.brush().vertices();
-  if (!std::all_of(vertices.begin(), vertices.end(), [](const auto* vertex) {
-        return vm::is_integral(vertex->position());
-      }))
+  if (hasNonIntegerVertices(brushNode.brush()))
   {
     issues.push_back(
       std::make_unique<Issue>(Type, brushNode, "Brush has non-integer vertices"));
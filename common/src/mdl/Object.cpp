@@ -22,6 +22,8 @@
 #include "Uuid.h"
 #include "mdl/GroupNode.h"
 
+#include <utility>
+
 namespace tb::mdl
 {
 
@@ -39,7 +41,12 @@ const std::string& Object::linkId() const
 
 void Object::setLinkId(std::string linkId)
 {
-  m_linkId = std::move(linkId);
+  if (linkId != m_linkId)
+  {
+    doLinkIdWillChange();
+    m_linkId = std::move(linkId);
+    doLinkIdDidChange();
+  }
 }
 
 void Object::cloneLinkId(Object& object) const
@@ -58,6 +58,8 @@ private: // subclassing interface
   virtual Node* doGetContainer() = 0;
   virtual LayerNode* doGetContainingLayer() = 0;
   virtual GroupNode* doGetContainingGroup() = 0;
+  virtual void doLinkIdWillChange() = 0;
+  virtual void doLinkIdDidChange() = 0;
 };
 
 } // namespace tb::mdl
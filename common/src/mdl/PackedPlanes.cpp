@@ -0,0 +1,123 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PackedPlanes.h"
+
+#include "vm/constants.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace tb::mdl
+{
+
+PackedPlanes::PackedPlanes() = default;
+
+PackedPlanes::PackedPlanes(const std::vector<vm::plane3d>& planes)
+{
+  m_normalX.reserve(planes.size());
+  m_normalY.reserve(planes.size());
+  m_normalZ.reserve(planes.size());
+  m_distance.reserve(planes.size());
+
+  for (const auto& plane : planes)
+  {
+    m_normalX.push_back(plane.normal.x());
+    m_normalY.push_back(plane.normal.y());
+    m_normalZ.push_back(plane.normal.z());
+    m_distance.push_back(plane.distance);
+  }
+}
+
+size_t PackedPlanes::size() const
+{
+  return m_distance.size();
+}
+
+std::optional<std::tuple<double, size_t>> PackedPlanes::intersectWithRay(
+  const vm::ray3d& ray) const
+{
+  constexpr auto epsilon = vm::constants<double>::almost_zero();
+  // distances that differ by less than this are considered equal when choosing the plane
+  // through which the ray enters
+  constexpr auto tieEpsilon = 1e-9;
+
+  const auto* normalX = m_normalX.data();
+  const auto* normalY = m_normalY.data();
+  const auto* normalZ = m_normalZ.data();
+  const auto* distance = m_distance.data();
+  const auto count = size();
+
+  const auto originX = ray.origin.x();
+  const auto originY = ray.origin.y();
+  const auto originZ = ray.origin.z();
+  const auto directionX = ray.direction.x();
+  const auto directionY = ray.direction.y();
+  const auto directionZ = ray.direction.z();
+
+  // The ray enters the volume at the farthest plane that it crosses from the outside, and
+  // it leaves the volume at the nearest plane that it crosses from the inside. This loop
+  // has no branches so that the compiler can vectorize it.
+  auto enter = std::numeric_limits<double>::lowest();
+  auto leave = std::numeric_limits<double>::max();
+  auto missesParallelPlane = false;
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto cos =
+      normalX[i] * directionX + normalY[i] * directionY + normalZ[i] * directionZ;
+    const auto originDistance =
+      normalX[i] * originX + normalY[i] * originY + normalZ[i] * originZ - distance[i];
+    const auto t = -originDistance / cos;
+
+    const auto isFront = cos < -epsilon;
+    const auto isBack = cos > epsilon;
+    enter = isFront ? std::max(enter, t) : enter;
+    leave = isBack ? std::min(leave, t) : leave;
+    missesParallelPlane =
+      missesParallelPlane || (!isFront && !isBack && originDistance > 0.0);
+  }
+
+  if (missesParallelPlane || enter < -epsilon || enter > leave + epsilon)
+  {
+    return std::nullopt;
+  }
+
+  // find the plane through which the ray enters the volume, preferring lower indices if
+  // the ray enters through an edge or a vertex
+  auto result = std::optional<std::tuple<double, size_t>>{};
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto cos =
+      normalX[i] * directionX + normalY[i] * directionY + normalZ[i] * directionZ;
+    if (cos < -epsilon)
+    {
+      const auto originDistance =
+        normalX[i] * originX + normalY[i] * originY + normalZ[i] * originZ - distance[i];
+      const auto t = -originDistance / cos;
+      if (!result || t > std::get<0>(*result) + tieEpsilon)
+      {
+        result = std::tuple{t, i};
+      }
+    }
+  }
+
+  return result;
+}
+
+} // namespace tb::mdl
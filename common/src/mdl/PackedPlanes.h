@@ -0,0 +1,67 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "vm/plane.h"
+#include "vm/ray.h"
+
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace tb::mdl
+{
+
+/**
+ * Stores the planes that bound a convex volume such as a brush in separate arrays for
+ * each component, so that a ray can be tested against all planes in one pass.
+ */
+class PackedPlanes
+{
+private:
+  std::vector<double> m_normalX;
+  std::vector<double> m_normalY;
+  std::vector<double> m_normalZ;
+  std::vector<double> m_distance;
+
+public:
+  PackedPlanes();
+  explicit PackedPlanes(const std::vector<vm::plane3d>& planes);
+
+  size_t size() const;
+
+  /**
+   * Finds the plane through which the given ray enters the convex volume bounded by these
+   * planes. The ray does not enter the volume if it misses the volume or if its origin is
+   * inside of it.
+   *
+   * If the ray enters the volume through an edge or a vertex, the plane with the lowest
+   * index among the planes that meet there is returned.
+   *
+   * @param ray the ray to test
+   * @return the distance from the ray origin to the point where the ray enters the volume
+   * and the index of the plane through which it enters, or nullopt if the ray does not
+   * enter the volume
+   */
+  std::optional<std::tuple<double, size_t>> intersectWithRay(const vm::ray3d& ray) const;
+};
+
+} // namespace tb::mdl
@@ -476,6 +476,16 @@ GroupNode* PatchNode::doGetContainingGroup()
   return findContainingGroup(this);
 }
 
+void PatchNode::doLinkIdWillChange()
+{
+  removeFromLinkIdIndex(this, linkId());
+}
+
+void PatchNode::doLinkIdDidChange()
+{
+  addToLinkIdIndex(this, linkId());
+}
+
 void PatchNode::doAcceptTagVisitor(TagVisitor& visitor)
 {
   visitor.visit(*this);
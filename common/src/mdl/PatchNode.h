@@ -119,6 +119,8 @@ private: // implement Object interface
   Node* doGetContainer() override;
   LayerNode* doGetContainingLayer() override;
   GroupNode* doGetContainingGroup() override;
+  void doLinkIdWillChange() override;
+  void doLinkIdDidChange() override;
 
 private: // implement Taggable interface
   void doAcceptTagVisitor(TagVisitor& visitor) override;
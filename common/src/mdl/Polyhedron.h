@@ -28,6 +28,7 @@
 #include "vm/util.h"
 #include "vm/vec.h"
 
+#include <cstddef>
 #include <initializer_list>
 #include <limits>
 #include <optional>
@@ -122,6 +123,12 @@ private:
   explicit Polyhedron_Vertex(const vm::vec<T, 3>& position);
 
 public:
+  /**
+   * Allocates vertices from a block_pool.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr) noexcept;
+
   /**
    * Returns the position of this vertex.
    */
@@ -274,6 +281,12 @@ private:
   explicit Polyhedron_Edge(HalfEdge* first, HalfEdge* second = nullptr);
 
 public:
+  /**
+   * Allocates edges from a block_pool.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr) noexcept;
+
   /**
    * Returns the origin of the first half edge.
    */
@@ -595,6 +608,12 @@ private:
   explicit Polyhedron_HalfEdge(Vertex* origin);
 
 public:
+  /**
+   * Allocates half edges from a block_pool.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr) noexcept;
+
   /**
    * Returns the origin vertex of this half edge.
    */
@@ -826,6 +845,12 @@ private:
   explicit Polyhedron_Face(HalfEdgeList&& boundary, const vm::plane<T, 3>& plane);
 
 public:
+  /**
+   * Allocates faces from a block_pool.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr) noexcept;
+
   /**
    * Returns the circular list of half edges that make up the boundary of this face.
    */
@@ -1581,6 +1606,20 @@ private:
    */
   void updateBounds();
 
+public: // Transformation
+  /**
+   * Applies the given affine transformation to this polyhedron in place.
+   *
+   * The vertex positions and face planes are transformed, and the topology is retained.
+   * If the transformation inverts the orientation, the boundaries of all faces are
+   * reversed so that the face normals still point outward.
+   *
+   * Updates the bounds of this polyhedron afterwards.
+   *
+   * @param transformation the transformation to apply, must be invertible
+   */
+  void transform(const vm::mat<T, 4, 4>& transformation);
+
 public: // Vertex correction and edge healing
   /**
    * Rounds each component of position of every vertex to the nearest integer if the
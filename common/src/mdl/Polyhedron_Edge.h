@@ -21,6 +21,7 @@
 
 #include "Macros.h"
 #include "Polyhedron.h"
+#include "block_pool.h"
 
 #include "vm/distance.h"
 #include "vm/plane.h"
@@ -28,6 +29,9 @@
 #include "vm/segment.h"
 #include "vm/vec.h"
 
+#include <cassert>
+#include <cstddef>
+
 namespace tb::mdl
 {
 
@@ -73,6 +77,20 @@ Polyhedron_Edge<T, FP, VP>::Polyhedron_Edge(HalfEdge* first, HalfEdge* second)
   }
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_Edge<T, FP, VP>::operator new(const std::size_t size)
+{
+  assert(size == sizeof(Polyhedron_Edge));
+  unused(size);
+  return block_pool<sizeof(Polyhedron_Edge), alignof(Polyhedron_Edge)>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_Edge<T, FP, VP>::operator delete(void* ptr) noexcept
+{
+  block_pool<sizeof(Polyhedron_Edge), alignof(Polyhedron_Edge)>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 typename Polyhedron_Edge<T, FP, VP>::Vertex* Polyhedron_Edge<T, FP, VP>::firstVertex()
   const
@@ -21,6 +21,7 @@
 
 #include "Macros.h"
 #include "Polyhedron.h"
+#include "block_pool.h"
 
 #include "kdl/optional_utils.h"
 
@@ -32,6 +33,8 @@
 #include "vm/util.h"
 #include "vm/vec.h"
 
+#include <cassert>
+#include <cstddef>
 #include <unordered_set>
 
 namespace tb::mdl
@@ -77,6 +80,20 @@ Polyhedron_Face<T, FP, VP>::Polyhedron_Face(
   countAndSetFace(m_boundary.front(), m_boundary.back(), this);
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_Face<T, FP, VP>::operator new(const std::size_t size)
+{
+  assert(size == sizeof(Polyhedron_Face));
+  unused(size);
+  return block_pool<sizeof(Polyhedron_Face), alignof(Polyhedron_Face)>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_Face<T, FP, VP>::operator delete(void* ptr) noexcept
+{
+  block_pool<sizeof(Polyhedron_Face), alignof(Polyhedron_Face)>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 const typename Polyhedron_Face<T, FP, VP>::HalfEdgeList& Polyhedron_Face<T, FP, VP>::
   boundary() const
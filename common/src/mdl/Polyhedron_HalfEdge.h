@@ -19,7 +19,12 @@
 
 #pragma once
 
+#include "Macros.h"
 #include "Polyhedron.h"
+#include "block_pool.h"
+
+#include <cassert>
+#include <cstddef>
 
 namespace tb::mdl
 {
@@ -59,6 +64,20 @@ Polyhedron_HalfEdge<T, FP, VP>::Polyhedron_HalfEdge(Vertex* origin)
   setAsLeaving();
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_HalfEdge<T, FP, VP>::operator new(const std::size_t size)
+{
+  assert(size == sizeof(Polyhedron_HalfEdge));
+  unused(size);
+  return block_pool<sizeof(Polyhedron_HalfEdge), alignof(Polyhedron_HalfEdge)>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_HalfEdge<T, FP, VP>::operator delete(void* ptr) noexcept
+{
+  block_pool<sizeof(Polyhedron_HalfEdge), alignof(Polyhedron_HalfEdge)>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 typename Polyhedron_HalfEdge<T, FP, VP>::Vertex* Polyhedron_HalfEdge<T, FP, VP>::origin()
   const
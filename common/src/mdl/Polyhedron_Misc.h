@@ -24,6 +24,8 @@
 #include "kdl/range_utils.h"
 
 #include "vm/bbox.h"
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
 #include "vm/plane.h"
 #include "vm/ray.h"
 #include "vm/scalar.h"
@@ -31,9 +33,11 @@
 #include "vm/vec.h"
 #include "vm/vec_io.h" // IWYU pragma: keep
 
+#include <cassert>
 #include <sstream>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace tb::mdl
 {
@@ -755,6 +759,59 @@ void Polyhedron<T, FP, VP>::updateBounds()
   }
 }
 
+template <typename T, typename FP, typename VP>
+void Polyhedron<T, FP, VP>::transform(const vm::mat<T, 4, 4>& transformation)
+{
+  const auto linearTransformation = vm::strip_translation(transformation);
+  const auto invertedLinearTransformation = vm::invert(linearTransformation);
+  assert(invertedLinearTransformation);
+
+  // normals must be transformed by the inverse transpose to remain perpendicular to the
+  // transformed faces
+  const auto normalTransformation = vm::transpose(*invertedLinearTransformation);
+
+  for (auto* vertex : m_vertices)
+  {
+    vertex->setPosition(transformation * vertex->position());
+  }
+
+  for (auto* face : m_faces)
+  {
+    const auto& plane = face->plane();
+    face->setPlane(vm::plane<T, 3>{
+      transformation * plane.anchor(), vm::normalize(normalTransformation * plane.normal)});
+  }
+
+  if (vm::compute_determinant(linearTransformation) < T(0))
+  {
+    // Reverse every half edge by making its destination its new origin, and reverse the
+    // order of the half edges in every face boundary
+    for (auto* face : m_faces)
+    {
+      auto& boundary = face->boundary();
+
+      auto destinations = std::vector<Vertex*>{};
+      destinations.reserve(boundary.size());
+      for (const auto* halfEdge : boundary)
+      {
+        destinations.push_back(halfEdge->destination());
+      }
+
+      auto it = destinations.begin();
+      for (auto* halfEdge : boundary)
+      {
+        halfEdge->setOrigin(*it++);
+      }
+
+      boundary.reverse();
+    }
+  }
+
+  updateBounds();
+
+  assert(checkInvariant());
+}
+
 template <typename T, typename FP, typename VP>
 void Polyhedron<T, FP, VP>::correctVertexPositions(const size_t decimals, const T epsilon)
 {
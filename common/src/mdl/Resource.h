@@ -275,6 +275,8 @@ public:
       m_state);
   }
 
+  bool isLoading() const { return std::holds_alternative<ResourceLoading<T>>(m_state); }
+  bool isReady() const { return std::holds_alternative<ResourceReady<T>>(m_state); }
   bool isDropped() const { return std::holds_alternative<ResourceDropped>(m_state); }
 
   bool needsProcessing() const
@@ -21,11 +21,12 @@
 
 #include "mdl/Resource.h"
 
-#include "kdl/collection_utils.h"
 #include "kdl/reflection_impl.h"
 #include "kdl/vector_utils.h"
 
+#include <algorithm>
 #include <chrono>
+#include <deque>
 #include <memory>
 #include <vector>
 
@@ -34,6 +35,12 @@ namespace tb::mdl
 
 class ResourceWrapperBase
 {
+private:
+  // whether this resource is in the resource manager's pending queue
+  bool m_pending = false;
+
+  friend class ResourceManager;
+
 public:
   virtual ~ResourceWrapperBase() = default;
 
@@ -41,6 +48,8 @@ public:
 
   virtual long useCount() const = 0;
 
+  virtual bool isLoading() const = 0;
+  virtual bool isReady() const = 0;
   virtual bool isDropped() const = 0;
   virtual bool needsProcessing() const = 0;
 
@@ -64,6 +73,8 @@ public:
 
   const ResourceId& id() const override { return m_resource->id(); }
   long useCount() const override { return m_resource.use_count(); }
+  bool isLoading() const override { return m_resource->isLoading(); }
+  bool isReady() const override { return m_resource->isReady(); }
   bool isDropped() const override { return m_resource->isDropped(); }
   bool needsProcessing() const override { return m_resource->needsProcessing(); }
   void drop() override { m_resource->drop(); }
@@ -81,19 +92,66 @@ public:
   };
 };
 
+struct ResourceCounts
+{
+  // the number of resources waiting to be processed
+  size_t pending = 0;
+  // the number of resources currently being loaded by a task
+  size_t loading = 0;
+  // the number of resources that are loaded and uploaded
+  size_t ready = 0;
+  // the total number of resources that were dropped and removed
+  size_t dropped = 0;
+
+  kdl_reflect_inline(ResourceCounts, pending, loading, ready, dropped);
+};
+
+/**
+ * Manages the lifecycle of resources.
+ *
+ * Resources whose state requires processing are kept in a pending queue, so processing
+ * only visits resources that have work to do. A resource that is no longer referenced
+ * outside of the manager is dropped. Since there is no way to observe the release of a
+ * shared pointer, the manager checks the use counts of a bounded number of resources per
+ * call to process, cycling through all resources over successive calls.
+ *
+ * Once a released resource is found, the manager reports that it needs processing until
+ * it has checked all other resources, because resources are usually released in bulk.
+ */
 class ResourceManager
 {
+public:
+  /**
+   * The maximum number of resources whose use counts are checked per call to process.
+   */
+  static constexpr size_t ReleaseCheckBatchSize = 256;
+
 private:
   std::vector<std::unique_ptr<ResourceWrapperBase>> m_resources;
+  std::deque<ResourceWrapperBase*> m_pending;
+  size_t m_releaseCheckIndex = 0;
+  // the number of release checks that are left until all resources have been checked
+  // since a released resource was found or a release check was requested
+  size_t m_remainingReleaseChecks = 0;
+  ResourceCounts m_counts;
 
 public:
+  /**
+   * Indicates whether there are resources waiting to be processed or whether the release
+   * checks are not yet complete. This does not check the use counts of the resources, so
+   * a resource that was just released is noticed by the next calls to process.
+   */
   bool needsProcessing() const
   {
-    return kdl::any_of(m_resources, [](const auto& resourceWrapper) {
-      return resourceWrapper->useCount() == 1 || resourceWrapper->needsProcessing();
-    });
+    return !m_pending.empty() || m_remainingReleaseChecks > 0;
   }
 
+  /**
+   * Makes the following calls to process check the use counts of all resources, and
+   * needsProcessing return true until they have done so.
+   */
+  void requestReleaseCheck() { m_remainingReleaseChecks = m_resources.size(); }
+
   std::vector<const ResourceWrapperBase*> resources() const
   {
     return kdl::vec_transform(m_resources, [](const auto& resourceWrapper) {
@@ -101,11 +159,21 @@ public:
     });
   }
 
+  ResourceCounts counts() const
+  {
+    auto result = m_counts;
+    result.pending = m_pending.size();
+    return result;
+  }
+
   template <typename ResourceT>
   void addResource(std::shared_ptr<Resource<ResourceT>> resource)
   {
-    m_resources.push_back(
+    auto& resourceWrapper = *m_resources.emplace_back(
       std::make_unique<ResourceWrapper<ResourceT>>(std::move(resource)));
+
+    updateCounts(resourceWrapper, ResourceCounts{});
+    enqueueIfNeedsProcessing(resourceWrapper);
   }
 
   std::vector<ResourceId> process(
@@ -121,30 +189,100 @@ public:
               : std::function{[]() { return true; }};
 
     auto result = std::vector<ResourceId>{};
+    auto needsRemoval = false;
 
-    for (auto it = m_resources.begin(); it != m_resources.end() && checkTimeout();)
+    const auto releaseCheckCount = std::min(ReleaseCheckBatchSize, m_resources.size());
+    for (size_t i = 0; i < releaseCheckCount && checkTimeout(); ++i)
     {
-      auto& resourceWrapper = *it;
-      if (resourceWrapper->useCount() == 1 && !resourceWrapper->isDropped())
+      if (m_releaseCheckIndex >= m_resources.size())
       {
-        resourceWrapper->drop();
+        m_releaseCheckIndex = 0;
       }
 
-      if (resourceWrapper->needsProcessing())
+      if (m_remainingReleaseChecks > 0)
       {
-        if (resourceWrapper->process(taskRunner, processContext))
+        --m_remainingReleaseChecks;
+      }
+
+      auto& resourceWrapper = *m_resources[m_releaseCheckIndex++];
+      if (resourceWrapper.useCount() == 1 && !resourceWrapper.isDropped())
+      {
+        m_remainingReleaseChecks = m_resources.size() - 1;
+
+        const auto previousCounts = countsOf(resourceWrapper);
+        resourceWrapper.drop();
+        updateCounts(resourceWrapper, previousCounts);
+
+        enqueueIfNeedsProcessing(resourceWrapper);
+        needsRemoval |= !resourceWrapper.m_pending;
+      }
+    }
+
+    const auto pendingCount = m_pending.size();
+    for (size_t i = 0; i < pendingCount && checkTimeout(); ++i)
+    {
+      auto& resourceWrapper = *m_pending.front();
+      m_pending.pop_front();
+      resourceWrapper.m_pending = false;
+
+      if (!resourceWrapper.isDropped() && resourceWrapper.needsProcessing())
+      {
+        const auto previousCounts = countsOf(resourceWrapper);
+        if (resourceWrapper.process(taskRunner, processContext))
         {
-          result.push_back(resourceWrapper->id());
+          result.push_back(resourceWrapper.id());
         }
+        updateCounts(resourceWrapper, previousCounts);
       }
 
-      it = resourceWrapper->useCount() == 1 && resourceWrapper->isDropped()
-             ? m_resources.erase(it)
-             : std::next(it);
+      enqueueIfNeedsProcessing(resourceWrapper);
+      needsRemoval |= !resourceWrapper.m_pending && resourceWrapper.isDropped();
+    }
+
+    if (needsRemoval)
+    {
+      const auto removedCount =
+        std::erase_if(m_resources, [](const auto& resourceWrapper) {
+          return !resourceWrapper->m_pending && resourceWrapper->isDropped()
+                 && resourceWrapper->useCount() == 1;
+        });
+      m_counts.dropped += removedCount;
+      m_remainingReleaseChecks = std::min(m_remainingReleaseChecks, m_resources.size());
     }
 
     return result;
   }
+
+private:
+  static ResourceCounts countsOf(const ResourceWrapperBase& resourceWrapper)
+  {
+    return ResourceCounts{
+      0,
+      resourceWrapper.isLoading() ? 1u : 0u,
+      resourceWrapper.isReady() ? 1u : 0u,
+      0,
+    };
+  }
+
+  void updateCounts(
+    const ResourceWrapperBase& resourceWrapper, const ResourceCounts& previousCounts)
+  {
+    const auto currentCounts = countsOf(resourceWrapper);
+    m_counts.loading = m_counts.loading + currentCounts.loading - previousCounts.loading;
+    m_counts.ready = m_counts.ready + currentCounts.ready - previousCounts.ready;
+  }
+
+  void enqueueIfNeedsProcessing(ResourceWrapperBase& resourceWrapper)
+  {
+    // dropped resources are removed instead of being processed
+    if (
+      !resourceWrapper.m_pending && !resourceWrapper.isDropped()
+      && resourceWrapper.needsProcessing())
+    {
+      resourceWrapper.m_pending = true;
+      m_pending.push_back(&resourceWrapper);
+    }
+  }
 };
 
 } // namespace tb::mdl
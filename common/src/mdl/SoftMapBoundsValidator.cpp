@@ -67,6 +67,18 @@ SoftMapBoundsValidator::SoftMapBoundsValidator(
   addQuickFix(makeDeleteNodesQuickFix());
 }
 
+std::optional<std::vector<Node*>> SoftMapBoundsValidator::doFindCandidates(
+  const WorldNode& worldNode) const
+{
+  if (const auto game = m_game.lock())
+  {
+    const auto bounds = game->extractSoftMapBounds(m_world.entity());
+    return bounds.bounds ? worldNode.findNodesNotContainedIn(*bounds.bounds)
+                         : std::vector<Node*>{};
+  }
+  return std::nullopt;
+}
+
 void SoftMapBoundsValidator::doValidate(
   EntityNode& entityNode, std::vector<std::unique_ptr<Issue>>& issues) const
 {
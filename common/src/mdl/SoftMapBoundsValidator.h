@@ -22,6 +22,7 @@
 #include "mdl/Validator.h"
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace tb::mdl
@@ -40,6 +41,9 @@ public:
   explicit SoftMapBoundsValidator(std::weak_ptr<Game> game, const WorldNode& world);
 
 private:
+  std::optional<std::vector<Node*>> doFindCandidates(
+    const WorldNode& worldNode) const override;
+
   void doValidate(
     EntityNode& entityNode, std::vector<std::unique_ptr<Issue>>& issues) const override;
   void doValidate(
@@ -62,6 +62,12 @@ void Validator::validate(Node& node, std::vector<std::unique_ptr<Issue>>& issues
     [&](PatchNode* patchNode) { doValidate(*patchNode, issues); }));
 }
 
+std::optional<std::vector<Node*>> Validator::findCandidates(
+  const WorldNode& worldNode) const
+{
+  return doFindCandidates(worldNode);
+}
+
 Validator::Validator(const IssueType type, std::string description)
   : m_type{type}
   , m_description{std::move(description)}
@@ -73,6 +79,11 @@ void Validator::addQuickFix(IssueQuickFix quickFix)
   m_quickFixes.push_back(std::move(quickFix));
 }
 
+std::optional<std::vector<Node*>> Validator::doFindCandidates(const WorldNode&) const
+{
+  return std::nullopt;
+}
+
 void Validator::doValidate(
   WorldNode& worldNode, std::vector<std::unique_ptr<Issue>>& issues) const
 {
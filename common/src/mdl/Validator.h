@@ -22,7 +22,9 @@
 #include "mdl/IssueQuickFix.h"
 #include "mdl/IssueType.h"
 
+#include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -38,6 +40,16 @@ class Node;
 class PatchNode;
 class WorldNode;
 
+/**
+ * The time spent by a validator during a validation pass.
+ */
+struct ValidationTime
+{
+  IssueType type;
+  std::string description;
+  std::chrono::nanoseconds time;
+};
+
 class Validator
 {
 private:
@@ -54,11 +66,24 @@ public:
 
   void validate(Node& node, std::vector<std::unique_ptr<Issue>>& issues) const;
 
+  /**
+   * Returns the nodes of the given world that this validator may find issues for, or
+   * nullopt if every node must be validated.
+   *
+   * This allows a validator to rule out many nodes at once, e.g. by querying the world's
+   * node tree, when all nodes of a world are validated. Any node that is not returned
+   * must not have any issues of this validator's type.
+   */
+  std::optional<std::vector<Node*>> findCandidates(const WorldNode& worldNode) const;
+
 protected:
   Validator(IssueType type, std::string description);
   void addQuickFix(IssueQuickFix quickFix);
 
 private:
+  virtual std::optional<std::vector<Node*>> doFindCandidates(
+    const WorldNode& worldNode) const;
+
   virtual void doValidate(
     WorldNode& worldNode, std::vector<std::unique_ptr<Issue>>& issues) const;
   virtual void doValidate(
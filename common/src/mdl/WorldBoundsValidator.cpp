@@ -25,6 +25,7 @@
 #include "mdl/IssueQuickFix.h"
 #include "mdl/MapFacade.h"
 #include "mdl/PatchNode.h"
+#include "mdl/WorldNode.h"
 
 #include <string>
 
@@ -52,6 +53,12 @@ WorldBoundsValidator::WorldBoundsValidator(const vm::bbox3d& bounds)
   addQuickFix(makeDeleteNodesQuickFix());
 }
 
+std::optional<std::vector<Node*>> WorldBoundsValidator::doFindCandidates(
+  const WorldNode& worldNode) const
+{
+  return worldNode.findNodesNotContainedIn(m_bounds);
+}
+
 void WorldBoundsValidator::doValidate(
   EntityNode& entityNode, std::vector<std::unique_ptr<Issue>>& issues) const
 {
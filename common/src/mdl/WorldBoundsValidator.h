@@ -23,6 +23,7 @@
 
 #include "vm/bbox.h"
 
+#include <optional>
 #include <vector>
 
 namespace tb::mdl
@@ -37,6 +38,9 @@ public:
   explicit WorldBoundsValidator(const vm::bbox3d& bounds);
 
 private:
+  std::optional<std::vector<Node*>> doFindCandidates(
+    const WorldNode& worldNode) const override;
+
   void doValidate(
     EntityNode& entityNode, std::vector<std::unique_ptr<Issue>>& issues) const override;
   void doValidate(
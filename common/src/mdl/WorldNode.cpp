@@ -20,25 +20,34 @@
 #include "WorldNode.h"
 
 #include "Ensure.h"
+#include "flat_octree.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
 #include "mdl/EntityNode.h"
 #include "mdl/EntityNodeIndex.h"
 #include "mdl/GroupNode.h"
 #include "mdl/LayerNode.h"
+#include "mdl/Object.h"
 #include "mdl/PatchNode.h"
 #include "mdl/TagVisitor.h"
 #include "mdl/Validator.h"
 #include "mdl/ValidatorRegistry.h"
-#include "octree.h"
 
 #include "kdl/overload.h"
+#include "kdl/task_manager.h"
 #include "kdl/vector_utils.h"
 
 #include "vm/bbox_io.h" // IWYU pragma: keep
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <ranges>
 #include <sstream>
 #include <string>
+#include <variant>
+#include <utility>
 #include <vector>
 
 namespace tb::mdl
@@ -86,6 +95,25 @@ const WorldNode::NodeTree& WorldNode::nodeTree() const
   return *m_nodeTree;
 }
 
+std::vector<Node*> WorldNode::findNodesNotContainedIn(const vm::bbox3d& bounds) const
+{
+  auto result = std::vector<Node*>{};
+  m_nodeTree->visit_non_containees(bounds, [&](Node* node) {
+    if (!bounds.contains(node->logicalBounds()))
+    {
+      result.push_back(node);
+
+      // brush entities are not stored in the node tree, but their bounds contain the
+      // bounds of their children
+      if (auto* entityNode = dynamic_cast<EntityNode*>(node->parent()))
+      {
+        result.push_back(entityNode);
+      }
+    }
+  });
+  return kdl::vec_sort_and_remove_duplicates(std::move(result));
+}
+
 LayerNode* WorldNode::defaultLayer()
 {
   ensure(m_defaultLayer != nullptr, "defaultLayer is null");
@@ -181,6 +209,21 @@ const EntityNodeIndex& WorldNode::entityNodeIndex() const
   return *m_entityNodeIndex;
 }
 
+std::vector<Node*> WorldNode::findNodesWithLinkId(const std::string& linkId) const
+{
+  const auto it = m_linkIdIndex.find(linkId);
+  if (it == m_linkIdIndex.end())
+  {
+    return {};
+  }
+
+  return std::visit(
+    kdl::overload(
+      [](Node* node) { return std::vector<Node*>{node}; },
+      [](const std::unique_ptr<std::vector<Node*>>& nodes) { return *nodes; }),
+    it->second);
+}
+
 std::vector<const Validator*> WorldNode::registeredValidators() const
 {
   return m_validatorRegistry->registeredValidators();
@@ -203,6 +246,111 @@ void WorldNode::unregisterAllValidators()
   invalidateAllIssues();
 }
 
+std::vector<ValidationTime> WorldNode::validateAllIssues(kdl::task_manager& taskManager)
+{
+  using Clock = std::chrono::steady_clock;
+  constexpr auto ChunkSize = size_t(256);
+
+  const auto validators = registeredValidators();
+
+  auto nodes = std::vector<Node*>{};
+  auto patchNodes = std::vector<Node*>{};
+  accept([&](auto&& thisLambda, Node* node) {
+    if (!node->issuesValid())
+    {
+      nodes.push_back(node);
+      if (dynamic_cast<PatchNode*>(node))
+      {
+        patchNodes.push_back(node);
+      }
+    }
+    node->visitChildren(thisLambda);
+  });
+
+  auto result = kdl::vec_transform(validators, [](const auto* validator) {
+    return ValidationTime{
+      validator->type(), validator->description(), std::chrono::nanoseconds{0}};
+  });
+
+  const auto validateChunks = [&](const auto& nodesToValidate, const auto& validate) {
+    const auto chunkCount = (nodesToValidate.size() + ChunkSize - 1) / ChunkSize;
+    auto tasks =
+      std::views::iota(size_t(0), chunkCount) | std::views::transform([&](const auto i) {
+        return std::function{[&, i]() {
+          const auto first =
+            std::next(nodesToValidate.begin(), std::ptrdiff_t(i * ChunkSize));
+          const auto last = std::next(
+            nodesToValidate.begin(),
+            std::ptrdiff_t(std::min((i + 1) * ChunkSize, nodesToValidate.size())));
+          return validate(first, last);
+        }};
+      });
+    return taskManager.run_tasks_and_wait(std::move(tasks));
+  };
+
+  // Validators that can rule out nodes using the node tree only validate their
+  // candidates. The node tree is out of date while its updates are disabled. It stores
+  // patches by their physical bounds, so all patches are validated, too.
+  auto chunkValidators = std::vector<const Validator*>{};
+  auto chunkValidatorIndices = std::vector<size_t>{};
+  for (size_t i = 0; i < validators.size(); ++i)
+  {
+    const auto* validator = validators[i];
+
+    const auto start = Clock::now();
+    auto candidates = m_updateNodeTree ? validator->findCandidates(*this) : std::nullopt;
+    if (!candidates)
+    {
+      chunkValidators.push_back(validator);
+      chunkValidatorIndices.push_back(i);
+      continue;
+    }
+
+    std::erase_if(*candidates, [](const auto* node) {
+      return node->issuesValid() || dynamic_cast<const PatchNode*>(node);
+    });
+    candidates = kdl::vec_concat(std::move(*candidates), patchNodes);
+    result[i].time +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+
+    for (const auto& time : validateChunks(*candidates, [&](auto first, auto last) {
+           const auto chunkStart = Clock::now();
+           std::for_each(
+             first, last, [&](auto* node) { node->validateIssues(*validator); });
+           return Clock::now() - chunkStart;
+         }))
+    {
+      result[i].time += std::chrono::duration_cast<std::chrono::nanoseconds>(time);
+    }
+  }
+
+  // Each chunk runs one validator after the other over all of its nodes so that the time
+  // per validator can be measured without reading the clock for every node.
+  for (const auto& times : validateChunks(nodes, [&](auto first, auto last) {
+         auto times = std::vector<Clock::duration>{};
+         times.reserve(chunkValidators.size());
+         for (const auto* validator : chunkValidators)
+         {
+           const auto start = Clock::now();
+           std::for_each(
+             first, last, [&](auto* node) { node->validateIssues(*validator); });
+           times.push_back(Clock::now() - start);
+         }
+
+         std::for_each(first, last, [](auto* node) { node->markIssuesValid(); });
+         return times;
+       }))
+  {
+    for (size_t i = 0; i < times.size(); ++i)
+    {
+      result[chunkValidatorIndices[i]].time +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(times[i]);
+    }
+  }
+
+  return result;
+}
+
 void WorldNode::disableNodeTreeUpdates()
 {
   m_updateNodeTree = false;
@@ -215,11 +363,11 @@ void WorldNode::enableNodeTreeUpdates()
 
 void WorldNode::rebuildNodeTree()
 {
-  auto nodes = std::vector<mdl::Node*>{};
+  auto nodes = std::vector<std::pair<vm::bbox3d, Node*>>{};
   const auto addNode = [&](auto* node) {
     if (node->shouldAddToSpacialIndex())
     {
-      nodes.push_back(node);
+      nodes.emplace_back(node->physicalBounds(), node);
     }
   };
 
@@ -243,10 +391,35 @@ void WorldNode::rebuildNodeTree()
     [&](BrushNode* brush) { addNode(brush); },
     [&](PatchNode* patch) { addNode(patch); }));
 
-  m_nodeTree->clear();
-  for (auto* node : nodes)
+  m_nodeTree->build(nodes);
+}
+
+void WorldNode::deferNodeTreeUpdates()
+{
+  m_deferNodeTreeUpdates = true;
+}
+
+void WorldNode::applyDeferredNodeTreeUpdates()
+{
+  m_deferNodeTreeUpdates = false;
+  flushDeferredNodeTreeUpdates();
+}
+
+void WorldNode::flushDeferredNodeTreeUpdates()
+{
+  if (!m_deferredNodeTreeUpdates.empty())
   {
-    m_nodeTree->insert(node->physicalBounds(), node);
+    // a node is reported once for every change of its own or its children's bounds
+    auto nodes =
+      kdl::vec_sort_and_remove_duplicates(std::move(m_deferredNodeTreeUpdates));
+    m_deferredNodeTreeUpdates.clear();
+
+    if (m_updateNodeTree)
+    {
+      m_nodeTree->update(kdl::vec_transform(nodes, [](auto* node) {
+        return std::pair{node->physicalBounds(), node};
+      }));
+    }
   }
 }
 
@@ -346,6 +519,7 @@ void WorldNode::doDescendantWasAdded(Node* node, const size_t /* depth */)
   // In some cases, (e.g. if `node` is a Group), `node` will not be added to the spatial
   // index, but some of its descendants may be. We need to recursively search the `node`
   // being connected and add it or any descendants that need to be added.
+  flushDeferredNodeTreeUpdates();
   if (m_updateNodeTree)
   {
     node->accept(kdl::overload(
@@ -390,10 +564,25 @@ void WorldNode::doDescendantWasAdded(Node* node, const size_t /* depth */)
     [&](EntityNode*) {},
     [&](BrushNode*) {},
     [&](PatchNode*) {}));
+
+  node->accept(kdl::overload(
+    [&](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
+    [&](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
+    [&](auto&& thisLambda, GroupNode* group) {
+      addToLinkIdIndex(group, group->linkId());
+      group->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, EntityNode* entity) {
+      addToLinkIdIndex(entity, entity->linkId());
+      entity->visitChildren(thisLambda);
+    },
+    [&](BrushNode* brush) { addToLinkIdIndex(brush, brush->linkId()); },
+    [&](PatchNode* patch) { addToLinkIdIndex(patch, patch->linkId()); }));
 }
 
 void WorldNode::doDescendantWillBeRemoved(Node* node, const size_t /* depth */)
 {
+  flushDeferredNodeTreeUpdates();
   if (m_updateNodeTree)
   {
     const auto doRemove = [&](auto* nodeToRemove) {
@@ -417,11 +606,35 @@ void WorldNode::doDescendantWillBeRemoved(Node* node, const size_t /* depth */)
       [&](BrushNode* brush) { doRemove(brush); },
       [&](PatchNode* patch) { doRemove(patch); }));
   }
+
+  node->accept(kdl::overload(
+    [&](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
+    [&](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
+    [&](auto&& thisLambda, GroupNode* group) {
+      removeFromLinkIdIndex(group, group->linkId());
+      group->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, EntityNode* entity) {
+      removeFromLinkIdIndex(entity, entity->linkId());
+      entity->visitChildren(thisLambda);
+    },
+    [&](BrushNode* brush) { removeFromLinkIdIndex(brush, brush->linkId()); },
+    [&](PatchNode* patch) { removeFromLinkIdIndex(patch, patch->linkId()); }));
 }
 
 void WorldNode::doDescendantPhysicalBoundsDidChange(Node* node)
 {
-  if (m_updateNodeTree)
+  if (m_updateNodeTree && m_deferNodeTreeUpdates)
+  {
+    node->accept(kdl::overload(
+      [](WorldNode*) {},
+      [](LayerNode*) {},
+      [](GroupNode*) {},
+      [&](EntityNode* entity) { m_deferredNodeTreeUpdates.push_back(entity); },
+      [&](BrushNode* brush) { m_deferredNodeTreeUpdates.push_back(brush); },
+      [&](PatchNode* patch) { m_deferredNodeTreeUpdates.push_back(patch); }));
+  }
+  else if (m_updateNodeTree)
   {
     node->accept(kdl::overload(
       [](WorldNode*) {},
@@ -441,18 +654,14 @@ bool WorldNode::doSelectable() const
 void WorldNode::doPick(
   const EditorContext& editorContext, const vm::ray3d& ray, PickResult& pickResult)
 {
-  for (auto* node : m_nodeTree->find_intersectors(ray))
-  {
-    node->pick(editorContext, ray, pickResult);
-  }
+  m_nodeTree->visit_intersectors(
+    ray, [&](Node* node) { node->pick(editorContext, ray, pickResult); });
 }
 
 void WorldNode::doFindNodesContaining(const vm::vec3d& point, std::vector<Node*>& result)
 {
-  for (auto* node : m_nodeTree->find_containers(point))
-  {
-    node->findNodesContaining(point, result);
-  }
+  m_nodeTree->visit_containers(
+    point, [&](Node* node) { node->findNodesContaining(point, result); });
 }
 
 void WorldNode::doAccept(NodeVisitor& visitor)
@@ -502,6 +711,68 @@ void WorldNode::doRemoveFromIndex(
   m_entityNodeIndex->removeProperty(node, key, value);
 }
 
+namespace
+{
+
+const std::string& getLinkId(const Node& node)
+{
+  return dynamic_cast<const Object&>(node).linkId();
+}
+
+} // namespace
+
+void WorldNode::doAddToLinkIdIndex(Node* node, const std::string& linkId)
+{
+  const auto [it, inserted] = m_linkIdIndex.try_emplace(linkId, node);
+  if (!inserted)
+  {
+    if (auto* firstNode = std::get_if<Node*>(&it->second))
+    {
+      it->second = std::make_unique<std::vector<Node*>>(std::vector{*firstNode, node});
+    }
+    else
+    {
+      std::get<std::unique_ptr<std::vector<Node*>>>(it->second)->push_back(node);
+    }
+  }
+}
+
+void WorldNode::doRemoveFromLinkIdIndex(Node* node, const std::string& linkId)
+{
+  const auto it = m_linkIdIndex.find(linkId);
+  if (it == m_linkIdIndex.end())
+  {
+    return;
+  }
+
+  if (std::holds_alternative<Node*>(it->second))
+  {
+    if (std::get<Node*>(it->second) == node)
+    {
+      m_linkIdIndex.erase(it);
+    }
+    return;
+  }
+
+  auto& nodes = *std::get<std::unique_ptr<std::vector<Node*>>>(it->second);
+  std::erase(nodes, node);
+
+  auto* firstNode = nodes.front();
+  if (nodes.size() == 1)
+  {
+    it->second = firstNode;
+  }
+
+  if (it->first.data() == linkId.data())
+  {
+    // the key refers to the link ID of the removed node, so it must refer to the link ID
+    // of a remaining node instead
+    auto entry = m_linkIdIndex.extract(it);
+    entry.key() = getLinkId(*firstNode);
+    m_linkIdIndex.insert(std::move(entry));
+  }
+}
+
 void WorldNode::doPropertiesDidChange(const vm::bbox3d& /* oldBounds */) {}
 
 vm::vec3d WorldNode::doGetLinkSourceAnchor() const
@@ -524,4 +795,15 @@ void WorldNode::doAcceptTagVisitor(ConstTagVisitor& visitor) const
   visitor.visit(*this);
 }
 
+DeferNodeTreeUpdates::DeferNodeTreeUpdates(WorldNode& worldNode)
+  : m_worldNode{worldNode}
+{
+  m_worldNode.deferNodeTreeUpdates();
+}
+
+DeferNodeTreeUpdates::~DeferNodeTreeUpdates()
+{
+  m_worldNode.applyDeferredNodeTreeUpdates();
+}
+
 } // namespace tb::mdl
@@ -20,17 +20,25 @@
 #pragma once
 
 #include "Macros.h"
+#include "flat_octree.h"
 #include "mdl/EntityNodeBase.h"
 #include "mdl/EntityProperties.h"
 #include "mdl/IdType.h"
 #include "mdl/MapFormat.h"
 #include "mdl/Node.h"
-#include "octree.h"
 
 #include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
 #include <vector>
 
+namespace kdl
+{
+class task_manager;
+}
+
 namespace tb::mdl
 {
 class EntityNodeIndex;
@@ -39,6 +47,7 @@ enum class MapFormat;
 class PickResult;
 class Validator;
 class ValidatorRegistry;
+struct ValidationTime;
 
 class WorldNode : public EntityNodeBase
 {
@@ -47,11 +56,19 @@ private:
   MapFormat m_mapFormat;
   LayerNode* m_defaultLayer;
   std::unique_ptr<EntityNodeIndex> m_entityNodeIndex;
+
+  // Most link IDs belong to a single node, which is stored inline. The keys refer to the
+  // link ID of the first node in their entry.
+  using LinkIdIndexEntry = std::variant<Node*, std::unique_ptr<std::vector<Node*>>>;
+  std::unordered_map<std::string_view, LinkIdIndexEntry> m_linkIdIndex;
+
   std::unique_ptr<ValidatorRegistry> m_validatorRegistry;
 
-  using NodeTree = octree<double, Node*>;
+  using NodeTree = flat_octree<double, Node*>;
   std::unique_ptr<NodeTree> m_nodeTree;
   bool m_updateNodeTree;
+  bool m_deferNodeTreeUpdates = false;
+  std::vector<Node*> m_deferredNodeTreeUpdates;
 
   IdType m_nextPersistentId = 1;
 
@@ -71,6 +88,17 @@ public:
 
   const NodeTree& nodeTree() const;
 
+  /**
+   * Returns the entities, brushes and patches whose logical bounds are not contained in
+   * the given bounds. The node tree is used to skip every region that is contained in
+   * the given bounds. The result is sorted and does not contain duplicates.
+   *
+   * Since the node tree stores patches by their physical bounds, which can be smaller
+   * than their logical bounds, patches whose logical bounds are not contained in the
+   * given bounds may be missing from the result.
+   */
+  std::vector<Node*> findNodesNotContainedIn(const vm::bbox3d& bounds) const;
+
 public: // layer management
   LayerNode* defaultLayer();
 
@@ -124,18 +152,43 @@ private:
 public: // index
   const EntityNodeIndex& entityNodeIndex() const;
 
+  /**
+   * Returns the groups, entities, brushes and patches in this world that have the given
+   * link ID. The nodes are looked up in an index that is kept up to date when nodes are
+   * added or removed and when their link IDs change.
+   */
+  std::vector<Node*> findNodesWithLinkId(const std::string& linkId) const;
+
 public: // validator registration
   std::vector<const Validator*> registeredValidators() const;
   std::vector<const IssueQuickFix*> quickFixes(IssueType issueTypes) const;
   void registerValidator(std::unique_ptr<Validator> validator);
   void unregisterAllValidators();
 
+  /**
+   * Validates every node in this world whose issues are not valid with the registered
+   * validators. The nodes are validated in parallel using the given task manager; nodes
+   * whose issues are still valid are skipped.
+   *
+   * Returns the time spent by each registered validator, in registration order.
+   */
+  std::vector<ValidationTime> validateAllIssues(kdl::task_manager& taskManager);
+
 public: // node tree bulk updating
   void disableNodeTreeUpdates();
   void enableNodeTreeUpdates();
   void rebuildNodeTree();
 
+  /**
+   * Collects the nodes whose physical bounds change instead of updating them in the node
+   * tree one at a time. The collected nodes are updated in one batch when
+   * applyDeferredNodeTreeUpdates is called, or before any node is added or removed.
+   */
+  void deferNodeTreeUpdates();
+  void applyDeferredNodeTreeUpdates();
+
 private:
+  void flushDeferredNodeTreeUpdates();
   void invalidateAllIssues();
 
 private: // implement Node interface
@@ -174,6 +227,8 @@ private: // implement Node interface
     EntityNodeBase* node, const std::string& key, const std::string& value) override;
   void doRemoveFromIndex(
     EntityNodeBase* node, const std::string& key, const std::string& value) override;
+  void doAddToLinkIdIndex(Node* node, const std::string& linkId) override;
+  void doRemoveFromLinkIdIndex(Node* node, const std::string& linkId) override;
 
 private: // implement EntityNodeBase interface
   void doPropertiesDidChange(const vm::bbox3d& oldBounds) override;
@@ -188,4 +243,20 @@ private:
   deleteCopyAndMove(WorldNode);
 };
 
+/**
+ * Defers the node tree updates of a world while this object is alive. The deferred
+ * updates are applied when this object is destroyed, also if an exception is thrown.
+ */
+class DeferNodeTreeUpdates
+{
+private:
+  WorldNode& m_worldNode;
+
+public:
+  explicit DeferNodeTreeUpdates(WorldNode& worldNode);
+  ~DeferNodeTreeUpdates();
+
+  deleteCopyAndMove(DeferNodeTreeUpdates);
+};
+
 } // namespace tb::mdl
@@ -184,8 +184,7 @@ void BrushRenderer::invalidate()
   m_invalidBrushes = m_allBrushes;
 
   assert(m_brushInfo.empty());
-  assert(m_transparentFaces->empty());
-  assert(m_opaqueFaces->empty());
+  assert(m_cells.empty());
 }
 
 void BrushRenderer::invalidateMaterials(
@@ -234,14 +233,8 @@ void BrushRenderer::clear()
   m_invalidBrushes.clear();
 
   m_vertexArray = std::make_shared<BrushVertexArray>();
-  m_edgeIndices = std::make_shared<BrushIndexArray>();
-  m_transparentFaces = std::make_shared<MaterialToBrushIndicesMap>();
-  m_opaqueFaces = std::make_shared<MaterialToBrushIndicesMap>();
-
-  m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
-  m_transparentFaceRenderer =
-    FaceRenderer{m_vertexArray, m_transparentFaces, m_faceColor};
-  m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
+  m_cells.clear();
+  m_visibleCells.clear();
 }
 
 void BrushRenderer::setFaceColor(const Color& faceColor)
@@ -325,13 +318,21 @@ void BrushRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& rend
     {
       validate();
     }
+
+    const auto& cells = visibleCells(renderContext.camera()).cells;
     if (renderContext.showFaces())
     {
-      renderOpaqueFaces(renderBatch);
+      for (auto* cell : cells)
+      {
+        renderOpaqueFaces(*cell, renderBatch);
+      }
     }
     if (renderContext.showEdges() || m_showEdges)
     {
-      renderEdges(renderBatch);
+      for (auto* cell : cells)
+      {
+        renderEdges(*cell, renderBatch);
+      }
     }
   }
 }
@@ -347,35 +348,75 @@ void BrushRenderer::renderTransparent(
     }
     if (renderContext.showFaces())
     {
-      renderTransparentFaces(renderBatch);
+      for (auto* cell : visibleCells(renderContext.camera()).cells)
+      {
+        renderTransparentFaces(*cell, renderBatch);
+      }
+    }
+  }
+}
+
+const CullingStats& BrushRenderer::cullingStats(const Camera& camera)
+{
+  if (!valid())
+  {
+    validate();
+  }
+  return visibleCells(camera).stats;
+}
+
+const BrushRenderer::VisibleCells& BrushRenderer::visibleCells(const Camera& camera)
+{
+  const auto frustum = ViewFrustum{camera};
+  if (const auto it = m_visibleCells.find(&camera);
+      it != m_visibleCells.end() && it->second.frustum == frustum)
+  {
+    return it->second;
+  }
+
+  auto result = VisibleCells{frustum, {}, {}};
+  result.cells.reserve(m_cells.size());
+
+  for (auto& [key, cell] : m_cells)
+  {
+    if (frustum.intersects(cell.bounds))
+    {
+      result.cells.push_back(&cell);
+      result.stats.drawn += cell.brushCount;
+    }
+    else
+    {
+      result.stats.culled += cell.brushCount;
     }
   }
+
+  return m_visibleCells.insert_or_assign(&camera, std::move(result)).first->second;
 }
 
-void BrushRenderer::renderOpaqueFaces(RenderBatch& renderBatch)
+void BrushRenderer::renderOpaqueFaces(Cell& cell, RenderBatch& renderBatch)
 {
-  m_opaqueFaceRenderer.setGrayscale(m_grayscale);
-  m_opaqueFaceRenderer.setTint(m_tint);
-  m_opaqueFaceRenderer.setTintColor(m_tintColor);
-  m_opaqueFaceRenderer.render(renderBatch);
+  cell.opaqueFaceRenderer.setGrayscale(m_grayscale);
+  cell.opaqueFaceRenderer.setTint(m_tint);
+  cell.opaqueFaceRenderer.setTintColor(m_tintColor);
+  cell.opaqueFaceRenderer.render(renderBatch);
 }
 
-void BrushRenderer::renderTransparentFaces(RenderBatch& renderBatch)
+void BrushRenderer::renderTransparentFaces(Cell& cell, RenderBatch& renderBatch)
 {
-  m_transparentFaceRenderer.setGrayscale(m_grayscale);
-  m_transparentFaceRenderer.setTint(m_tint);
-  m_transparentFaceRenderer.setTintColor(m_tintColor);
-  m_transparentFaceRenderer.setAlpha(m_transparencyAlpha);
-  m_transparentFaceRenderer.render(renderBatch);
+  cell.transparentFaceRenderer.setGrayscale(m_grayscale);
+  cell.transparentFaceRenderer.setTint(m_tint);
+  cell.transparentFaceRenderer.setTintColor(m_tintColor);
+  cell.transparentFaceRenderer.setAlpha(m_transparencyAlpha);
+  cell.transparentFaceRenderer.render(renderBatch);
 }
 
-void BrushRenderer::renderEdges(RenderBatch& renderBatch)
+void BrushRenderer::renderEdges(Cell& cell, RenderBatch& renderBatch)
 {
   if (m_showOccludedEdges)
   {
-    m_edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
+    cell.edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
   }
-  m_edgeRenderer.render(renderBatch, m_edgeColor);
+  cell.edgeRenderer.render(renderBatch, m_edgeColor);
 }
 
 void BrushRenderer::validate()
@@ -387,12 +428,25 @@ void BrushRenderer::validate()
     validateBrush(*brushNode);
   }
   m_invalidBrushes.clear();
+  m_visibleCells.clear();
   assert(valid());
 
-  m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
-  m_transparentFaceRenderer =
-    FaceRenderer{m_vertexArray, m_transparentFaces, m_faceColor};
-  m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
+  for (auto& [key, cell] : m_cells)
+  {
+    cell.opaqueFaceRenderer =
+      FaceRenderer{m_vertexArray, cell.opaqueFaces, m_faceColor};
+    cell.transparentFaceRenderer =
+      FaceRenderer{m_vertexArray, cell.transparentFaces, m_faceColor};
+    cell.edgeRenderer = IndexedEdgeRenderer{m_vertexArray, cell.edgeIndices};
+  }
+}
+
+static vm::vec3i cellKeyForBounds(const vm::bbox3d& bounds)
+{
+  // the edge length of the cubes that brushes are batched by
+  constexpr auto CellSize = 2048.0;
+
+  return vm::vec3i{vm::floor(bounds.center() / CellSize)};
 }
 
 static size_t triIndicesCountForPolygon(const size_t vertexCount)
@@ -530,6 +584,23 @@ void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
 
   BrushInfo& info = m_brushInfo[&brushNode];
 
+  const auto& bounds = brushNode.physicalBounds();
+  info.cellKey = cellKeyForBounds(bounds);
+
+  auto& cell = m_cells[info.cellKey];
+  if (cell.brushCount == 0u)
+  {
+    cell.bounds = vm::bbox3f{bounds};
+    cell.edgeIndices = std::make_shared<BrushIndexArray>();
+    cell.transparentFaces = std::make_shared<MaterialToBrushIndicesMap>();
+    cell.opaqueFaces = std::make_shared<MaterialToBrushIndicesMap>();
+  }
+  else
+  {
+    cell.bounds = vm::merge(cell.bounds, vm::bbox3f{bounds});
+  }
+  ++cell.brushCount;
+
   // collect vertices
   auto& brushCache = brushNode.brushRendererBrushCache();
   brushCache.validateVertexCache(brushNode);
@@ -550,7 +621,7 @@ void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
     if (edgeIndexCount > 0)
     {
       auto [key, insertDest] =
-        m_edgeIndices->getPointerToInsertElementsAt(edgeIndexCount);
+        cell.edgeIndices->getPointerToInsertElementsAt(edgeIndexCount);
       info.edgeIndicesKey = key;
       getMarkedEdgeIndices(brushNode, edgePolicy, brushVerticesStartIndex, insertDest);
     }
@@ -603,7 +674,7 @@ void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
 
     if (transparentIndexCount > 0)
     {
-      auto& faceVboMap = *m_transparentFaces;
+      auto& faceVboMap = *cell.transparentFaces;
       auto& holderPtr = faceVboMap[material];
       if (holderPtr == nullptr)
       {
@@ -638,7 +709,7 @@ void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
 
     if (opaqueIndexCount > 0)
     {
-      auto& faceVboMap = *m_opaqueFaces;
+      auto& faceVboMap = *cell.opaqueFaces;
       auto& holderPtr = faceVboMap[material];
       if (holderPtr == nullptr)
       {
@@ -711,38 +782,48 @@ void BrushRenderer::removeBrushFromVbo(const mdl::BrushNode& brushNode)
 
   const auto& info = it->second;
 
+  auto cellIt = m_cells.find(info.cellKey);
+  assert(cellIt != m_cells.end());
+  auto& cell = cellIt->second;
+
   // update Vbo's
   m_vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
   if (info.edgeIndicesKey != nullptr)
   {
-    m_edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
+    cell.edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
   }
 
   for (const auto& [material, opaqueKey] : info.opaqueFaceIndicesKeys)
   {
-    auto faceIndexHolder = m_opaqueFaces->at(material);
+    auto faceIndexHolder = cell.opaqueFaces->at(material);
     faceIndexHolder->zeroElementsWithKey(opaqueKey);
 
     if (!faceIndexHolder->hasValidIndices())
     {
       // There are no indices left to render for this material, so delete the <Material,
       // BrushIndexArray> entry from the map
-      m_opaqueFaces->erase(material);
+      cell.opaqueFaces->erase(material);
     }
   }
   for (const auto& [material, transparentKey] : info.transparentFaceIndicesKeys)
   {
-    auto faceIndexHolder = m_transparentFaces->at(material);
+    auto faceIndexHolder = cell.transparentFaces->at(material);
     faceIndexHolder->zeroElementsWithKey(transparentKey);
 
     if (!faceIndexHolder->hasValidIndices())
     {
       // There are no indices left to render for this material, so delete the <Material,
       // BrushIndexArray> entry from the map
-      m_transparentFaces->erase(material);
+      cell.transparentFaces->erase(material);
     }
   }
 
+  if (--cell.brushCount == 0u)
+  {
+    m_cells.erase(cellIt);
+  }
+  m_visibleCells.clear();
+
   m_brushInfo.erase(it);
 }
 
@@ -25,7 +25,12 @@
 #include "render/AllocationTracker.h"
 #include "render/EdgeRenderer.h"
 #include "render/FaceRenderer.h"
+#include "render/ViewFrustum.h"
 
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include <map>
 #include <memory>
 #include <tuple>
 #include <unordered_map>
@@ -119,8 +124,34 @@ public:
 private:
   std::unique_ptr<Filter> m_filter;
 
+  using MaterialToBrushIndicesMap =
+    std::unordered_map<const mdl::Material*, std::shared_ptr<BrushIndexArray>>;
+
+  /**
+   * Brushes are batched by the spatial cell that contains the center of their bounds so
+   * that entire batches can be skipped when they are outside of the view frustum. All
+   * cells share the vertex array.
+   *
+   * The bounds of a cell only grow while brushes are added to it. They are reset when the
+   * last brush is removed from the cell, which also removes the cell.
+   */
+  struct Cell
+  {
+    vm::bbox3f bounds;
+    size_t brushCount = 0u;
+
+    std::shared_ptr<BrushIndexArray> edgeIndices;
+    std::shared_ptr<MaterialToBrushIndicesMap> transparentFaces;
+    std::shared_ptr<MaterialToBrushIndicesMap> opaqueFaces;
+
+    FaceRenderer opaqueFaceRenderer;
+    FaceRenderer transparentFaceRenderer;
+    IndexedEdgeRenderer edgeRenderer;
+  };
+
   struct BrushInfo
   {
+    vm::vec3i cellKey;
     AllocationTracker::Block* vertexHolderKey;
     AllocationTracker::Block* edgeIndicesKey;
     std::vector<std::pair<const mdl::Material*, AllocationTracker::Block*>>
@@ -144,16 +175,25 @@ private:
   std::unordered_set<const mdl::BrushNode*> m_invalidBrushes;
 
   std::shared_ptr<BrushVertexArray> m_vertexArray;
-  std::shared_ptr<BrushIndexArray> m_edgeIndices;
+  std::map<vm::vec3i, Cell> m_cells;
 
-  using MaterialToBrushIndicesMap =
-    std::unordered_map<const mdl::Material*, std::shared_ptr<BrushIndexArray>>;
-  std::shared_ptr<MaterialToBrushIndicesMap> m_transparentFaces;
-  std::shared_ptr<MaterialToBrushIndicesMap> m_opaqueFaces;
+  /**
+   * The cells that intersect a camera's view frustum. The stats count the brushes in the
+   * drawn and in the culled cells.
+   */
+  struct VisibleCells
+  {
+    ViewFrustum frustum;
+    std::vector<Cell*> cells;
+    CullingStats stats;
+  };
 
-  FaceRenderer m_opaqueFaceRenderer;
-  FaceRenderer m_transparentFaceRenderer;
-  IndexedEdgeRenderer m_edgeRenderer;
+  /**
+   * The visible cells are cached per camera, so that the passes of a view share them and
+   * views with different cameras don't evict each other's cells. An entry is recomputed
+   * when the camera's frustum changes, and the cache is cleared when the cells change.
+   */
+  std::unordered_map<const Camera*, VisibleCells> m_visibleCells;
 
   Color m_faceColor;
   bool m_showEdges = false;
@@ -193,9 +233,8 @@ public:
    * Until a brush is invalidated, we don't re-evaluate the Filter, and don't check the
    * Brush object for modification.
    *
-   * Additionally, calling `invalidate()` guarantees the m_brushInfo, m_transparentFaces,
-   * and m_opaqueFaces maps will be empty, so the BrushRenderer will not have any
-   * lingering Material* pointers.
+   * Additionally, calling `invalidate()` guarantees the m_brushInfo and m_cells maps will
+   * be empty, so the BrushRenderer will not have any lingering Material* pointers.
    */
   void invalidate();
   void invalidateMaterials(const std::vector<const mdl::Material*>& materials);
@@ -275,10 +314,19 @@ public: // rendering
   void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
   void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
 
+  /**
+   * Returns the number of brushes that are drawn and the number of brushes that are
+   * skipped because their batches are outside of the view frustum when rendering for the
+   * given camera.
+   */
+  const CullingStats& cullingStats(const Camera& camera);
+
 private:
-  void renderOpaqueFaces(RenderBatch& renderBatch);
-  void renderTransparentFaces(RenderBatch& renderBatch);
-  void renderEdges(RenderBatch& renderBatch);
+  const VisibleCells& visibleCells(const Camera& camera);
+
+  void renderOpaqueFaces(Cell& cell, RenderBatch& renderBatch);
+  void renderTransparentFaces(Cell& cell, RenderBatch& renderBatch);
+  void renderEdges(Cell& cell, RenderBatch& renderBatch);
 
 public:
   /**
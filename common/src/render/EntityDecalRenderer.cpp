@@ -36,9 +36,11 @@
 
 #include "kdl/memory_utils.h"
 #include "kdl/overload.h"
+#include "kdl/vector_utils.h"
 
 #include "vm/intersection.h"
 
+#include <algorithm>
 #include <cstring>
 
 namespace tb::render
@@ -49,7 +51,7 @@ namespace
 std::optional<mdl::DecalSpecification> getDecalSpecification(
   const mdl::EntityNode* entityNode)
 {
-  const auto decalSpec = entityNode->entity().decalSpecification();
+  const auto& decalSpec = entityNode->entity().decalSpecification();
   return decalSpec.materialName.empty() ? std::nullopt : std::make_optional(decalSpec);
 }
 
@@ -139,6 +141,29 @@ std::vector<Vertex> createDecalBrushFace(
   });
 }
 
+std::vector<std::vector<Vertex>> createDecalPolygons(
+  const mdl::EntityNode* entityNode,
+  const vm::bbox3d& shrunkBounds,
+  const mdl::BrushNode* brush,
+  const mdl::Material& material)
+{
+  auto polygons = std::vector<std::vector<Vertex>>{};
+  for (const auto& face : brush->brush().faces())
+  {
+    // see if this decal can be projected onto this face
+    const auto facePolygon = face.geometry()->vertexPositions();
+    if (vm::intersect_bbox_polygon(shrunkBounds, facePolygon.begin(), facePolygon.end()))
+    {
+      auto decalPolygon = createDecalBrushFace(entityNode, brush, face, material);
+      if (!decalPolygon.empty())
+      {
+        polygons.push_back(std::move(decalPolygon));
+      }
+    }
+  }
+  return polygons;
+}
+
 } // namespace
 
 EntityDecalRenderer::EntityDecalRenderer(std::weak_ptr<ui::MapDocument> document)
@@ -151,6 +176,7 @@ void EntityDecalRenderer::invalidate()
 {
   for (auto& [ent, data] : m_entities)
   {
+    data.polygons.clear();
     invalidateDecalData(data);
   }
 }
@@ -158,6 +184,7 @@ void EntityDecalRenderer::invalidate()
 void EntityDecalRenderer::clear()
 {
   m_entities.clear();
+  m_brushEntities.clear();
   m_vertexArray = std::make_shared<BrushVertexArray>();
   m_faces = std::make_shared<MaterialToBrushIndicesMap>();
   m_faceRenderer = FaceRenderer{m_vertexArray, m_faces, m_faceColor};
@@ -199,8 +226,16 @@ void EntityDecalRenderer::updateEntity(const mdl::EntityNode* entityNode)
   const auto isTracking = entity != std::end(m_entities);
   if (isTracking && spec)
   {
-    // entity is being tracked and has a decal specification, invalidate it
-    invalidateDecalData(entity->second);
+    // entity is being tracked and has a decal specification, invalidate it if the
+    // decal geometry depends on anything that changed
+    auto& data = entity->second;
+    if (
+      data.bounds != entityNode->physicalBounds()
+      || data.materialName != spec->materialName)
+    {
+      data.polygons.clear();
+      invalidateDecalData(data);
+    }
   }
   else if (isTracking)
   {
@@ -220,53 +255,53 @@ void EntityDecalRenderer::removeEntity(const mdl::EntityNode* entityNode)
   {
     // make sure the entity data is cleaned up
     invalidateDecalData(it->second);
+    untrackBrushes(entityNode, it->second);
     m_entities.erase(it);
   }
 }
 
 void EntityDecalRenderer::updateBrush(const mdl::BrushNode* brushNode)
 {
-  // invalidate any entities that intersect this brush or are tracking this brush
-  for (auto& [ent, data] : m_entities)
-  {
-    // skip entities that are going to be recomputed anyway
-    if (!data.validated)
-    {
-      continue;
-    }
-
-    // if the brush is not visible, then it doesn't (currently) intersect
-    const auto& editorContext = kdl::mem_lock(m_document)->editorContext();
-    const auto intersects =
-      editorContext.visible(brushNode) && brushNode->intersects(ent);
-    const auto tracked = std::find(data.brushes.begin(), data.brushes.end(), brushNode)
-                         != data.brushes.end();
+  // invalidate any entities that are tracking this brush
+  invalidateBrushDependents(brushNode);
 
-    // if this brush is tracked by this entity or intersects, we'll need to
-    // recalculate the geometry
-    if (intersects || tracked)
-    {
-      invalidateDecalData(data);
-    }
+  // if the brush is not visible, then it doesn't (currently) intersect
+  const auto& document = kdl::mem_lock(m_document);
+  if (!document->editorContext().visible(brushNode))
+  {
+    return;
   }
+
+  // invalidate any entities that intersect this brush, the node tree only yields the
+  // entities that are close enough to be affected
+  document->world()->nodeTree().visit_intersectors(
+    brushNode->physicalBounds(), [&](const mdl::Node* node) {
+      const auto* entityNode = dynamic_cast<const mdl::EntityNode*>(node);
+      if (const auto it = m_entities.find(entityNode); it != std::end(m_entities))
+      {
+        auto& data = it->second;
+        data.polygons.erase(brushNode);
+        invalidateDecalData(data);
+      }
+    });
 }
 
 void EntityDecalRenderer::removeBrush(const mdl::BrushNode* brushNode)
 {
   // invalidate any entities that are tracking this brush
-  for (auto& [ent, data] : m_entities)
-  {
-    // skip entities that are going to be recomputed anyway
-    if (!data.validated)
-    {
-      continue;
-    }
+  invalidateBrushDependents(brushNode);
+  m_brushEntities.erase(brushNode);
+}
 
-    // if this brush is tracked by this entity, remove it and recalculate
-    const auto tracked = std::find(data.brushes.begin(), data.brushes.end(), brushNode)
-                         != data.brushes.end();
-    if (tracked)
+void EntityDecalRenderer::invalidateBrushDependents(const mdl::BrushNode* brushNode)
+{
+  if (const auto it = m_brushEntities.find(brushNode); it != std::end(m_brushEntities))
+  {
+    for (const auto* entityNode : it->second)
     {
+      // the polygons on the other brushes remain valid
+      auto& data = m_entities.at(entityNode);
+      data.polygons.erase(brushNode);
       invalidateDecalData(data);
     }
   }
@@ -305,8 +340,33 @@ void EntityDecalRenderer::invalidateDecalData(EntityDecalData& data) const
   data.faceIndicesKey = nullptr;
 }
 
+void EntityDecalRenderer::trackBrushes(
+  const mdl::EntityNode* entityNode, const EntityDecalData& data)
+{
+  for (const auto* brushNode : data.brushes)
+  {
+    m_brushEntities[brushNode].push_back(entityNode);
+  }
+}
+
+void EntityDecalRenderer::untrackBrushes(
+  const mdl::EntityNode* entityNode, const EntityDecalData& data)
+{
+  for (const auto* brushNode : data.brushes)
+  {
+    if (const auto it = m_brushEntities.find(brushNode); it != std::end(m_brushEntities))
+    {
+      std::erase(it->second, entityNode);
+      if (it->second.empty())
+      {
+        m_brushEntities.erase(it);
+      }
+    }
+  }
+}
+
 void EntityDecalRenderer::validateDecalData(
-  const mdl::EntityNode* entityNode, EntityDecalData& data) const
+  const mdl::EntityNode* entityNode, EntityDecalData& data)
 {
   if (data.validated)
   {
@@ -321,22 +381,35 @@ void EntityDecalRenderer::validateDecalData(
   const auto& editorContext = document->editorContext();
   const auto* world = document->world();
 
-  // collect all the brush nodes that touch the entity's bbox
+  // collect all the brush nodes that touch the entity's bbox and track them in the entity
   const auto entityBounds = entityNode->physicalBounds();
-  const auto intersectors = world->nodeTree().find_intersectors(entityBounds);
-
-  // track them in the entity
+  untrackBrushes(entityNode, data);
   data.brushes.clear();
-  for (const auto* node : intersectors)
-  {
+  world->nodeTree().visit_intersectors(entityBounds, [&](const mdl::Node* node) {
     const auto* brushNode = dynamic_cast<const mdl::BrushNode*>(node);
     if (brushNode && editorContext.visible(brushNode))
     {
       data.brushes.push_back(brushNode);
     }
+  });
+  trackBrushes(entityNode, data);
+
+  // the cached polygons are only valid for the entity bounds and material they were
+  // created for
+  auto* material = document->materialManager().material(spec->materialName);
+  if (
+    material != data.material || entityBounds != data.bounds
+    || spec->materialName != data.materialName)
+  {
+    data.polygons.clear();
   }
+  std::erase_if(data.polygons, [&](const auto& entry) {
+    return !kdl::vec_contains(data.brushes, entry.first);
+  });
 
-  data.material = document->materialManager().material(spec->materialName);
+  data.bounds = entityBounds;
+  data.materialName = spec->materialName;
+  data.material = material;
   if (!data.material)
   {
     // no decal material was found, don't generate any geometry
@@ -352,35 +425,32 @@ void EntityDecalRenderer::validateDecalData(
   // so adjacent faces that don't actually breach the entity's bounding box are excluded.
   const auto shrunkBounds = entityBounds.expand(-vm::Cd::almost_zero());
 
-  // create geometry for the decal
+  // create geometry for the decal, reusing the polygons of unchanged brushes
   auto vertices = std::vector<Vertex>{};
   auto indices = std::vector<size_t>{};
 
   for (const auto& brush : data.brushes)
   {
-    for (const auto& face : brush->brush().faces())
+    auto it = data.polygons.find(brush);
+    if (it == data.polygons.end())
     {
-      // see if this decal can be projected onto this face
-      const auto facePolygon = face.geometry()->vertexPositions();
-      if (vm::intersect_bbox_polygon(
-            shrunkBounds, facePolygon.begin(), facePolygon.end()))
+      it = data.polygons
+             .emplace(
+               brush, createDecalPolygons(entityNode, shrunkBounds, brush, *data.material))
+             .first;
+    }
+
+    for (const auto& decalPolygon : it->second)
+    {
+      // add the geometry to be uploaded into the VBO
+      const auto vertexOffset = vertices.size();
+
+      vertices.insert(vertices.end(), decalPolygon.begin(), decalPolygon.end());
+      for (size_t i = 0; i < decalPolygon.size() - 2; ++i)
       {
-        assert(data.material);
-        const auto decalPolygon =
-          createDecalBrushFace(entityNode, brush, face, *data.material);
-        if (!decalPolygon.empty())
-        {
-          // add the geometry to be uploaded into the VBO
-          const auto vertexOffset = vertices.size();
-
-          vertices.insert(vertices.end(), decalPolygon.begin(), decalPolygon.end());
-          for (size_t i = 0; i < decalPolygon.size() - 2; ++i)
-          {
-            indices.push_back(vertexOffset);
-            indices.push_back(vertexOffset + i + 1);
-            indices.push_back(vertexOffset + i + 2);
-          }
-        }
+        indices.push_back(vertexOffset);
+        indices.push_back(vertexOffset + i + 1);
+        indices.push_back(vertexOffset + i + 2);
       }
     }
   }
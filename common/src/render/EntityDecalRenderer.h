@@ -26,7 +26,10 @@
 #include "render/GLVertexType.h"
 #include "render/Renderable.h"
 
+#include "vm/bbox.h"
+
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -51,10 +54,21 @@ namespace tb::render
 class EntityDecalRenderer
 {
 private:
+  using Vertex = render::GLVertexTypes::P3NT2::Vertex;
+
   struct EntityDecalData
   {
+    /* the entity bounds and decal material name that the cached geometry was created for
+     */
+    vm::bbox3d bounds;
+    std::string materialName;
+
     std::vector<const mdl::BrushNode*> brushes;
 
+    /* the decal polygons projected onto each brush, only the polygons of brushes that
+     * changed since the last validation are recomputed */
+    std::unordered_map<const mdl::BrushNode*, std::vector<std::vector<Vertex>>> polygons;
+
     /* will only be true if the brushes array has been calculated since the last change
      * and the decal geometry is stored in the VBO */
     bool validated = false;
@@ -67,11 +81,16 @@ private:
 
   using EntityWithDependenciesMap =
     std::unordered_map<const mdl::EntityNode*, EntityDecalData>;
+  using BrushWithDependentsMap =
+    std::unordered_map<const mdl::BrushNode*, std::vector<const mdl::EntityNode*>>;
 
   std::weak_ptr<ui::MapDocument> m_document;
   EntityWithDependenciesMap m_entities;
 
-  using Vertex = render::GLVertexTypes::P3NT2::Vertex;
+  /* maps each brush to the entities that were projected onto it when they were last
+   * validated */
+  BrushWithDependentsMap m_brushEntities;
+
   using MaterialToBrushIndicesMap =
     std::unordered_map<const mdl::Material*, std::shared_ptr<BrushIndexArray>>;
 
@@ -109,9 +128,13 @@ private:
   void updateBrush(const mdl::BrushNode* brushNode);
   void removeBrush(const mdl::BrushNode* brushNode);
 
+  void invalidateBrushDependents(const mdl::BrushNode* brushNode);
   void invalidateDecalData(EntityDecalData& data) const;
 
-  void validateDecalData(const mdl::EntityNode* entityNode, EntityDecalData& data) const;
+  void trackBrushes(const mdl::EntityNode* entityNode, const EntityDecalData& data);
+  void untrackBrushes(const mdl::EntityNode* entityNode, const EntityDecalData& data);
+
+  void validateDecalData(const mdl::EntityNode* entityNode, EntityDecalData& data);
 
 public: // rendering
   void render(RenderContext& renderContext, RenderBatch& renderBatch);
@@ -39,10 +39,22 @@
 
 #include "vm/mat.h"
 
+#include <cassert>
 #include <vector>
 
 namespace tb::render
 {
+namespace
+{
+
+vm::mat4x4f modelTransformation(const mdl::EntityNode& entityNode)
+{
+  const auto& propertyConfig = entityNode.entityPropertyConfig();
+  return vm::mat4x4f{
+    entityNode.entity().modelTransformation(propertyConfig.defaultModelScaleExpression)};
+}
+
+} // namespace
 
 EntityModelRenderer::EntityModelRenderer(
   Logger& logger,
@@ -67,15 +79,18 @@ void EntityModelRenderer::addEntity(const mdl::EntityNode* entityNode)
     });
 
   auto* renderer = m_entityModelManager.renderer(modelSpec);
-  if (renderer != nullptr)
+  if (renderer != nullptr && !m_entityIndices.contains(entityNode))
   {
-    m_entities.emplace(entityNode, renderer);
+    insertEntity(entityNode, renderer);
   }
 }
 
 void EntityModelRenderer::removeEntity(const mdl::EntityNode* entityNode)
 {
-  m_entities.erase(entityNode);
+  if (const auto it = m_entityIndices.find(entityNode); it != std::end(m_entityIndices))
+  {
+    eraseEntity(it->second);
+  }
 }
 
 void EntityModelRenderer::updateEntity(const mdl::EntityNode* entityNode)
@@ -86,33 +101,38 @@ void EntityModelRenderer::updateEntity(const mdl::EntityNode* entityNode)
     });
 
   auto* renderer = m_entityModelManager.renderer(modelSpec);
-  auto it = m_entities.find(entityNode);
+  auto it = m_entityIndices.find(entityNode);
 
-  if (renderer == nullptr && it == std::end(m_entities))
+  if (renderer == nullptr && it == std::end(m_entityIndices))
   {
     return;
   }
 
-  if (it == std::end(m_entities))
+  if (it == std::end(m_entityIndices))
   {
-    m_entities.emplace(entityNode, renderer);
+    insertEntity(entityNode, renderer);
   }
   else
   {
+    const auto index = it->second;
     if (renderer == nullptr)
     {
-      m_entities.erase(it);
+      eraseEntity(index);
     }
-    else if (it->second != renderer)
+    else
     {
-      it->second = renderer;
+      m_renderers[index] = renderer;
+      m_transformations[index] = modelTransformation(*entityNode);
     }
   }
 }
 
 void EntityModelRenderer::clear()
 {
-  m_entities.clear();
+  m_entityIndices.clear();
+  m_entityNodes.clear();
+  m_renderers.clear();
+  m_transformations.clear();
 }
 
 bool EntityModelRenderer::applyTinting() const
@@ -145,11 +165,45 @@ void EntityModelRenderer::setShowHiddenEntities(const bool showHiddenEntities)
   m_showHiddenEntities = showHiddenEntities;
 }
 
+const CullingStats& EntityModelRenderer::cullingStats() const
+{
+  return m_cullingStats;
+}
+
 void EntityModelRenderer::render(RenderBatch& renderBatch)
 {
   renderBatch.add(this);
 }
 
+void EntityModelRenderer::insertEntity(
+  const mdl::EntityNode* entityNode, MaterialRenderer* renderer)
+{
+  m_entityIndices.emplace(entityNode, m_entityNodes.size());
+  m_entityNodes.push_back(entityNode);
+  m_renderers.push_back(renderer);
+  m_transformations.push_back(modelTransformation(*entityNode));
+}
+
+void EntityModelRenderer::eraseEntity(const size_t index)
+{
+  assert(index < m_entityNodes.size());
+
+  // move the last entity into the gap to keep the arrays packed
+  const auto lastIndex = m_entityNodes.size() - 1u;
+  m_entityIndices.erase(m_entityNodes[index]);
+  if (index != lastIndex)
+  {
+    m_entityNodes[index] = m_entityNodes[lastIndex];
+    m_renderers[index] = m_renderers[lastIndex];
+    m_transformations[index] = m_transformations[lastIndex];
+    m_entityIndices[m_entityNodes[index]] = index;
+  }
+
+  m_entityNodes.pop_back();
+  m_renderers.pop_back();
+  m_transformations.pop_back();
+}
+
 void EntityModelRenderer::doPrepareVertices(VboManager& vboManager)
 {
   m_entityModelManager.prepare(vboManager);
@@ -157,7 +211,9 @@ void EntityModelRenderer::doPrepareVertices(VboManager& vboManager)
 
 void EntityModelRenderer::doRender(RenderContext& renderContext)
 {
-  if (!m_entities.empty())
+  m_cullingStats = CullingStats{};
+
+  if (!m_entityNodes.empty())
   {
     auto& prefs = PreferenceManager::instance();
 
@@ -187,11 +243,11 @@ void EntityModelRenderer::doRender(RenderContext& renderContext)
     shader.set("CameraUp", renderContext.camera().up());
     shader.set("ViewMatrix", renderContext.camera().viewMatrix());
 
-    const auto& propertyConfig = m_entities.begin()->first->entityPropertyConfig();
-    const auto& defaultModelScaleExpression = propertyConfig.defaultModelScaleExpression;
+    const auto frustum = ViewFrustum{renderContext.camera()};
 
-    for (const auto& [entityNode, renderer] : m_entities)
+    for (size_t i = 0; i < m_entityNodes.size(); ++i)
     {
+      const auto* entityNode = m_entityNodes[i];
       if (!m_showHiddenEntities && !m_editorContext.visible(entityNode))
       {
         continue;
@@ -204,10 +260,16 @@ void EntityModelRenderer::doRender(RenderContext& renderContext)
         continue;
       }
 
+      if (!frustum.intersects(entityNode->modelBounds()))
+      {
+        ++m_cullingStats.culled;
+        continue;
+      }
+      ++m_cullingStats.drawn;
+
       shader.set("Orientation", static_cast<int>(modelData->orientation()));
 
-      const auto transformation = vm::mat4x4f{
-        entityNode->entity().modelTransformation(defaultModelScaleExpression)};
+      const auto& transformation = m_transformations[i];
       const auto multMatrix =
         MultiplyModelMatrix{renderContext.transformation(), transformation};
 
@@ -215,7 +277,7 @@ void EntityModelRenderer::doRender(RenderContext& renderContext)
 
       auto renderFunc = DefaultMaterialRenderFunc{
         renderContext.minFilterMode(), renderContext.magFilterMode()};
-      renderer->render(renderFunc);
+      m_renderers[i]->render(renderFunc);
     }
   }
 }
@@ -21,8 +21,12 @@
 
 #include "Color.h"
 #include "render/Renderable.h"
+#include "render/ViewFrustum.h"
+
+#include "vm/mat.h"
 
 #include <unordered_map>
+#include <vector>
 
 namespace tb
 {
@@ -50,13 +54,22 @@ private:
   mdl::EntityModelManager& m_entityModelManager;
   const mdl::EditorContext& m_editorContext;
 
-  std::unordered_map<const mdl::EntityNode*, MaterialRenderer*> m_entities;
+  /**
+   * The entities are stored in packed arrays so that rendering them is a linear walk. The
+   * model transformation of an entity is computed when the entity is added or updated.
+   */
+  std::unordered_map<const mdl::EntityNode*, size_t> m_entityIndices;
+  std::vector<const mdl::EntityNode*> m_entityNodes;
+  std::vector<MaterialRenderer*> m_renderers;
+  std::vector<vm::mat4x4f> m_transformations;
 
   bool m_applyTinting = false;
   Color m_tintColor;
 
   bool m_showHiddenEntities = false;
 
+  CullingStats m_cullingStats;
+
 public:
   EntityModelRenderer(
     Logger& logger,
@@ -104,9 +117,18 @@ public:
   bool showHiddenEntities() const;
   void setShowHiddenEntities(bool showHiddenEntities);
 
+  /**
+   * Returns the number of entity models that were drawn and the number of entity models
+   * that were skipped because they were outside of the view frustum in the last frame.
+   */
+  const CullingStats& cullingStats() const;
+
   void render(RenderBatch& renderBatch);
 
 private:
+  void insertEntity(const mdl::EntityNode* entityNode, MaterialRenderer* renderer);
+  void eraseEntity(size_t index);
+
   void doPrepareVertices(VboManager& vboManager) override;
   void doRender(RenderContext& renderContext) override;
 };
@@ -828,6 +828,7 @@ void MapRenderer::resourcesWereProcessed(const std::vector<mdl::ResourceId>& res
 void MapRenderer::materialCollectionsWillChange()
 {
   invalidateRenderers(Renderer::All);
+  invalidateEntityDecalRenderer();
 }
 
 void MapRenderer::entityDefinitionsDidChange()
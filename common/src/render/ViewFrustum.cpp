@@ -0,0 +1,59 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ViewFrustum.h"
+
+#include "render/Camera.h"
+
+#include "kdl/reflection_impl.h"
+
+namespace tb::render
+{
+
+kdl_reflect_impl(CullingStats);
+
+ViewFrustum::ViewFrustum(const Camera& camera)
+{
+  camera.frustumPlanes(m_planes[0], m_planes[1], m_planes[2], m_planes[3]);
+}
+
+bool ViewFrustum::intersects(const vm::bbox3f& bounds) const
+{
+  // The frustum planes point outwards. The box is outside of the frustum if the corner
+  // that lies furthest along the negative normal of a plane is still above that plane.
+  for (const auto& plane : m_planes)
+  {
+    const auto nearestCorner = vm::vec3f{
+      plane.normal.x() >= 0.0f ? bounds.min.x() : bounds.max.x(),
+      plane.normal.y() >= 0.0f ? bounds.min.y() : bounds.max.y(),
+      plane.normal.z() >= 0.0f ? bounds.min.z() : bounds.max.z()};
+    if (plane.point_distance(nearestCorner) > 0.0f)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ViewFrustum::intersects(const vm::bbox3d& bounds) const
+{
+  return intersects(vm::bbox3f{bounds});
+}
+
+} // namespace tb::render
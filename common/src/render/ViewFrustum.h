@@ -0,0 +1,76 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "kdl/reflection_decl.h"
+
+#include "vm/bbox.h"
+#include "vm/plane.h"
+
+#include <array>
+#include <cstddef>
+
+namespace tb::render
+{
+class Camera;
+
+/**
+ * Counts how many objects a renderer draws and how many it skips because they are
+ * outside of the view frustum.
+ */
+struct CullingStats
+{
+  size_t drawn = 0u;
+  size_t culled = 0u;
+
+  kdl_reflect_decl(CullingStats, drawn, culled);
+};
+
+/**
+ * The side planes of a camera's view frustum, used to skip objects that cannot be
+ * visible.
+ *
+ * The test is conservative: a box that is reported as not visible is guaranteed to lie
+ * outside of the frustum, but a box that is reported as visible may still lie outside
+ * of it if it straddles the extensions of two frustum planes. The near and far planes are
+ * not considered, they are left to the clipper.
+ */
+class ViewFrustum
+{
+private:
+  std::array<vm::plane3f, 4> m_planes;
+
+public:
+  explicit ViewFrustum(const Camera& camera);
+
+  /**
+   * Indicates whether the given box may intersect the view frustum.
+   */
+  bool intersects(const vm::bbox3f& bounds) const;
+
+  /**
+   * Indicates whether the given box may intersect the view frustum.
+   */
+  bool intersects(const vm::bbox3d& bounds) const;
+
+  friend bool operator==(const ViewFrustum& lhs, const ViewFrustum& rhs) = default;
+};
+
+} // namespace tb::render
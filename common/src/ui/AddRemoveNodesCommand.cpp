@@ -21,6 +21,7 @@
 
 #include "Ensure.h"
 #include "Macros.h"
+#include "mdl/ModelUtils.h"
 #include "mdl/Node.h"
 #include "ui/MapDocumentCommandFacade.h"
 
@@ -73,6 +74,17 @@ AddRemoveNodesCommand::AddRemoveNodesCommand(
   }
 }
 
+size_t AddRemoveNodesCommand::sizeInBytes() const
+{
+  // the nodes to add are owned by this command
+  auto result = UpdateLinkedGroupsCommandBase::sizeInBytes();
+  for (const auto& [parent, children] : m_nodesToAdd)
+  {
+    result += mdl::computeSizeInBytes(children);
+  }
+  return result;
+}
+
 std::string AddRemoveNodesCommand::makeName(const Action action)
 {
   switch (action)
@@ -58,6 +58,8 @@ public:
     Action action, const std::map<mdl::Node*, std::vector<mdl::Node*>>& nodes);
   ~AddRemoveNodesCommand() override;
 
+  size_t sizeInBytes() const override;
+
 private:
   static std::string makeName(Action action);
 
@@ -19,24 +19,39 @@
 
 #include "Autosaver.h"
 
+#include "Logger.h"
 #include "io/DiskFileSystem.h"
 #include "io/DiskIO.h"
 #include "io/FileSystem.h"
+#include "io/MapHeader.h"
+#include "io/NodeWriter.h"
 #include "io/PathInfo.h"
 #include "io/TraversalMode.h"
+#include "mdl/BrushNode.h"
+#include "mdl/EntityNode.h"
+#include "mdl/Game.h"
+#include "mdl/GameConfig.h"
+#include "mdl/GroupNode.h"
+#include "mdl/LayerNode.h"
+#include "mdl/PatchNode.h"
+#include "mdl/WorldNode.h"
 #include "ui/MapDocument.h"
 
 #include "kdl/memory_utils.h"
+#include "kdl/overload.h"
 #include "kdl/path_utils.h"
 #include "kdl/result.h"
 #include "kdl/result_fold.h"
 #include "kdl/string_compare.h"
 #include "kdl/string_format.h"
 #include "kdl/string_utils.h"
+#include "kdl/task_manager.h"
 #include "kdl/vector_utils.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <string>
 
 namespace tb::ui
 {
@@ -111,6 +126,86 @@ Result<void> cleanBackups(
          | kdl::fold;
 }
 
+/**
+ * Removes the references to materials, entity definitions and entity models from the
+ * given snapshot. The writer doesn't need them, and the document may unload these assets
+ * while the snapshot is still being written.
+ */
+void releaseAssets(mdl::WorldNode& snapshot)
+{
+  const auto deferNodeTreeUpdates = mdl::DeferNodeTreeUpdates{snapshot};
+
+  snapshot.accept(kdl::overload(
+    [](auto&& thisLambda, mdl::WorldNode* world) {
+      world->setDefinition(nullptr);
+      world->visitChildren(thisLambda);
+    },
+    [](auto&& thisLambda, mdl::LayerNode* layer) { layer->visitChildren(thisLambda); },
+    [](auto&& thisLambda, mdl::GroupNode* group) { group->visitChildren(thisLambda); },
+    [](auto&& thisLambda, mdl::EntityNode* entity) {
+      entity->setDefinition(nullptr);
+      if (entity->entity().model())
+      {
+        entity->setModel(nullptr);
+      }
+      entity->visitChildren(thisLambda);
+    },
+    [](mdl::BrushNode* brushNode) {
+      for (size_t i = 0u; i < brushNode->brush().faceCount(); ++i)
+      {
+        brushNode->setFaceMaterial(i, nullptr);
+      }
+    },
+    [](mdl::PatchNode* patchNode) { patchNode->setMaterial(nullptr); }));
+}
+
+/**
+ * Writes the given snapshot to a temporary file next to the backup file and renames it
+ * once it is complete, so that a cancelled or failed autosave never leaves a partial
+ * backup behind. Runs on a worker thread.
+ *
+ * The stop token is checked before each node is written, and the fraction of the nodes
+ * written so far is stored in the given progress value.
+ */
+Result<void> writeBackup(
+  const std::filesystem::path& backupFilePath,
+  const std::string& gameName,
+  const mdl::WorldNode& snapshot,
+  kdl::task_manager& taskManager,
+  std::atomic<float>& progress,
+  const std::stop_token& stopToken)
+{
+  if (stopToken.stop_requested())
+  {
+    return Error{"Autosave was cancelled"};
+  }
+
+  const auto tempFilePath = kdl::path_add_extension(backupFilePath, ".tmp");
+  return io::Disk::withOutputStream(
+           tempFilePath,
+           [&](auto& stream) {
+             io::writeMapHeader(stream, gameName, snapshot.mapFormat());
+
+             auto writer = io::NodeWriter{snapshot, stream};
+             writer.setExporting(false);
+             writer.setProgressCallback(
+               [&](const auto writtenNodeCount, const auto nodeCount) {
+                 progress = float(writtenNodeCount) / float(nodeCount);
+                 return !stopToken.stop_requested();
+               });
+             writer.writeMap(taskManager);
+           })
+         | kdl::and_then([&]() -> Result<void> {
+             if (stopToken.stop_requested())
+             {
+               return io::Disk::deleteFile(tempFilePath) | kdl::and_then([](auto) {
+                        return Result<void>{Error{"Autosave was cancelled"}};
+                      });
+             }
+             return io::Disk::moveFile(tempFilePath, backupFilePath);
+           });
+}
+
 } // namespace
 
 io::PathMatcher makeBackupPathMatcher(std::filesystem::path mapBasename_)
@@ -139,10 +234,26 @@ Autosaver::Autosaver(
   , m_lastSaveTime{Clock::now()}
   , m_lastModificationCount{kdl::mem_lock(m_document)->modificationCount()}
 {
+  m_notifierConnection +=
+    kdl::mem_lock(m_document)
+      ->documentWillBeClearedNotifier.connect(this, &Autosaver::documentWillBeCleared);
+}
+
+Autosaver::~Autosaver()
+{
+  auto logger = NullLogger{};
+  waitForAutosave(logger);
 }
 
 void Autosaver::triggerAutosave(Logger& logger)
 {
+  if (!collectAutosave(logger, false))
+  {
+    logger.debug() << "Writing autosave backup to " << m_pendingAutosave->backupFilePath
+                   << ": " << int(*m_pendingAutosave->progress * 100.0f) << "%";
+    return;
+  }
+
   if (!kdl::mem_expired(m_document))
   {
     auto document = kdl::mem_lock(m_document);
@@ -155,6 +266,56 @@ void Autosaver::triggerAutosave(Logger& logger)
   }
 }
 
+bool Autosaver::autosaveInProgress() const
+{
+  return m_pendingAutosave
+         && m_pendingAutosave->result.wait_for(std::chrono::seconds{0})
+              != std::future_status::ready;
+}
+
+void Autosaver::waitForAutosave(Logger& logger)
+{
+  collectAutosave(logger, true);
+}
+
+void Autosaver::cancelAutosave(Logger& logger)
+{
+  if (m_pendingAutosave)
+  {
+    m_pendingAutosave->stopSource.request_stop();
+    collectAutosave(logger, true);
+  }
+}
+
+/**
+ * Reports the result of the pending autosave and releases its snapshot if the autosave
+ * has finished, waiting for it if requested. Returns true if no autosave is pending
+ * afterwards.
+ */
+bool Autosaver::collectAutosave(Logger& logger, const bool wait)
+{
+  if (!m_pendingAutosave)
+  {
+    return true;
+  }
+
+  if (!wait && autosaveInProgress())
+  {
+    return false;
+  }
+
+  auto pendingAutosave = std::move(*m_pendingAutosave);
+  m_pendingAutosave = std::nullopt;
+
+  pendingAutosave.result.get() | kdl::transform([&]() {
+    logger.info() << "Created autosave backup at " << pendingAutosave.backupFilePath;
+  }) | kdl::transform_error([&](auto e) {
+    logger.error() << "Aborting autosave: " << e.msg;
+  });
+
+  return true;
+}
+
 void Autosaver::autosave(Logger& logger, std::shared_ptr<MapDocument> document)
 {
   const auto& mapPath = document->path();
@@ -175,15 +336,46 @@ void Autosaver::autosave(Logger& logger, std::shared_ptr<MapDocument> document)
                           return fs.makeAbsolute(makeBackupName(mapBasename, backupNo));
                         });
              });
-  }) | kdl::transform([&](const auto& backupFilePath) {
+  }) | kdl::transform([&](auto backupFilePath) {
     m_lastSaveTime = Clock::now();
     m_lastModificationCount = document->modificationCount();
-    document->saveDocumentTo(backupFilePath);
 
-    logger.info() << "Created autosave backup at " << backupFilePath;
+    // copying the world is much cheaper than formatting it, so only the copy is made
+    // here and the document can be edited while the copy is being written
+    auto snapshot = std::unique_ptr<mdl::WorldNode>{static_cast<mdl::WorldNode*>(
+      document->world()->cloneRecursively(document->worldBounds()))};
+    releaseAssets(*snapshot);
+
+    auto progress = std::make_unique<std::atomic<float>>(0.0f);
+    auto stopSource = std::stop_source{};
+    auto& taskManager = document->taskManager();
+    auto result = taskManager.run_task([&taskManager,
+                                        backupFilePath,
+                                        gameName = document->game()->config().name,
+                                        snapshot = snapshot.get(),
+                                        progress = progress.get(),
+                                        stopToken = stopSource.get_token()]() {
+      return writeBackup(
+        backupFilePath, gameName, *snapshot, taskManager, *progress, stopToken);
+    });
+
+    logger.debug() << "Writing autosave backup to " << backupFilePath;
+    m_pendingAutosave = PendingAutosave{
+      std::move(backupFilePath),
+      std::move(snapshot),
+      std::move(progress),
+      std::move(stopSource),
+      std::move(result)};
   }) | kdl::transform_error([&](auto e) {
     logger.error() << "Aborting autosave: " << e.msg;
   });
 }
 
+void Autosaver::documentWillBeCleared(MapDocument*)
+{
+  // don't keep the UI waiting for a backup of a document that is being closed
+  auto logger = NullLogger{};
+  cancelAutosave(logger);
+}
+
 } // namespace tb::ui
@@ -19,17 +19,28 @@
 
 #pragma once
 
+#include "NotifierConnection.h"
+#include "Result.h"
 #include "io/PathMatcher.h"
 
+#include <atomic>
 #include <chrono>
 #include <filesystem>
+#include <future>
 #include <memory>
+#include <optional>
+#include <stop_token>
 
 namespace tb
 {
 class Logger;
 } // namespace tb
 
+namespace tb::mdl
+{
+class WorldNode;
+} // namespace tb::mdl
+
 namespace tb::ui
 {
 class Command;
@@ -65,16 +76,76 @@ private:
    */
   size_t m_lastModificationCount;
 
+  /**
+   * An autosave that is being written on a worker thread.
+   *
+   * The snapshot is a copy of the world taken when the autosave was started, without
+   * references to any assets. It is owned here rather than by the worker so that it is
+   * always destroyed on the calling thread.
+   *
+   * The worker stores the fraction of the snapshot that it has written in progress and
+   * stops writing as soon as it notices a stop request.
+   */
+  struct PendingAutosave
+  {
+    std::filesystem::path backupFilePath;
+    std::unique_ptr<mdl::WorldNode> snapshot;
+    std::unique_ptr<std::atomic<float>> progress;
+    std::stop_source stopSource;
+    std::future<Result<void>> result;
+  };
+
+  std::optional<PendingAutosave> m_pendingAutosave;
+
+  NotifierConnection m_notifierConnection;
+
 public:
   explicit Autosaver(
     std::weak_ptr<MapDocument> document,
     std::chrono::milliseconds saveInterval = std::chrono::milliseconds(10 * 60 * 1000),
     size_t maxBackups = 50);
+  ~Autosaver();
+
+  Autosaver(const Autosaver&) = delete;
+  Autosaver(Autosaver&&) = delete;
+
+  Autosaver& operator=(const Autosaver&) = delete;
+  Autosaver& operator=(Autosaver&&) = delete;
 
+  /**
+   * Starts a new autosave if the document was modified and the save interval has
+   * elapsed. The backup is written in the background; its result is reported to the
+   * given logger by a later call to this function or to waitForAutosave(). While the
+   * backup is being written, this function logs the progress of the autosave.
+   *
+   * No new autosave is started while another one is still being written.
+   */
   void triggerAutosave(Logger& logger);
 
+  /**
+   * Indicates whether an autosave is currently being written.
+   */
+  bool autosaveInProgress() const;
+
+  /**
+   * Blocks until the pending autosave, if any, has been written and reports its result
+   * to the given logger.
+   */
+  void waitForAutosave(Logger& logger);
+
+  /**
+   * Requests that the pending autosave, if any, be abandoned and waits for the worker
+   * to acknowledge. The worker checks for the request before writing each node, so this
+   * does not wait for the entire backup to be written. A cancelled autosave does not
+   * write a backup file.
+   */
+  void cancelAutosave(Logger& logger);
+
 private:
+  bool collectAutosave(Logger& logger, bool wait);
   void autosave(Logger& logger, std::shared_ptr<ui::MapDocument> document);
+
+  void documentWillBeCleared(MapDocument* document);
 };
 
 } // namespace tb::ui
@@ -48,7 +48,7 @@ std::unique_ptr<CommandResult> BrushVertexCommandBase::createCommandResult(
 }
 
 static auto collectBrushNodes(
-  const std::vector<std::pair<mdl::Node*, mdl::NodeContents>> nodes)
+  const std::vector<std::pair<mdl::Node*, mdl::NodeContentsDelta>>& nodes)
 {
   return nodes | std::views::filter([](const auto& pair) {
            return dynamic_cast<mdl::BrushNode*>(pair.first) != nullptr;
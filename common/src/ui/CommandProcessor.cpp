@@ -46,6 +46,16 @@ void notifyCommandIfNotType(T& notifier, C& command)
   }
 }
 
+size_t stackSizeInBytes(const std::vector<std::unique_ptr<UndoableCommand>>& commands)
+{
+  auto result = size_t(0);
+  for (const auto& command : commands)
+  {
+    result += command->sizeInBytes();
+  }
+  return result;
+}
+
 class TransactionCommand : public UndoableCommand
 {
 private:
@@ -131,6 +141,12 @@ private:
 
     return false;
   }
+
+public:
+  size_t sizeInBytes() const override
+  {
+    return UndoableCommand::sizeInBytes() + stackSizeInBytes(m_commands);
+  }
 };
 
 } // namespace
@@ -162,9 +178,12 @@ struct CommandProcessor::SubmitAndStoreResult
 };
 
 CommandProcessor::CommandProcessor(
-  MapDocumentCommandFacade& document, const std::chrono::milliseconds collationInterval)
+  MapDocumentCommandFacade& document,
+  const std::chrono::milliseconds collationInterval,
+  const std::optional<size_t> memoryBudget)
   : m_document{document}
   , m_collationInterval{collationInterval}
+  , m_memoryBudget{memoryBudget}
   , m_lastCommandTimestamp{std::chrono::time_point<std::chrono::system_clock>{}}
 {
 }
@@ -181,6 +200,25 @@ bool CommandProcessor::canRedo() const
   return m_transactionStack.empty() && !m_redoStack.empty();
 }
 
+size_t CommandProcessor::undoStackSizeInBytes() const
+{
+  return m_undoStackSizeInBytes;
+}
+
+size_t CommandProcessor::redoStackSizeInBytes() const
+{
+  return m_redoStackSizeInBytes;
+}
+
+void CommandProcessor::setMemoryBudget(const std::optional<size_t> memoryBudget)
+{
+  m_memoryBudget = memoryBudget;
+  if (m_transactionStack.empty())
+  {
+    trimUndoAndRedoStacks();
+  }
+}
+
 const std::string& CommandProcessor::undoCommandName() const
 {
   if (!canUndo())
@@ -246,7 +284,8 @@ std::unique_ptr<CommandResult> CommandProcessor::execute(std::unique_ptr<Command
   if (result->success())
   {
     m_undoStack.clear();
-    m_redoStack.clear();
+    m_undoStackSizeInBytes = 0;
+    clearRedoStack();
   }
   return result;
 }
@@ -304,7 +343,8 @@ void CommandProcessor::clear()
   assert(m_transactionStack.empty());
 
   m_undoStack.clear();
-  m_redoStack.clear();
+  m_undoStackSizeInBytes = 0;
+  clearRedoStack();
   m_lastCommandTimestamp = std::chrono::time_point<std::chrono::system_clock>();
 }
 
@@ -317,8 +357,9 @@ CommandProcessor::SubmitAndStoreResult CommandProcessor::executeAndStoreCommand(
     return {std::move(commandResult), false};
   }
 
+  // clear the redo stack first so that it doesn't count against the memory budget
+  clearRedoStack();
   const auto commandStored = storeCommand(std::move(command), collate);
-  m_redoStack.clear();
   return {std::move(commandResult), commandStored};
 }
 
@@ -435,13 +476,19 @@ bool CommandProcessor::pushToUndoStack(
   if (collatable(collate, timestamp))
   {
     auto& lastCommand = m_undoStack.back();
+    const auto lastCommandSizeInBytes = lastCommand->sizeInBytes();
     if (lastCommand->collateWith(*command))
     {
+      m_undoStackSizeInBytes += lastCommand->sizeInBytes();
+      m_undoStackSizeInBytes -= lastCommandSizeInBytes;
+      trimUndoAndRedoStacks();
       return false;
     }
   }
 
+  m_undoStackSizeInBytes += command->sizeInBytes();
   m_undoStack.push_back(std::move(command));
+  trimUndoAndRedoStacks();
   return true;
 }
 
@@ -450,6 +497,7 @@ std::unique_ptr<UndoableCommand> CommandProcessor::popFromUndoStack()
   assert(m_transactionStack.empty());
   assert(!m_undoStack.empty());
 
+  m_undoStackSizeInBytes -= m_undoStack.back()->sizeInBytes();
   return kdl::vec_pop_back(m_undoStack);
 }
 
@@ -463,6 +511,7 @@ bool CommandProcessor::collatable(
 void CommandProcessor::pushToRedoStack(std::unique_ptr<UndoableCommand> command)
 {
   assert(m_transactionStack.empty());
+  m_redoStackSizeInBytes += command->sizeInBytes();
   m_redoStack.push_back(std::move(command));
 }
 
@@ -471,7 +520,41 @@ std::unique_ptr<UndoableCommand> CommandProcessor::popFromRedoStack()
   assert(m_transactionStack.empty());
   assert(!m_redoStack.empty());
 
+  m_redoStackSizeInBytes -= m_redoStack.back()->sizeInBytes();
   return kdl::vec_pop_back(m_redoStack);
 }
 
+void CommandProcessor::clearRedoStack()
+{
+  m_redoStack.clear();
+  m_redoStackSizeInBytes = 0;
+}
+
+void CommandProcessor::trimUndoAndRedoStacks()
+{
+  assert(m_transactionStack.empty());
+
+  if (!m_memoryBudget)
+  {
+    return;
+  }
+
+  // the bottom of each stack holds the commands that are furthest from the current
+  // state, and the topmost command is always kept
+  const auto trimStack = [&](auto& stack, auto& stackSizeInBytes) {
+    auto count = size_t(0);
+    while (count + 1 < stack.size()
+           && m_undoStackSizeInBytes + m_redoStackSizeInBytes > *m_memoryBudget)
+    {
+      stackSizeInBytes -= stack[count]->sizeInBytes();
+      ++count;
+    }
+
+    stack.erase(stack.begin(), stack.begin() + static_cast<std::ptrdiff_t>(count));
+  };
+
+  trimStack(m_undoStack, m_undoStackSizeInBytes);
+  trimStack(m_redoStack, m_redoStackSizeInBytes);
+}
+
 } // namespace tb::ui
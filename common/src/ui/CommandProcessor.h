@@ -23,6 +23,7 @@
 
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -51,6 +52,12 @@ enum class TransactionScope;
  * The command processor supports nested transactions. Each transaction can be committed
  * or rolled back individually. Committing a nested transaction adds it as a command to
  * the containing transaction.
+ *
+ * The memory used by the commands on the undo and redo stacks can be limited by a
+ * memory budget. If the budget is exceeded, the oldest commands on the undo stack are
+ * discarded first, followed by the commands on the redo stack that are furthest from the
+ * current state. The most recently executed command and the next command to redo are
+ * always kept.
  */
 class CommandProcessor
 {
@@ -77,6 +84,19 @@ private:
    */
   std::vector<std::unique_ptr<UndoableCommand>> m_redoStack;
 
+  /**
+   * The maximum memory in bytes that the commands on the undo and redo stacks may use,
+   * or nullopt if the memory is not limited.
+   */
+  std::optional<size_t> m_memoryBudget;
+
+  /**
+   * The memory used by the commands on the undo and redo stacks, as estimated by the
+   * commands when they were pushed.
+   */
+  size_t m_undoStackSizeInBytes = 0;
+  size_t m_redoStackSizeInBytes = 0;
+
   /**
    * The time stamp of when the last command was executed.
    */
@@ -97,10 +117,14 @@ public:
    * they are executed or undone.
    *
    * @param document the document to pass to commands, may be null
+   * @param collationInterval the time after which commands are no longer collated
+   * @param memoryBudget the memory budget for the undo and redo stacks in bytes, or
+   * nullopt if their memory should not be limited
    */
   explicit CommandProcessor(
     MapDocumentCommandFacade& document,
-    std::chrono::milliseconds collationInterval = std::chrono::milliseconds{1000});
+    std::chrono::milliseconds collationInterval = std::chrono::milliseconds{1000},
+    std::optional<size_t> memoryBudget = std::nullopt);
 
   ~CommandProcessor();
 
@@ -153,6 +177,25 @@ public:
    */
   bool canRedo() const;
 
+  /**
+   * Returns an estimate of the memory used by the commands on the undo stack in bytes.
+   */
+  size_t undoStackSizeInBytes() const;
+
+  /**
+   * Returns an estimate of the memory used by the commands on the redo stack in bytes.
+   */
+  size_t redoStackSizeInBytes() const;
+
+  /**
+   * Sets the memory budget for the undo and redo stacks in bytes. If the given budget is
+   * exceeded and no transaction is currently executing, the stacks are trimmed
+   * immediately.
+   *
+   * @param memoryBudget the budget, or nullopt if the memory should not be limited
+   */
+  void setMemoryBudget(std::optional<size_t> memoryBudget);
+
   /**
    * Returns the name of the command that will be undone when calling `undo`.
    *
@@ -388,6 +431,18 @@ private:
    * @return the topmost command of the redo stack
    */
   std::unique_ptr<UndoableCommand> popFromRedoStack();
+
+  /**
+   * Clears the redo stack.
+   */
+  void clearRedoStack();
+
+  /**
+   * Discards the oldest commands on the undo stack and then the furthest commands on the
+   * redo stack until the memory used by both stacks no longer exceeds the memory budget.
+   * The topmost command of each stack is never discarded.
+   */
+  void trimUndoAndRedoStacks();
 };
 
 } // namespace tb::ui
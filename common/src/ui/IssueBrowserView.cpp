@@ -25,6 +25,7 @@
 #include <QMenu>
 #include <QTableView>
 
+#include "Logger.h"
 #include "mdl/BrushNode.h"
 #include "mdl/EntityNode.h"
 #include "mdl/GroupNode.h"
@@ -32,6 +33,7 @@
 #include "mdl/IssueQuickFix.h"
 #include "mdl/LayerNode.h"
 #include "mdl/PatchNode.h"
+#include "mdl/Validator.h"
 #include "mdl/WorldNode.h"
 #include "ui/MapDocument.h"
 #include "ui/QtUtils.h"
@@ -42,10 +44,33 @@
 #include "kdl/vector_set.h"
 #include "kdl/vector_utils.h"
 
+#include <chrono>
 #include <vector>
 
 namespace tb::ui
 {
+namespace
+{
+
+void logValidationTimes(
+  Logger& logger, const std::vector<mdl::ValidationTime>& validationTimes)
+{
+  using namespace std::chrono_literals;
+
+  for (const auto& validationTime : validationTimes)
+  {
+    if (validationTime.time >= 1ms)
+    {
+      logger.debug() << "Validator '" << validationTime.description << "' took "
+                     << std::chrono::duration_cast<std::chrono::milliseconds>(
+                          validationTime.time)
+                          .count()
+                     << "ms";
+    }
+  }
+}
+
+} // namespace
 
 IssueBrowserView::IssueBrowserView(std::weak_ptr<MapDocument> document, QWidget* parent)
   : QWidget{parent}
@@ -131,6 +156,11 @@ void IssueBrowserView::updateIssues()
   auto document = kdl::mem_lock(m_document);
   if (document->world() != nullptr)
   {
+    // validate all invalid nodes in parallel before collecting the issues
+    logValidationTimes(
+      document->logger(),
+      document->world()->validateAllIssues(document->taskManager()));
+
     const auto validators = document->world()->registeredValidators();
 
     auto issues = std::vector<const mdl::Issue*>{};
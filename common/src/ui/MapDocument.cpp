@@ -20,6 +20,7 @@
 #include "ui/MapDocument.h"
 
 #include "Exceptions.h"
+#include "InternedString.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Uuid.h"
@@ -2517,6 +2518,37 @@ void MapDocument::setHasPendingChanges(
   }
 }
 
+void MapDocument::setHasPendingChanges(
+  const std::vector<mdl::GroupNode*>& groupNodes,
+  const std::vector<mdl::Node*>& changedNodes)
+{
+  auto changedNodesByGroup =
+    std::unordered_map<mdl::GroupNode*, std::vector<mdl::Node*>>{};
+  for (auto* changedNode : changedNodes)
+  {
+    // record the node for every containing group so that outer linked groups only update
+    // the changed nodes of their nested groups, too
+    for (auto* groupNode = mdl::findContainingGroup(changedNode); groupNode;
+         groupNode = mdl::findContainingGroup(groupNode))
+    {
+      changedNodesByGroup[groupNode].push_back(changedNode);
+    }
+  }
+
+  for (auto* groupNode : groupNodes)
+  {
+    if (const auto it = changedNodesByGroup.find(groupNode);
+        it != changedNodesByGroup.end())
+    {
+      groupNode->addPendingChangedNodes(it->second);
+    }
+    else
+    {
+      groupNode->setHasPendingChanges(true);
+    }
+  }
+}
+
 static std::vector<mdl::GroupNode*> collectGroupsWithPendingChanges(mdl::Node& node)
 {
   auto result = std::vector<mdl::GroupNode*>{};
@@ -2549,9 +2581,10 @@ bool MapDocument::updateLinkedGroups()
     if (const auto allChangedLinkedGroups = collectGroupsWithPendingChanges(*m_world);
         !allChangedLinkedGroups.empty())
     {
+      // the command captures the changed nodes recorded in the groups
+      auto command = std::make_unique<UpdateLinkedGroupsCommand>(allChangedLinkedGroups);
       setHasPendingChanges(allChangedLinkedGroups, false);
 
-      auto command = std::make_unique<UpdateLinkedGroupsCommand>(allChangedLinkedGroups);
       const auto result = executeAndStore(std::move(command));
       return result->success();
     }
@@ -3011,6 +3044,9 @@ bool MapDocument::swapNodeContents(
     return false;
   }
 
+  const auto changedNodes =
+    kdl::vec_transform(nodesToSwap, [](const auto& p) { return p.first; });
+
   auto transaction = Transaction{*this};
   const auto result = executeAndStore(
     std::make_unique<SwapNodeContentsCommand>(commandName, std::move(nodesToSwap)));
@@ -3021,7 +3057,7 @@ bool MapDocument::swapNodeContents(
     return false;
   }
 
-  setHasPendingChanges(changedLinkedGroups, true);
+  setHasPendingChanges(changedLinkedGroups, changedNodes);
   return transaction.commit();
 }
 
@@ -3995,8 +4031,9 @@ MapDocument::MoveVerticesResult MapDocument::moveVertices(
       kdl::str_plural(vertexPositions.size(), "Move Brush Vertex", "Move Brush Vertices");
     auto transaction = Transaction{*this, commandName};
 
-    const auto changedLinkedGroups = collectContainingGroups(
-      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; }));
+    const auto changedNodes =
+      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; });
+    const auto changedLinkedGroups = collectContainingGroups(changedNodes);
 
     const auto result = executeAndStore(std::make_unique<BrushVertexCommand>(
       commandName,
@@ -4010,7 +4047,7 @@ MapDocument::MoveVerticesResult MapDocument::moveVertices(
       return MoveVerticesResult{false, false};
     }
 
-    setHasPendingChanges(changedLinkedGroups, true);
+    setHasPendingChanges(changedLinkedGroups, changedNodes);
 
     if (!transaction.commit())
     {
@@ -4075,8 +4112,9 @@ bool MapDocument::moveEdges(
       kdl::str_plural(edgePositions.size(), "Move Brush Edge", "Move Brush Edges");
     auto transaction = Transaction{*this, commandName};
 
-    const auto changedLinkedGroups = collectContainingGroups(
-      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; }));
+    const auto changedNodes =
+      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; });
+    const auto changedLinkedGroups = collectContainingGroups(changedNodes);
 
     const auto result = executeAndStore(std::make_unique<BrushEdgeCommand>(
       commandName,
@@ -4090,7 +4128,7 @@ bool MapDocument::moveEdges(
       return false;
     }
 
-    setHasPendingChanges(changedLinkedGroups, true);
+    setHasPendingChanges(changedLinkedGroups, changedNodes);
     return transaction.commit();
   }
 
@@ -4143,8 +4181,9 @@ bool MapDocument::moveFaces(
       kdl::str_plural(facePositions.size(), "Move Brush Face", "Move Brush Faces");
     auto transaction = Transaction{*this, commandName};
 
-    auto changedLinkedGroups = collectContainingGroups(
-      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; }));
+    const auto changedNodes =
+      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; });
+    const auto changedLinkedGroups = collectContainingGroups(changedNodes);
 
     const auto result = executeAndStore(std::make_unique<BrushFaceCommand>(
       commandName,
@@ -4158,7 +4197,7 @@ bool MapDocument::moveFaces(
       return false;
     }
 
-    setHasPendingChanges(changedLinkedGroups, true);
+    setHasPendingChanges(changedLinkedGroups, changedNodes);
     return transaction.commit();
   }
 
@@ -4191,8 +4230,9 @@ bool MapDocument::addVertex(const vm::vec3d& vertexPosition)
     const auto commandName = "Add Brush Vertex";
     auto transaction = Transaction{*this, commandName};
 
-    const auto changedLinkedGroups = collectContainingGroups(
-      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; }));
+    const auto changedNodes =
+      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; });
+    const auto changedLinkedGroups = collectContainingGroups(changedNodes);
 
     const auto result = executeAndStore(std::make_unique<BrushVertexCommand>(
       commandName,
@@ -4206,7 +4246,7 @@ bool MapDocument::addVertex(const vm::vec3d& vertexPosition)
       return false;
     }
 
-    setHasPendingChanges(changedLinkedGroups, true);
+    setHasPendingChanges(changedLinkedGroups, changedNodes);
     return transaction.commit();
   }
 
@@ -4246,8 +4286,9 @@ bool MapDocument::removeVertices(
   {
     auto transaction = Transaction{*this, commandName};
 
-    auto changedLinkedGroups = collectContainingGroups(
-      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; }));
+    const auto changedNodes =
+      kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; });
+    const auto changedLinkedGroups = collectContainingGroups(changedNodes);
 
     const auto result = executeAndStore(std::make_unique<BrushVertexCommand>(
       commandName,
@@ -4261,7 +4302,7 @@ bool MapDocument::removeVertices(
       return false;
     }
 
-    setHasPendingChanges(changedLinkedGroups, true);
+    setHasPendingChanges(changedLinkedGroups, changedNodes);
     return transaction.commit();
   }
 
@@ -4440,6 +4481,8 @@ std::unique_ptr<CommandResult> MapDocument::executeAndStore(
 
 void MapDocument::processResourcesSync(const mdl::ProcessContext& processContext)
 {
+  m_resourceManager->requestReleaseCheck();
+
   auto allProcessedResourceIds = std::vector<mdl::ResourceId>{};
   while (m_resourceManager->needsProcessing())
   {
@@ -4727,7 +4770,11 @@ void MapDocument::unloadMaterials()
   m_materialManager->clear();
 }
 
-static auto makeSetMaterialsVisitor(mdl::MaterialManager& manager)
+// Material names are interned, so hashing and comparing them is cheap. This lets us look
+// up each material name only once.
+using MaterialCache = std::unordered_map<InternedString, mdl::Material*>;
+
+static auto makeSetMaterialsVisitor(mdl::MaterialManager& manager, MaterialCache& cache)
 {
   return kdl::overload(
     [](auto&& thisLambda, mdl::WorldNode* world) { world->visitChildren(thisLambda); },
@@ -4738,9 +4785,13 @@ static auto makeSetMaterialsVisitor(mdl::MaterialManager& manager)
       const mdl::Brush& brush = brushNode->brush();
       for (size_t i = 0u; i < brush.faceCount(); ++i)
       {
-        const mdl::BrushFace& face = brush.face(i);
-        mdl::Material* material = manager.material(face.attributes().materialName());
-        brushNode->setFaceMaterial(i, material);
+        const auto& materialName = brush.face(i).attributes().internedMaterialName();
+        auto [it, inserted] = cache.try_emplace(materialName, nullptr);
+        if (inserted)
+        {
+          it->second = manager.material(materialName.str());
+        }
+        brushNode->setFaceMaterial(i, it->second);
       }
     },
     [&](mdl::PatchNode* patchNode) {
@@ -4768,13 +4819,15 @@ static auto makeUnsetMaterialsVisitor()
 
 void MapDocument::setMaterials()
 {
-  m_world->accept(makeSetMaterialsVisitor(*m_materialManager));
+  auto cache = MaterialCache{};
+  m_world->accept(makeSetMaterialsVisitor(*m_materialManager, cache));
   materialUsageCountsDidChangeNotifier();
 }
 
 void MapDocument::setMaterials(const std::vector<mdl::Node*>& nodes)
 {
-  mdl::Node::visitAll(nodes, makeSetMaterialsVisitor(*m_materialManager));
+  auto cache = MaterialCache{};
+  mdl::Node::visitAll(nodes, makeSetMaterialsVisitor(*m_materialManager, cache));
   materialUsageCountsDidChangeNotifier();
 }
 
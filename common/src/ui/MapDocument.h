@@ -511,6 +511,15 @@ public:
 protected:
   void setHasPendingChanges(
     const std::vector<mdl::GroupNode*>& groupNodes, bool hasPendingChanges);
+  /**
+   * Marks the given groups as changed, recording which of their nodes had their contents
+   * changed so that only these nodes are propagated to the linked groups. A node is
+   * recorded for each of its containing groups, not just the innermost one. Groups that
+   * do not contain any of the given nodes are marked as changed entirely.
+   */
+  void setHasPendingChanges(
+    const std::vector<mdl::GroupNode*>& groupNodes,
+    const std::vector<mdl::Node*>& changedNodes);
   bool updateLinkedGroups();
 
 private:
@@ -20,6 +20,8 @@
 #include "MapDocumentCommandFacade.h"
 
 #include "Ensure.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
 #include "mdl/Brush.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
@@ -48,6 +50,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -68,6 +71,13 @@ std::vector<mdl::Node*> collectOldChildren(
   return result;
 }
 
+std::optional<size_t> undoMemoryBudget()
+{
+  const auto megabytes = pref(Preferences::UndoMemoryBudget);
+  return megabytes > 0 ? std::optional{size_t(megabytes) * 1024u * 1024u}
+                       : std::nullopt;
+}
+
 } // namespace
 
 std::shared_ptr<MapDocument> MapDocumentCommandFacade::newMapDocument(
@@ -79,7 +89,8 @@ std::shared_ptr<MapDocument> MapDocumentCommandFacade::newMapDocument(
 
 MapDocumentCommandFacade::MapDocumentCommandFacade(kdl::task_manager& taskManager)
   : MapDocument{taskManager}
-  , m_commandProcessor{std::make_unique<CommandProcessor>(*this)}
+  , m_commandProcessor{std::make_unique<CommandProcessor>(
+      *this, std::chrono::milliseconds{1000}, undoMemoryBudget())}
 {
   connectObservers();
 }
@@ -425,36 +436,41 @@ void MapDocumentCommandFacade::performSwapNodeContents(
   auto notifyMods =
     NotifyBeforeAndAfter{notifyModsChange, modsWillChangeNotifier, modsDidChangeNotifier};
 
-  for (auto& pair : nodesToSwap)
   {
-    auto* node = pair.first;
-    auto& contents = pair.second.get();
-
-    pair.second = node->accept(kdl::overload(
-      [&](mdl::WorldNode* worldNode) {
-        return mdl::NodeContents{
-          worldNode->setEntity(std::get<mdl::Entity>(std::move(contents)))};
-      },
-      [&](mdl::LayerNode* layerNode) {
-        return mdl::NodeContents(
-          layerNode->setLayer(std::get<mdl::Layer>(std::move(contents))));
-      },
-      [&](mdl::GroupNode* groupNode) {
-        return mdl::NodeContents{
-          groupNode->setGroup(std::get<mdl::Group>(std::move(contents)))};
-      },
-      [&](mdl::EntityNode* entityNode) {
-        return mdl::NodeContents{
-          entityNode->setEntity(std::get<mdl::Entity>(std::move(contents)))};
-      },
-      [&](mdl::BrushNode* brushNode) {
-        return mdl::NodeContents{
-          brushNode->setBrush(std::get<mdl::Brush>(std::move(contents)))};
-      },
-      [&](mdl::PatchNode* patchNode) {
-        return mdl::NodeContents{
-          patchNode->setPatch(std::get<mdl::BezierPatch>(std::move(contents)))};
-      }));
+    // the node tree is updated once for all nodes whose bounds changed
+    const auto deferNodeTreeUpdates = mdl::DeferNodeTreeUpdates{*m_world};
+
+    for (auto& pair : nodesToSwap)
+    {
+      auto* node = pair.first;
+      auto& contents = pair.second.get();
+
+      pair.second = node->accept(kdl::overload(
+        [&](mdl::WorldNode* worldNode) {
+          return mdl::NodeContents{
+            worldNode->setEntity(std::get<mdl::Entity>(std::move(contents)))};
+        },
+        [&](mdl::LayerNode* layerNode) {
+          return mdl::NodeContents(
+            layerNode->setLayer(std::get<mdl::Layer>(std::move(contents))));
+        },
+        [&](mdl::GroupNode* groupNode) {
+          return mdl::NodeContents{
+            groupNode->setGroup(std::get<mdl::Group>(std::move(contents)))};
+        },
+        [&](mdl::EntityNode* entityNode) {
+          return mdl::NodeContents{
+            entityNode->setEntity(std::get<mdl::Entity>(std::move(contents)))};
+        },
+        [&](mdl::BrushNode* brushNode) {
+          return mdl::NodeContents{
+            brushNode->setBrush(std::get<mdl::Brush>(std::move(contents)))};
+        },
+        [&](mdl::PatchNode* patchNode) {
+          return mdl::NodeContents{
+            patchNode->setPatch(std::get<mdl::BezierPatch>(std::move(contents)))};
+        }));
+    }
   }
 
   if (!notifyEntityDefinitionsChange && !notifyModsChange)
@@ -624,6 +640,19 @@ void MapDocumentCommandFacade::connectObservers()
     m_commandProcessor->transactionDoneNotifier.connect(transactionDoneNotifier);
   m_notifierConnection +=
     m_commandProcessor->transactionUndoneNotifier.connect(transactionUndoneNotifier);
+
+  auto& prefs = PreferenceManager::instance();
+  m_notifierConnection += prefs.preferenceDidChangeNotifier.connect(
+    this, &MapDocumentCommandFacade::undoMemoryBudgetDidChange);
+}
+
+void MapDocumentCommandFacade::undoMemoryBudgetDidChange(
+  const std::filesystem::path& path)
+{
+  if (path == Preferences::UndoMemoryBudget.path())
+  {
+    m_commandProcessor->setMemoryBudget(undoMemoryBudget());
+  }
 }
 
 bool MapDocumentCommandFacade::isCurrentDocumentStateObservable() const
@@ -23,6 +23,7 @@
 #include "mdl/NodeContents.h"
 #include "ui/MapDocument.h"
 
+#include <filesystem>
 #include <map>
 #include <memory>
 #include <string>
@@ -113,6 +114,7 @@ public: // modification count
 
 private: // notification
   void connectObservers();
+  void undoMemoryBudgetDidChange(const std::filesystem::path& path);
   void documentWasNewed(MapDocument* document);
   void documentWasLoaded(MapDocument* document);
 
@@ -187,6 +187,7 @@ MapFrame::~MapFrame()
   // let's trigger a final autosave before releasing the document
   auto logger = NullLogger{};
   m_autosaver->triggerAutosave(logger);
+  m_autosaver->waitForAutosave(logger);
 
   m_document->setViewEffectsService(nullptr);
   m_document.reset();
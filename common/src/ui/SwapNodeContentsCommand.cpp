@@ -24,14 +24,29 @@
 
 #include "kdl/vector_utils.h"
 
+#include <unordered_map>
+
 namespace tb::ui
 {
+namespace
+{
+
+auto createDeltas(std::vector<std::pair<mdl::Node*, mdl::NodeContents>> nodes)
+{
+  return kdl::vec_transform(std::move(nodes), [](auto pair) {
+    return std::pair{
+      pair.first, mdl::NodeContentsDelta{std::move(pair.second), *pair.first}};
+  });
+}
+
+} // namespace
 
 SwapNodeContentsCommand::SwapNodeContentsCommand(
   std::string name, std::vector<std::pair<mdl::Node*, mdl::NodeContents>> nodes)
   : UpdateLinkedGroupsCommandBase{std::move(name), true}
-  , m_nodes{std::move(nodes)}
+  , m_nodes{createDeltas(std::move(nodes))}
 {
+  updateSizeInBytes();
 }
 
 SwapNodeContentsCommand::~SwapNodeContentsCommand() = default;
@@ -39,14 +54,14 @@ SwapNodeContentsCommand::~SwapNodeContentsCommand() = default;
 std::unique_ptr<CommandResult> SwapNodeContentsCommand::doPerformDo(
   MapDocumentCommandFacade& document)
 {
-  document.performSwapNodeContents(m_nodes);
+  swapNodeContents(document);
   return std::make_unique<CommandResult>(true);
 }
 
 std::unique_ptr<CommandResult> SwapNodeContentsCommand::doPerformUndo(
   MapDocumentCommandFacade& document)
 {
-  document.performSwapNodeContents(m_nodes);
+  swapNodeContents(document);
   return std::make_unique<CommandResult>(true);
 }
 
@@ -62,10 +77,57 @@ bool SwapNodeContentsCommand::doCollateWith(UndoableCommand& command)
     kdl::vec_sort(myNodes);
     kdl::vec_sort(theirNodes);
 
-    return myNodes == theirNodes;
+    if (myNodes != theirNodes)
+    {
+      return false;
+    }
+
+    // Our deltas are relative to the node contents before the other command was
+    // executed, so we rebase them onto the current node contents.
+    auto theirDeltas = std::unordered_map<mdl::Node*, mdl::NodeContentsDelta*>{};
+    for (auto& [node, delta] : other->m_nodes)
+    {
+      theirDeltas.emplace(node, &delta);
+    }
+
+    for (auto& [node, delta] : m_nodes)
+    {
+      const auto intermediateContents = std::move(*theirDeltas.at(node)).restore(*node);
+      auto contents = std::move(delta).restore(intermediateContents);
+      delta = mdl::NodeContentsDelta{std::move(contents), *node};
+    }
+
+    updateSizeInBytes();
+    return true;
   }
 
   return false;
 }
 
+size_t SwapNodeContentsCommand::sizeInBytes() const
+{
+  return UpdateLinkedGroupsCommandBase::sizeInBytes() + m_sizeInBytes;
+}
+
+void SwapNodeContentsCommand::swapNodeContents(MapDocumentCommandFacade& document)
+{
+  auto nodesToSwap = kdl::vec_transform(std::move(m_nodes), [](auto pair) {
+    return std::pair{pair.first, std::move(pair.second).restore(*pair.first)};
+  });
+
+  document.performSwapNodeContents(nodesToSwap);
+
+  m_nodes = createDeltas(std::move(nodesToSwap));
+  updateSizeInBytes();
+}
+
+void SwapNodeContentsCommand::updateSizeInBytes()
+{
+  m_sizeInBytes = 0;
+  for (const auto& [node, delta] : m_nodes)
+  {
+    m_sizeInBytes += sizeof(node) + delta.sizeInBytes();
+  }
+}
+
 } // namespace tb::ui
@@ -21,6 +21,7 @@
 
 #include "Macros.h"
 #include "mdl/NodeContents.h"
+#include "mdl/NodeContentsDelta.h"
 #include "ui/UpdateLinkedGroupsCommandBase.h"
 
 #include <memory>
@@ -35,10 +36,21 @@ class Node;
 namespace tb::ui
 {
 
+/**
+ * Swaps the contents of the given nodes with the given contents.
+ *
+ * To save memory, the stored contents are kept as deltas relative to the current
+ * contents of the nodes. These deltas remain valid because the command is only ever
+ * undone or redone when the nodes have the contents they had after it was executed or
+ * undone, respectively.
+ */
 class SwapNodeContentsCommand : public UpdateLinkedGroupsCommandBase
 {
 protected:
-  std::vector<std::pair<mdl::Node*, mdl::NodeContents>> m_nodes;
+  std::vector<std::pair<mdl::Node*, mdl::NodeContentsDelta>> m_nodes;
+
+private:
+  size_t m_sizeInBytes = 0;
 
 public:
   SwapNodeContentsCommand(
@@ -51,6 +63,12 @@ public:
 
   bool doCollateWith(UndoableCommand& command) override;
 
+  size_t sizeInBytes() const override;
+
+private:
+  void swapNodeContents(MapDocumentCommandFacade& document);
+  void updateSizeInBytes();
+
   deleteCopyAndMove(SwapNodeContentsCommand);
 };
 
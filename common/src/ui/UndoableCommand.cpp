@@ -78,6 +78,11 @@ bool UndoableCommand::doCollateWith(UndoableCommand&)
   return false;
 }
 
+size_t UndoableCommand::sizeInBytes() const
+{
+  return sizeof(UndoableCommand) + name().capacity();
+}
+
 void UndoableCommand::setModificationCount(MapDocumentCommandFacade& document) const
 {
   if (m_modificationCount)
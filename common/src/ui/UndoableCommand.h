@@ -45,6 +45,12 @@ public:
 
   virtual bool collateWith(UndoableCommand& command);
 
+  /**
+   * Returns an estimate of the memory used by this command in bytes, including any
+   * state it keeps for undo and redo.
+   */
+  virtual size_t sizeInBytes() const;
+
 protected:
   virtual std::unique_ptr<CommandResult> doPerformUndo(
     MapDocumentCommandFacade& document) = 0;
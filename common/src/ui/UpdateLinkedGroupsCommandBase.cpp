@@ -101,4 +101,9 @@ bool UpdateLinkedGroupsCommandBase::collateWith(UndoableCommand& command)
   return false;
 }
 
+size_t UpdateLinkedGroupsCommandBase::sizeInBytes() const
+{
+  return UndoableCommand::sizeInBytes() + m_updateLinkedGroupsHelper.sizeInBytes();
+}
+
 } // namespace tb::ui
@@ -49,6 +49,8 @@ public:
 
   bool collateWith(UndoableCommand& command) override;
 
+  size_t sizeInBytes() const override;
+
 private:
   deleteCopyAndMove(UpdateLinkedGroupsCommandBase);
 };
@@ -60,8 +60,12 @@ bool checkLinkedGroupsToUpdate(const std::vector<mdl::GroupNode*>& changedLinked
 }
 
 UpdateLinkedGroupsHelper::UpdateLinkedGroupsHelper(
-  ChangedLinkedGroups changedLinkedGroups)
-  : m_state{kdl::vec_sort(std::move(changedLinkedGroups), compareByAncestry)}
+  std::vector<mdl::GroupNode*> changedLinkedGroups)
+  : m_state{kdl::vec_transform(
+      kdl::vec_sort(std::move(changedLinkedGroups), compareByAncestry),
+      [](auto* groupNode) {
+        return ChangedLinkedGroup{groupNode, groupNode->pendingChangedNodes()};
+      })}
 {
 }
 
@@ -71,47 +75,131 @@ Result<void> UpdateLinkedGroupsHelper::applyLinkedGroupUpdates(
   MapDocumentCommandFacade& document)
 {
   return computeLinkedGroupUpdates(document)
-         | kdl::transform([&]() { doApplyOrUndoLinkedGroupUpdates(document); });
+         | kdl::transform([&]() { doApplyLinkedGroupUpdates(document); });
 }
 
 void UpdateLinkedGroupsHelper::undoLinkedGroupUpdates(MapDocumentCommandFacade& document)
 {
-  doApplyOrUndoLinkedGroupUpdates(document);
+  doUndoLinkedGroupUpdates(document);
 }
 
 void UpdateLinkedGroupsHelper::collateWith(UpdateLinkedGroupsHelper& other)
 {
   // Both helpers have already applied their changes at this point, so in both helpers,
-  // m_linkedGroups contains pairs p where
-  // - p.first is the group node to update
-  // - p.second is a vector containing the group node's original children
+  // m_state contains updates u where
+  // - u.replacedChildren contains pairs p where p.first is a group node whose children
+  //   were replaced and p.second is a vector containing the group node's original
+  //   children
+  // - u.swappedContents contains pairs p where p.first is a node whose contents were
+  //   swapped and p.second is the node's original contents
   //
-  // Let p_o be an update from the other helper. If p_o is an update for a linked group
-  // node that was updated by this helper, then there is a pair p_t in this helper such
-  // that p_t.first == p_o.first. In this case, we want to keep the old children of the
-  // linked group node stored in this helper and discard those in the other helper. If
-  // p_o is not an update for a linked group node that was updated by this helper, then
-  // we will add p_o to our updates and remove it from the other helper's updates to
-  // prevent the replaced node to be deleted with the other helper.
+  // If the other helper replaced the children of a group node or swapped the contents of
+  // a node which was also updated by this helper, then we want to keep the original
+  // children or contents stored in this helper and discard those in the other helper.
+  // Any contents the other helper swapped into the discarded children must be discarded,
+  // too, because those children will be deleted with the other helper. All other updates
+  // are moved from the other helper to this helper. They are appended to this helper's
+  // updates, so that they are undone before this helper's updates are undone.
 
   auto& myLinkedGroupUpdates = std::get<LinkedGroupUpdates>(m_state);
   auto& theirLinkedGroupUpdates = std::get<LinkedGroupUpdates>(other.m_state);
 
-  for (auto& [theirGroupNodeToUpdate_, theirOldChildren] : theirLinkedGroupUpdates)
+  auto myReplacedNodes = std::unordered_set<const mdl::Node*>{};
+  auto mySwappedNodes = std::unordered_set<const mdl::Node*>{};
+  for (const auto& myLinkedGroupUpdate : myLinkedGroupUpdates)
   {
-    const auto myIt = std::ranges::find_if(
-      myLinkedGroupUpdates,
-      [theirGroupNodeToUpdate = theirGroupNodeToUpdate_](const auto& p) {
-        return p.first == theirGroupNodeToUpdate;
-      });
-    if (myIt == std::end(myLinkedGroupUpdates))
+    for (const auto& [node, oldChildren] : myLinkedGroupUpdate.replacedChildren)
     {
-      myLinkedGroupUpdates.emplace_back(
-        theirGroupNodeToUpdate_, std::move(theirOldChildren));
+      myReplacedNodes.insert(node);
+    }
+    for (const auto& [node, oldContents] : myLinkedGroupUpdate.swappedContents)
+    {
+      mySwappedNodes.insert(node);
+    }
+  }
+
+  auto discardedNodes = std::unordered_set<const mdl::Node*>{};
+  const auto isDiscarded = [&](const mdl::Node* node) {
+    for (; node != nullptr; node = node->parent())
+    {
+      if (discardedNodes.contains(node))
+      {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  for (auto& theirLinkedGroupUpdate : theirLinkedGroupUpdates)
+  {
+    auto linkedGroupUpdate = mdl::IncrementalUpdateLinkedGroupsResult{};
+
+    for (auto& [node, theirOldChildren] : theirLinkedGroupUpdate.replacedChildren)
+    {
+      if (myReplacedNodes.contains(node))
+      {
+        for (const auto& child : theirOldChildren)
+        {
+          discardedNodes.insert(child.get());
+        }
+      }
+      else
+      {
+        linkedGroupUpdate.replacedChildren.emplace_back(
+          node, std::move(theirOldChildren));
+      }
+    }
+
+    for (auto& [node, theirOldContents] : theirLinkedGroupUpdate.swappedContents)
+    {
+      if (!mySwappedNodes.contains(node) && !isDiscarded(node))
+      {
+        linkedGroupUpdate.swappedContents.emplace_back(node, std::move(theirOldContents));
+      }
+    }
+
+    if (
+      !linkedGroupUpdate.replacedChildren.empty()
+      || !linkedGroupUpdate.swappedContents.empty())
+    {
+      myLinkedGroupUpdates.push_back(std::move(linkedGroupUpdate));
     }
   }
 }
 
+size_t UpdateLinkedGroupsHelper::sizeInBytes() const
+{
+  return std::visit(
+    kdl::overload(
+      [](const ChangedLinkedGroups& changedLinkedGroups) {
+        auto result = size_t(0);
+        for (const auto& changedLinkedGroup : changedLinkedGroups)
+        {
+          result += sizeof(changedLinkedGroup)
+                    + changedLinkedGroup.changedNodes.size() * sizeof(mdl::Node*);
+        }
+        return result;
+      },
+      [](const LinkedGroupUpdates& linkedGroupUpdates) {
+        auto result = size_t(0);
+        for (const auto& linkedGroupUpdate : linkedGroupUpdates)
+        {
+          for (const auto& [groupNode, children] : linkedGroupUpdate.replacedChildren)
+          {
+            result += sizeof(groupNode)
+                      + mdl::computeSizeInBytes(kdl::vec_transform(
+                        children, [](const auto& child) { return child.get(); }));
+          }
+          for (const auto& [node, contents] : linkedGroupUpdate.swappedContents)
+          {
+            result += sizeof(node) + contents.sizeInBytes();
+          }
+        }
+        return result;
+      }),
+    m_state);
+}
+
 Result<void> UpdateLinkedGroupsHelper::computeLinkedGroupUpdates(
   MapDocumentCommandFacade& document)
 {
@@ -132,36 +220,64 @@ Result<UpdateLinkedGroupsHelper::LinkedGroupUpdates> UpdateLinkedGroupsHelper::
   computeLinkedGroupUpdates(
     const ChangedLinkedGroups& changedLinkedGroups, MapDocumentCommandFacade& document)
 {
-  if (!checkLinkedGroupsToUpdate(changedLinkedGroups))
+  if (!checkLinkedGroupsToUpdate(kdl::vec_transform(
+        changedLinkedGroups,
+        [](const auto& changedLinkedGroup) { return changedLinkedGroup.groupNode; })))
   {
     return Error{"Cannot update multiple members of the same link set"};
   }
 
   const auto& worldBounds = document.worldBounds();
-  return changedLinkedGroups | std::views::transform([&](const auto* groupNode) {
+  return changedLinkedGroups | std::views::transform([&](const auto& changedLinkedGroup) {
+           const auto* groupNode = changedLinkedGroup.groupNode;
            const auto groupNodesToUpdate = kdl::vec_erase(
              mdl::collectGroupsWithLinkId({document.world()}, groupNode->linkId()),
              groupNode);
 
-           return mdl::updateLinkedGroups(
-             *groupNode, groupNodesToUpdate, worldBounds, document.taskManager());
+           return mdl::updateLinkedGroupsIncrementally(
+             *groupNode,
+             changedLinkedGroup.changedNodes,
+             groupNodesToUpdate,
+             worldBounds,
+             document.taskManager());
          })
-         | kdl::fold
-         | kdl::and_then([&](auto nestedUpdateLists) -> Result<LinkedGroupUpdates> {
-             return kdl::vec_flatten(std::move(nestedUpdateLists));
-           });
+         | kdl::fold;
 }
 
-void UpdateLinkedGroupsHelper::doApplyOrUndoLinkedGroupUpdates(
+void UpdateLinkedGroupsHelper::doApplyLinkedGroupUpdates(
   MapDocumentCommandFacade& document)
 {
-  std::visit(
-    kdl::overload(
-      [](const ChangedLinkedGroups&) {},
-      [&](LinkedGroupUpdates&& linkedGroupUpdates) {
-        m_state = document.performReplaceChildren(std::move(linkedGroupUpdates));
-      }),
-    std::move(m_state));
+  auto& linkedGroupUpdates = std::get<LinkedGroupUpdates>(m_state);
+
+  // the updates must be applied in order because the updates of nested linked groups may
+  // affect the nodes updated by the updates of their containing groups
+  for (auto& linkedGroupUpdate : linkedGroupUpdates)
+  {
+    if (!linkedGroupUpdate.swappedContents.empty())
+    {
+      document.performSwapNodeContents(linkedGroupUpdate.swappedContents);
+    }
+    linkedGroupUpdate.replacedChildren =
+      document.performReplaceChildren(std::move(linkedGroupUpdate.replacedChildren));
+  }
+}
+
+void UpdateLinkedGroupsHelper::doUndoLinkedGroupUpdates(
+  MapDocumentCommandFacade& document)
+{
+  auto& linkedGroupUpdates = std::get<LinkedGroupUpdates>(m_state);
+
+  // undo the updates in the opposite order in which they were applied, so that a node
+  // that was updated more than once ends up with its original contents
+  for (auto& linkedGroupUpdate : linkedGroupUpdates | std::views::reverse)
+  {
+    linkedGroupUpdate.replacedChildren =
+      document.performReplaceChildren(std::move(linkedGroupUpdate.replacedChildren));
+    if (!linkedGroupUpdate.swappedContents.empty())
+    {
+      document.performSwapNodeContents(linkedGroupUpdate.swappedContents);
+    }
+  }
 }
 
 } // namespace tb::ui
@@ -20,18 +20,11 @@
 #pragma once
 
 #include "Result.h"
+#include "mdl/LinkedGroupUtils.h"
 
-#include <memory>
-#include <utility>
 #include <variant>
 #include <vector>
 
-namespace tb::mdl
-{
-class GroupNode;
-class Node;
-} // namespace tb::mdl
-
 namespace tb::ui
 {
 class MapDocumentCommandFacade;
@@ -48,34 +41,50 @@ bool checkLinkedGroupsToUpdate(const std::vector<mdl::GroupNode*>& changedLinked
  * A helper class to add support for updating linked groups to commands.
  *
  * The class is initialized with a vector of group nodes whose changes should be
- * propagated to the members of their respective link sets. When applyLinkedGroupUpdates
- * is first called, a replacement node is created for each linked group that needs to be
- * updated, and these linked groups are replaced with their replacements. Calling
- * applyLinkedGroupUpdates replaces the replacement nodes with their original
- * corresponding groups again, effectively undoing the change.
+ * propagated to the members of their respective link sets. The nodes that each group
+ * node has recorded as changed (see GroupNode::pendingChangedNodes) are captured on
+ * construction. When applyLinkedGroupUpdates is first called, the changes are computed
+ * for each linked group that needs to be updated. If only some nodes of a group have
+ * changed, only these nodes are cloned into the linked groups. If a linked group has the
+ * same structure as the changed group, only the contents of its changed nodes are
+ * swapped. Otherwise, its children are replaced entirely. Calling undoLinkedGroupUpdates
+ * swaps the original contents and children back in, effectively undoing the change.
  */
 class UpdateLinkedGroupsHelper
 {
 private:
-  using ChangedLinkedGroups = std::vector<mdl::GroupNode*>;
-  using LinkedGroupUpdates =
-    std::vector<std::pair<mdl::Node*, std::vector<std::unique_ptr<mdl::Node>>>>;
+  struct ChangedLinkedGroup
+  {
+    mdl::GroupNode* groupNode;
+    // the nodes whose contents changed, or empty if the entire group changed
+    std::vector<mdl::Node*> changedNodes;
+  };
+
+  using ChangedLinkedGroups = std::vector<ChangedLinkedGroup>;
+  using LinkedGroupUpdates = std::vector<mdl::IncrementalUpdateLinkedGroupsResult>;
   std::variant<ChangedLinkedGroups, LinkedGroupUpdates> m_state;
 
 public:
-  explicit UpdateLinkedGroupsHelper(ChangedLinkedGroups changedLinkedGroups);
+  explicit UpdateLinkedGroupsHelper(std::vector<mdl::GroupNode*> changedLinkedGroups);
   ~UpdateLinkedGroupsHelper();
 
   Result<void> applyLinkedGroupUpdates(MapDocumentCommandFacade& document);
   void undoLinkedGroupUpdates(MapDocumentCommandFacade& document);
   void collateWith(UpdateLinkedGroupsHelper& other);
 
+  /**
+   * Returns an estimate of the memory used by the nodes that this helper keeps for undo
+   * and redo in bytes.
+   */
+  size_t sizeInBytes() const;
+
 private:
   Result<void> computeLinkedGroupUpdates(MapDocumentCommandFacade& document);
   static Result<LinkedGroupUpdates> computeLinkedGroupUpdates(
     const ChangedLinkedGroups& changedLinkedGroups, MapDocumentCommandFacade& document);
 
-  void doApplyOrUndoLinkedGroupUpdates(MapDocumentCommandFacade& document);
+  void doApplyLinkedGroupUpdates(MapDocumentCommandFacade& document);
+  void doUndoLinkedGroupUpdates(MapDocumentCommandFacade& document);
 };
 
 } // namespace tb::ui
@@ -26,7 +26,9 @@
 
 #include <fmt/ostream.h>
 
+#include <cmath>
 #include <string>
+#include <tuple>
 #include <variant>
 #include <vector>
 
@@ -45,12 +47,39 @@ Value evaluate(const std::string& expression, const MapType& variables = {})
   return io::ELParser::parseStrict(expression).evaluate(context);
 }
 
+Value evaluateCompiled(const std::string& expression, const MapType& variables = {})
+{
+  return io::ELParser::parseStrict(expression).compile().evaluate(
+    VariableTable{variables});
+}
+
 Value tryEvaluate(const std::string& expression, const MapType& variables = {})
 {
   const auto context = EvaluationContext{VariableTable{variables}};
   return io::ELParser::parseStrict(expression).evaluate(context);
 }
 
+class CountingVariableStore : public VariableTable
+{
+private:
+  size_t& m_lookups;
+
+public:
+  CountingVariableStore(MapType variables, size_t& lookups)
+    : VariableTable{std::move(variables)}
+    , m_lookups{lookups}
+  {
+  }
+
+  VariableStore* clone() const override { return new CountingVariableStore{*this}; }
+
+  Value value(const std::string& name) const override
+  {
+    ++m_lookups;
+    return VariableTable::value(name);
+  }
+};
+
 } // namespace
 
 TEST_CASE("ExpressionTest.testValueLiterals")
@@ -73,6 +102,7 @@ TEST_CASE("ExpressionTest.testValueLiterals")
   CAPTURE(expression);
 
   CHECK(evaluate(expression) == expectedValue);
+  CHECK(evaluateCompiled(expression) == expectedValue);
 }
 
 TEST_CASE("ExpressionTest.testVariableExpression")
@@ -92,6 +122,7 @@ TEST_CASE("ExpressionTest.testVariableExpression")
   CAPTURE(expression, variables);
 
   CHECK(evaluate(expression, variables) == expectedValue);
+  CHECK(evaluateCompiled(expression, variables) == expectedValue);
 }
 
 TEST_CASE("ExpressionTest.testArrayExpression")
@@ -110,6 +141,7 @@ TEST_CASE("ExpressionTest.testArrayExpression")
   CAPTURE(expression, variables);
 
   CHECK(evaluate(expression, variables) == Value{expectedValue});
+  CHECK(evaluateCompiled(expression, variables) == Value{expectedValue});
 }
 
 TEST_CASE("ExpressionTest.testMapExpression")
@@ -129,6 +161,7 @@ TEST_CASE("ExpressionTest.testMapExpression")
   CAPTURE(expression, variables);
 
   CHECK(evaluate(expression, variables) == Value{expectedValue});
+  CHECK(evaluateCompiled(expression, variables) == Value{expectedValue});
 }
 
 TEST_CASE("ExpressionTest.testOperators")
@@ -683,10 +716,12 @@ TEST_CASE("ExpressionTest.testOperators")
   {
     const auto expectedValue = std::get<Value>(expectedValueOrError);
     CHECK(evaluate(expression) == expectedValue);
+    CHECK(evaluateCompiled(expression) == expectedValue);
   }
   else
   {
     CHECK_THROWS_AS(evaluate(expression), EvaluationError);
+    CHECK_THROWS_AS(evaluateCompiled(expression), EvaluationError);
   }
 }
 
@@ -743,10 +778,12 @@ TEST_CASE("ExpressionTest.testSubscript")
   {
     const auto expectedValue = std::get<Value>(expectedValueOrError);
     CHECK(evaluate(expression) == expectedValue);
+    CHECK(evaluateCompiled(expression) == expectedValue);
   }
   else
   {
     CHECK_THROWS_AS(evaluate(expression), EvaluationError);
+    CHECK_THROWS_AS(evaluateCompiled(expression), EvaluationError);
   }
 }
 
@@ -789,6 +826,7 @@ TEST_CASE("ExpressionTest.testOperatorPrecedence")
   CAPTURE(expression);
 
   CHECK(evaluate(expression) == expectedValue);
+  CHECK(evaluateCompiled(expression) == expectedValue);
 }
 
 TEST_CASE("ExpressionTest.tryEvaluate")
@@ -836,6 +874,89 @@ TEST_CASE("ExpressionTest.testOptimize")
   CHECK(io::ELParser::parseStrict(expression).optimize() == expectedExpression);
 }
 
+TEST_CASE("ExpressionTest.compile")
+{
+  SECTION("Constant expressions are compiled to a single instruction")
+  {
+    const auto expression = io::ELParser::parseStrict("[1, 2, 3]").optimize();
+    CHECK(expression.compile().instructions().size() == 1);
+  }
+
+  SECTION("Equal constants are stored once")
+  {
+    const auto expression = io::ELParser::parseStrict(R"({{
+      spawnflags & 1 -> 1,
+      spawnflags & 2 -> "1",
+      spawnflags & 4 -> 0,
+                        -0
+    }})").optimize();
+    const auto compiledExpression = expression.compile();
+
+    CHECK(
+      compiledExpression.constants()
+      == std::vector<Value>{
+        Value{1},
+        Value{2},
+        Value{"1"},
+        Value{4},
+        Value{0},
+        Value{-0.0},
+        Value::Undefined});
+    CHECK(std::signbit(compiledExpression.constants()[5].numberValue()));
+
+    auto lookups = size_t(0);
+    const auto store = CountingVariableStore{{{"spawnflags", Value{2}}}, lookups};
+    CHECK(compiledExpression.evaluate(store) == Value{"1"});
+  }
+
+  SECTION("Each variable is looked up at most once")
+  {
+    const auto expression = io::ELParser::parseStrict(R"({{
+      spawnflags & 1 -> "a",
+      spawnflags & 2 -> "b",
+      spawnflags & 4 -> "c",
+                        other
+    }})");
+    const auto compiledExpression = expression.compile();
+
+    auto lookups = size_t(0);
+    const auto store =
+      CountingVariableStore{{{"spawnflags", Value{4}}, {"other", Value{"d"}}}, lookups};
+
+    CHECK(compiledExpression.evaluate(store) == Value{"c"});
+    CHECK(lookups == 1);
+  }
+
+  SECTION("Right operands are only evaluated when needed")
+  {
+    using T = std::tuple<std::string, Value, size_t>;
+
+    // clang-format off
+    const auto
+    [expression,                   expectedValue,    expectedLookups] = GENERATE(values<T>({
+    {"false && x[-1]",             Value{false},     0},
+    {"null && x[-1]",              Value{false},     0},
+    {"true || x[-1]",              Value{true},      0},
+    {"a && x[-1]",                 Value::Undefined, 1},
+    {"a || x[-1]",                 Value::Undefined, 1},
+    {"true && x",                  Value{false},     1},
+    {"false -> x[-1]",             Value::Undefined, 0},
+    {"{{ 1, x[-1] }}",             Value{1},         0},
+    {"{{ a, false -> x[-1], 2 }}", Value{2},         1},
+    }));
+    // clang-format on
+
+    CAPTURE(expression);
+
+    auto lookups = size_t(0);
+    const auto store = CountingVariableStore{{{"x", Value{false}}}, lookups};
+
+    CHECK(
+      io::ELParser::parseStrict(expression).compile().evaluate(store) == expectedValue);
+    CHECK(lookups == expectedLookups);
+  }
+}
+
 namespace
 {
 std::vector<std::string> preorderVisit(const std::string& str)
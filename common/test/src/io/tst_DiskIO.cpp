@@ -23,6 +23,7 @@
 #include "io/DiskIO.h"
 #include "io/File.h"
 #include "io/PathInfo.h"
+#include "io/ReaderException.h"
 #include "io/TestEnvironment.h"
 #include "io/TraversalMode.h"
 
@@ -224,27 +225,27 @@ TEST_CASE("DiskIO")
       Disk::openFile("asdf/bleh"),
       MatchesAnyOf({
         // macOS / Linux
-        Result<std::shared_ptr<CFile>>{
+        Result<std::shared_ptr<MappedFile>>{
           Error{"Failed to open 'asdf/bleh': path does not denote a file"}},
         // Windows
-        Result<std::shared_ptr<CFile>>{
+        Result<std::shared_ptr<MappedFile>>{
           Error{"Failed to open 'asdf\\bleh': path does not denote a file"}},
       }));
     CHECK_THAT(
       Disk::openFile(env.dir() / "does/not/exist"),
       MatchesAnyOf({
         // macOS / Linux
-        Result<std::shared_ptr<CFile>>{Error{
+        Result<std::shared_ptr<MappedFile>>{Error{
           "Failed to open '" + (env.dir() / "does/not/exist").string()
           + "': path does not denote a file"}},
         // Windows
-        Result<std::shared_ptr<CFile>>{Error{
+        Result<std::shared_ptr<MappedFile>>{Error{
           "Failed to open '" + (env.dir() / "does\\not\\exist").string()
           + "': path does not denote a file"}},
       }));
     CHECK(
       Disk::openFile(env.dir() / "does_not_exist.txt")
-      == Result<std::shared_ptr<CFile>>{Error{
+      == Result<std::shared_ptr<MappedFile>>{Error{
         "Failed to open '" + (env.dir() / "does_not_exist.txt").string()
         + "': path does not denote a file"}});
 
@@ -259,6 +260,33 @@ TEST_CASE("DiskIO")
 
     file = Disk::openFile(env.dir() / "linkedTest2.map");
     CHECK(file.is_success());
+
+#ifndef _WIN32
+    // On Windows, a mapped file cannot be truncated
+    SECTION("A modified file is read through the file instead of the mapping")
+    {
+      // the file must be larger than the stdio buffer to observe the truncation
+      const auto path = env.dir() / "large.txt";
+      REQUIRE(Disk::withOutputStream(path, [](auto& stream) {
+                stream << std::string(65536, 'x');
+              }).is_success());
+
+      auto reader = [&] {
+        const auto mappedFile = Disk::openFile(path) | kdl::value();
+        CHECK_FALSE(mappedFile->isModified());
+        CHECK(mappedFile->reader().readString(4) == "xxxx");
+
+        // reading the truncated part of the mapping would raise SIGBUS
+        std::filesystem::resize_file(path, 4);
+        CHECK(mappedFile->isModified());
+
+        return mappedFile->reader().subReaderFromBegin(32768);
+      }();
+
+      // the reader keeps the file open after the mapped file was destroyed
+      CHECK_THROWS_AS(reader.readString(4), ReaderException);
+    }
+#endif
   }
 
   SECTION("withStream")
@@ -26,7 +26,11 @@
 #include "io/WadFileSystem.h"
 #include "io/ZipFileSystem.h"
 
+#include "kdl/task_manager.h"
+#include "kdl/vector_utils.h"
+
 #include <filesystem>
+#include <functional>
 
 #include "catch/Matchers.h"
 
@@ -984,6 +988,41 @@ TEST_CASE("Flat ImageFileSystems")
   }
 }
 
+TEST_CASE("ZipFileSystem")
+{
+  SECTION("Files can be opened concurrently")
+  {
+    const auto fs = std::shared_ptr<FileSystem>{openFS<ZipFileSystem>(
+      std::filesystem::current_path() / "fixture/test/io/Zip/zip.zip")};
+
+    const auto paths = fs->find("", TraversalMode::Recursive)
+                       | kdl::transform([&](auto foundPaths) {
+                           return kdl::vec_filter(std::move(foundPaths), [&](auto path) {
+                             return fs->pathInfo(path) == PathInfo::File;
+                           });
+                         })
+                       | kdl::value();
+    REQUIRE(paths.size() == 16u);
+
+    const auto readContents = [&](const auto& path) {
+      const auto file = fs->openFile(path) | kdl::value();
+      auto reader = file->reader();
+      return reader.readString(reader.size());
+    };
+
+    const auto expectedContents = kdl::vec_transform(paths, readContents);
+
+    auto taskManager = createTestTaskManager();
+    for (size_t i = 0; i < 8; ++i)
+    {
+      auto tasks = kdl::vec_transform(paths, [&](const auto& path) {
+        return std::function{[&, path]() { return readContents(path); }};
+      });
+      CHECK(taskManager->run_tasks_and_wait(std::move(tasks)) == expectedContents);
+    }
+  }
+}
+
 TEST_CASE("WadFileSystem")
 {
   SECTION("Wad files can be replaced while wad file system exists")
@@ -38,6 +38,8 @@
 #include <fmt/format.h>
 
 #include <sstream>
+#include <string>
+#include <tuple>
 #include <vector>
 
 #include "catch/Matchers.h"
@@ -733,6 +735,110 @@ TEST_CASE("NodeWriter")
     CHECK_THAT(actual, MatchesGlob(expected));
   }
 
+  SECTION("writeMapWithManyBrushes")
+  {
+    const auto worldBounds = vm::bbox3d{8192.0};
+
+    auto map = mdl::WorldNode{{}, {}, mdl::MapFormat::Standard};
+    auto builder = mdl::BrushBuilder{map.mapFormat(), worldBounds};
+
+    auto brushNodes = std::vector<mdl::BrushNode*>{};
+    const auto addBrushes = [&](mdl::Node& parent, const size_t count) {
+      for (size_t i = 0; i < count; ++i)
+      {
+        const auto materialName = fmt::format("material{}", brushNodes.size());
+        auto* brushNode =
+          new mdl::BrushNode{builder.createCube(64.0, materialName) | kdl::value()};
+        parent.addChild(brushNode);
+        brushNodes.push_back(brushNode);
+      }
+    };
+
+    // interleave brushes and entities so that the brushes are not written in the
+    // order in which they were added
+    addBrushes(*map.defaultLayer(), 1000);
+    auto* entityNode = new mdl::EntityNode{mdl::Entity{{{"classname", "func_door"}}}};
+    map.defaultLayer()->addChild(entityNode);
+    addBrushes(*entityNode, 1000);
+    addBrushes(*map.defaultLayer(), 1000);
+
+    auto omittedLayer = mdl::Layer{"Omitted Layer"};
+    omittedLayer.setOmitFromExport(true);
+    auto* omittedLayerNode = new mdl::LayerNode{std::move(omittedLayer)};
+    map.addChild(omittedLayerNode);
+    addBrushes(*omittedLayerNode, 1000);
+
+    auto* layerNode = new mdl::LayerNode{mdl::Layer{"Custom Layer"}};
+    map.addChild(layerNode);
+    addBrushes(*layerNode, 1000);
+
+    auto str = std::stringstream{};
+    auto writer = NodeWriter{map, str};
+    writer.setExporting(true);
+    writer.writeMap(taskManager);
+
+    auto lines = std::vector<std::string>{};
+    for (auto line = std::string{}; std::getline(str, line);)
+    {
+      lines.push_back(line);
+    }
+
+    for (const auto* brushNode : brushNodes)
+    {
+      if (brushNode->parent() == omittedLayerNode)
+      {
+        continue;
+      }
+
+      // the line number refers to the opening brace, followed by the first face
+      const auto lineIndex = brushNode->lineNumber();
+      REQUIRE(lineIndex < lines.size());
+      CHECK_THAT(
+        lines[lineIndex],
+        Catch::Matchers::EndsWith(
+          brushNode->brush().face(0).attributes().materialName() + " 0 0 0 1 1"));
+    }
+  }
+
+  SECTION("writeMapWithProgressCallback")
+  {
+    const auto worldBounds = vm::bbox3d{8192.0};
+
+    auto map = mdl::WorldNode{{}, {}, mdl::MapFormat::Standard};
+    auto builder = mdl::BrushBuilder{map.mapFormat(), worldBounds};
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+      map.defaultLayer()->addChild(
+        new mdl::BrushNode{builder.createCube(64.0, "material") | kdl::value()});
+    }
+
+    auto progress = std::vector<std::tuple<size_t, size_t>>{};
+
+    auto str = std::stringstream{};
+    auto writer = NodeWriter{map, str};
+    writer.setProgressCallback([&](const auto writtenNodeCount, const auto nodeCount) {
+      progress.emplace_back(writtenNodeCount, nodeCount);
+      return writtenNodeCount < 3;
+    });
+    writer.writeMap(taskManager);
+
+    // the world, its default layer and the brushes are counted
+    CHECK(
+      progress
+      == std::vector<std::tuple<size_t, size_t>>{{0, 12}, {1, 12}, {2, 12}, {3, 12}});
+
+    auto brushCount = size_t(0);
+    for (auto line = std::string{}; std::getline(str, line);)
+    {
+      if (line.starts_with("// brush"))
+      {
+        ++brushCount;
+      }
+    }
+    CHECK(brushCount == 2);
+  }
+
   SECTION("writeMapWithInheritedLock")
   {
     auto map = mdl::WorldNode{{}, {}, mdl::MapFormat::Standard};
@@ -47,6 +47,14 @@ std::shared_ptr<File> file()
   return result;
 }
 
+std::shared_ptr<File> cFile()
+{
+  static auto result =
+    createCFile(std::filesystem::current_path() / "fixture/test/io/Reader/10byte")
+    | kdl::value();
+  return result;
+}
+
 void createEmpty(Reader&& r)
 {
   CHECK(r.size() == 0U);
@@ -229,4 +237,29 @@ TEST_CASE("FileReaderTest.subReader")
 {
   subReader(file()->reader());
 }
+
+TEST_CASE("CFileReaderTest.createNonEmpty")
+{
+  createNonEmpty(cFile()->reader());
+}
+
+TEST_CASE("CFileReaderTest.subReader")
+{
+  subReader(cFile()->reader());
+}
+
+TEST_CASE("FileReaderTest.readerOutlivesFile")
+{
+  auto reader = [] {
+    auto mappedFile =
+      Disk::openFile(std::filesystem::current_path() / "fixture/test/io/Reader/10byte")
+      | kdl::value();
+    return mappedFile->reader().subReaderFromBegin(2);
+  }();
+
+  CHECK(reader.readString(3) == "cde");
+
+  auto bufferedReader = reader.buffer();
+  CHECK(bufferedReader.stringView() == "cdefghij");
+}
 } // namespace tb::io
@@ -0,0 +1,142 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FileLocation.h"
+#include "io/StandardMapParser.h"
+
+#include <string>
+
+#include "Catch2.h"
+
+namespace tb::io
+{
+
+TEST_CASE("splitIntoEntityChunks")
+{
+  SECTION("Empty file")
+  {
+    const auto chunks = splitIntoEntityChunks("", 1024);
+    REQUIRE(chunks);
+    CHECK(chunks->empty());
+  }
+
+  SECTION("Small entities are joined")
+  {
+    const auto data = std::string{R"(// comment {
+{
+"classname" "worldspawn"
+"message" "{ } \" }"
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) {fence 0 0 0 1 1
+}
+}
+; another comment }
+{
+"classname" "info_player_start"
+}
+)"};
+
+    const auto chunks = splitIntoEntityChunks(data, 1024);
+    REQUIRE(chunks);
+    REQUIRE(chunks->size() == 1);
+
+    const auto& chunk = chunks->front();
+    CHECK(chunk.type == EntityChunkType::Entities);
+    CHECK(chunk.startLocation == FileLocation{2, 1});
+    CHECK(chunk.str == data.substr(13, data.size() - 14));
+  }
+
+  SECTION("Entities are split into chunks of the given size")
+  {
+    const auto data = std::string{R"({
+"classname" "worldspawn"
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) {fence 0 0 0 1 1
+}
+}
+{
+"classname" "info_player_start"
+})"};
+
+    const auto chunks = splitIntoEntityChunks(data, 1);
+    REQUIRE(chunks);
+    REQUIRE(chunks->size() == 2);
+
+    CHECK((*chunks)[0].type == EntityChunkType::Entities);
+    CHECK((*chunks)[0].startLocation == FileLocation{1, 1});
+    CHECK((*chunks)[0].str == data.substr(0, data.find("}\n{") + 1));
+
+    CHECK((*chunks)[1].type == EntityChunkType::Entities);
+    CHECK((*chunks)[1].startLocation == FileLocation{7, 1});
+    CHECK((*chunks)[1].str == data.substr(data.find("}\n{") + 2));
+  }
+
+  SECTION("Large entities are split between brushes")
+  {
+    const auto brush = std::string{R"({
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) tex 0 0 0 1 1
+}
+)"};
+    const auto data = "{\n\"classname\" \"worldspawn\"\n" + brush + brush + brush + "}";
+
+    const auto chunks = splitIntoEntityChunks(data, 1);
+    REQUIRE(chunks);
+    REQUIRE(chunks->size() == 3);
+
+    CHECK((*chunks)[0].type == EntityChunkType::EntityStart);
+    CHECK((*chunks)[0].startLocation == FileLocation{1, 1});
+    CHECK((*chunks)[0].endLocation == FileLocation{12, 1});
+    CHECK((*chunks)[0].str == "{\n\"classname\" \"worldspawn\"\n" + brush);
+
+    CHECK((*chunks)[1].type == EntityChunkType::EntityBrushes);
+    CHECK((*chunks)[1].startLocation == FileLocation{6, 1});
+    CHECK((*chunks)[1].str == brush);
+
+    CHECK((*chunks)[2].type == EntityChunkType::EntityBrushes);
+    CHECK((*chunks)[2].startLocation == FileLocation{9, 1});
+    CHECK((*chunks)[2].str == brush);
+  }
+
+  SECTION("Entities with properties after brushes are not split")
+  {
+    const auto brush = std::string{R"({
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) tex 0 0 0 1 1
+}
+)"};
+    const auto data = "{\n" + brush + "\"classname\" \"worldspawn\"\n" + brush + "}";
+
+    const auto chunks = splitIntoEntityChunks(data, 1);
+    REQUIRE(chunks);
+    REQUIRE(chunks->size() == 1);
+    CHECK(chunks->front().type == EntityChunkType::Entities);
+    CHECK(chunks->front().str == data);
+  }
+
+  SECTION("Malformed files")
+  {
+    CHECK(splitIntoEntityChunks("{", 1) == std::nullopt);
+    CHECK(splitIntoEntityChunks("}", 1) == std::nullopt);
+    CHECK(splitIntoEntityChunks("{}}", 1) == std::nullopt);
+    CHECK(splitIntoEntityChunks("classname", 1) == std::nullopt);
+    CHECK(splitIntoEntityChunks("{ \"classname }", 1) == std::nullopt);
+    CHECK(splitIntoEntityChunks("/// comment\n{}", 1) == std::nullopt);
+  }
+}
+
+} // namespace tb::io
@@ -40,6 +40,7 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <string>
 
@@ -1871,6 +1872,138 @@ common/caulk
     }
   }
 
+  SECTION("parseLargeMapInChunks")
+  {
+    // large enough to be split into several chunks, and with entities large enough to be
+    // split between their brushes
+    auto data = std::string{};
+    auto lineNumber = size_t(1);
+
+    const auto appendLine = [&](const std::string& line) {
+      data += line + "\n";
+      ++lineNumber;
+    };
+
+    const auto appendBrush = [&](const size_t i) {
+      const auto x0 = fmt::format("{}", (i % 100) * 64);
+      const auto x1 = fmt::format("{}", (i % 100) * 64 + 64);
+      appendLine("{");
+      appendLine(fmt::format(
+        "( {0} 0 -16 ) ( {0} 0 0 ) ( {1} 0 -16 ) {{none 0 0 0 1 1", x0, x1));
+      appendLine(
+        fmt::format("( {0} 0 -16 ) ( {0} 64 -16 ) ( {0} 0 0 ) none 0 0 0 1 1", x0));
+      appendLine(fmt::format(
+        "( {0} 0 -16 ) ( {1} 0 -16 ) ( {0} 64 -16 ) none 0 0 0 1 1", x0, x1));
+      appendLine(fmt::format(
+        "( {1} 64 0 ) ( {0} 64 0 ) ( {1} 64 -16 ) none 0 0 0 1 1", x0, x1));
+      appendLine(
+        fmt::format("( {0} 64 0 ) ( {0} 64 -16 ) ( {0} 0 0 ) none 0 0 0 1 1", x1));
+      appendLine(
+        fmt::format("( {1} 64 0 ) ( {1} 0 0 ) ( {0} 64 0 ) none 0 0 0 1 1", x0, x1));
+      appendLine("}");
+    };
+
+    auto expectedBrushLines = std::vector<size_t>{};
+    auto expectedEntityLines = std::vector<size_t>{};
+
+    appendLine("{");
+    appendLine(R"("classname" "worldspawn")");
+    for (size_t i = 0; i < 2000; ++i)
+    {
+      expectedBrushLines.push_back(lineNumber);
+      appendBrush(i);
+    }
+    appendLine("}");
+
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      expectedEntityLines.push_back(lineNumber);
+      appendLine("{");
+      appendLine(R"("classname" "info_null")");
+      appendLine(fmt::format(R"("targetname" "null{}")", i));
+      appendLine("}");
+    }
+
+    const auto groupLine = lineNumber;
+    appendLine("{");
+    appendLine(R"("classname" "func_group")");
+    appendLine(R"("_tb_type" "_tb_group")");
+    appendLine(R"("_tb_name" "group")");
+    appendLine(R"("_tb_id" "1")");
+    for (size_t i = 0; i < 1500; ++i)
+    {
+      appendBrush(i);
+    }
+    appendLine("}");
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+      expectedEntityLines.push_back(lineNumber);
+      appendLine("{");
+      appendLine(R"("classname" "func_group")");
+      for (size_t j = 0; j < 3; ++j)
+      {
+        appendBrush(j);
+      }
+      appendLine("}");
+    }
+
+    auto reader = WorldReader{data, mdl::MapFormat::Standard, {}};
+    auto world = reader.read(worldBounds, status, taskManager);
+
+    CHECK(status.countStatus(LogLevel::Warn) == 0u);
+    CHECK(status.countStatus(LogLevel::Error) == 0u);
+
+    // the progress is reported once per chunk
+    const auto& progress = status.reportedProgress();
+    CHECK(progress.size() > 1u);
+    CHECK(std::ranges::is_sorted(progress));
+    CHECK(progress.back() == 1.0);
+
+    REQUIRE(world->childCount() == 1u);
+    const auto* defaultLayer = world->children().front();
+    REQUIRE(defaultLayer->childCount() == 2000u + 1000u + 1u + 100u);
+
+    const auto& children = defaultLayer->children();
+    for (size_t i = 0; i < 2000; ++i)
+    {
+      const auto* brushNode = dynamic_cast<const mdl::BrushNode*>(children[i]);
+      REQUIRE(brushNode != nullptr);
+      CHECK(brushNode->lineNumber() == expectedBrushLines[i]);
+      CHECK(brushNode->containsLine(expectedBrushLines[i] + 6));
+      CHECK_FALSE(brushNode->containsLine(expectedBrushLines[i] + 7));
+      CHECK(std::ranges::any_of(brushNode->brush().faces(), [](const auto& face) {
+        return face.attributes().materialName() == "{none";
+      }));
+    }
+
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      const auto* entityNode = dynamic_cast<const mdl::EntityNode*>(children[2000 + i]);
+      REQUIRE(entityNode != nullptr);
+      CHECK(entityNode->lineNumber() == expectedEntityLines[i]);
+      CHECK(entityNode->containsLine(expectedEntityLines[i] + 2));
+      CHECK_FALSE(entityNode->containsLine(expectedEntityLines[i] + 3));
+      REQUIRE(entityNode->entity().property("targetname") != nullptr);
+      CHECK(*entityNode->entity().property("targetname") == fmt::format("null{}", i));
+    }
+
+    const auto* groupNode = dynamic_cast<const mdl::GroupNode*>(children[3000]);
+    REQUIRE(groupNode != nullptr);
+    CHECK(groupNode->lineNumber() == groupLine);
+    CHECK(groupNode->containsLine(groupLine + 1500 * 8 + 4));
+    CHECK_FALSE(groupNode->containsLine(groupLine + 1500 * 8 + 5));
+    CHECK(groupNode->childCount() == 1500u);
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+      const auto* entityNode = dynamic_cast<const mdl::EntityNode*>(children[3001 + i]);
+      REQUIRE(entityNode != nullptr);
+      CHECK(entityNode->lineNumber() == expectedEntityLines[1000 + i]);
+      CHECK(entityNode->childCount() == 3u);
+    }
+  }
+
   SECTION("parseUnknownFormatEmptyMap")
   {
     const auto data = R"(
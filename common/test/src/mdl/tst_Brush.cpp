@@ -31,12 +31,16 @@
 #include "kdl/vector_utils.h"
 
 #include "vm/approx.h"
+#include "vm/mat_ext.h"
+#include "vm/mat_io.h" // IWYU pragma: keep
 #include "vm/polygon.h"
 #include "vm/segment.h"
 #include "vm/vec.h"
 #include "vm/vec_ext.h"
 
+#include <ranges>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "Catch2.h"
@@ -228,6 +232,108 @@ TEST_CASE("BrushTest.constructBrushWithFaces")
   CHECK(brush.findFace(vm::vec3d{0, 0, -1}));
 }
 
+TEST_CASE("BrushTest.transform")
+{
+  const auto worldBounds = vm::bbox3d{4096.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  // a wedge, so that every transformation can be told apart
+  const auto brush = builder.createBrush(
+                       std::vector<vm::vec3d>{
+                         {0, 0, 0},
+                         {32, 0, 0},
+                         {0, 16, 0},
+                         {32, 16, 0},
+                         {0, 0, 64},
+                         {0, 16, 64},
+                       },
+                       "material")
+                     | kdl::value();
+
+  const auto translation = vm::translation_matrix(vm::vec3d{16, -32, 8});
+  const auto rotation90 = vm::rotation_matrix(vm::vec3d{0, 0, 1}, vm::to_radians(90.0));
+  const auto rotation180 = vm::rotation_matrix(vm::vec3d{1, 0, 0}, vm::to_radians(180.0));
+  const auto mirror = vm::mirror_matrix<double>(vm::axis::y);
+  const auto translatedMirror =
+    vm::translation_matrix(vm::vec3d{-8, 0, 0}) * vm::mirror_matrix<double>(vm::axis::z);
+  const auto rotation45 = vm::rotation_matrix(vm::vec3d{0, 0, 1}, vm::to_radians(45.0));
+  const auto scaling = vm::scaling_matrix(vm::vec3d{2, 1, 1});
+  const auto outOfBounds = vm::translation_matrix(vm::vec3d{4096, 0, 0});
+
+  // the rotation matrices snapped to exact values
+
+  // clang-format off
+  const auto snappedRotation90 = vm::mat4x4d{
+    0, -1, 0, 0,
+    1,  0, 0, 0,
+    0,  0, 1, 0,
+    0,  0, 0, 1};
+  const auto snappedRotation180 = vm::mat4x4d{
+    1,  0,  0, 0,
+    0, -1,  0, 0,
+    0,  0, -1, 0,
+    0,  0,  0, 1};
+  // clang-format on
+
+  // the expected brush is rebuilt from faces that were transformed by the second matrix
+
+  using T = std::tuple<vm::mat4x4d, vm::mat4x4d>;
+
+  // clang-format off
+  const auto
+  [transformation,   expectedTransformation] = GENERATE_REF(values<T>({
+  // handled in place
+  {translation,      translation},
+  {rotation90,       snappedRotation90},
+  {rotation180,      snappedRotation180},
+  {mirror,           mirror},
+  {translatedMirror, translatedMirror},
+  // rebuilt from faces
+  {rotation45,       rotation45},
+  {scaling,          scaling},
+  // exceeds world bounds after transformation
+  {outOfBounds,      outOfBounds},
+  }));
+  // clang-format on
+
+  CAPTURE(transformation);
+
+  auto transformedFaces = brush.faces();
+  const auto expected =
+    transformedFaces | std::views::transform([&](auto face) {
+      return face.transform(expectedTransformation, false) | kdl::transform([&]() {
+               return std::move(face);
+             });
+    })
+    | kdl::fold | kdl::and_then([&](auto faces) {
+        return Brush::create(worldBounds, std::move(faces));
+      });
+
+  auto transformed = brush;
+  const auto result = transformed.transform(worldBounds, transformation, false);
+  REQUIRE(result.is_success() == expected.is_success());
+
+  if (expected.is_success())
+  {
+    const auto& expectedBrush = expected.value();
+
+    // the faces must be equal and in the same order
+    CHECK(transformed.faces() == expectedBrush.faces());
+    CHECK_THAT(
+      transformed.vertexPositions(),
+      Catch::UnorderedEquals(expectedBrush.vertexPositions()));
+    CHECK(transformed.bounds() == expectedBrush.bounds());
+
+    for (size_t i = 0; i < transformed.faceCount(); ++i)
+    {
+      // every face must still be linked to its geometry
+      CHECK_THAT(
+        transformed.face(i).vertexPositions(),
+        Catch::UnorderedEquals(expectedBrush.face(i).vertexPositions()));
+    }
+  }
+}
+
 TEST_CASE("BrushTest.constructBrushWithRedundantFaces")
 {
   const auto worldBounds = vm::bbox3d{4096.0};
@@ -191,6 +191,12 @@ TEST_CASE("EntityTest")
 
     entity.addOrUpdateProperty(EntityPropertyKeys::Spawnflags, "1");
     CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+    entity.removeProperty(EntityPropertyKeys::Spawnflags);
+    CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell0.bsp", 0, 0});
+
+    entity.setDefinition(nullptr);
+    CHECK(entity.modelSpecification() == ModelSpecification{});
   }
 
   SECTION("decalSpecification")
@@ -212,6 +218,15 @@ TEST_CASE("EntityTest")
 
     entity.addOrUpdateProperty("texture", "decal1");
     CHECK(entity.decalSpecification() == DecalSpecification{"decal1"});
+
+    entity.renameProperty("texture", "other");
+    CHECK(entity.decalSpecification() == DecalSpecification{""});
+
+    entity.setProperties({{"texture", "decal2"}});
+    CHECK(entity.decalSpecification() == DecalSpecification{"decal2"});
+
+    entity.unsetEntityDefinitionAndModel();
+    CHECK(entity.decalSpecification() == DecalSpecification{});
   }
 
   SECTION("unsetEntityDefinitionAndModel")
@@ -241,6 +256,29 @@ TEST_CASE("EntityTest")
       entity.modelTransformation(defaultModelScaleExpression) == vm::mat4x4d::identity());
   }
 
+  SECTION("modelTransformation")
+  {
+    auto definition =
+      PointEntityDefinition{"some_name", Color{}, vm::bbox3d{32.0}, "", {}, {}, {}};
+
+    auto entity = Entity{};
+    entity.setDefinition(&definition);
+
+    SECTION("Updates cached model transformation if default scale expression changes")
+    {
+      REQUIRE(
+        entity.modelTransformation(
+          el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}})
+        == vm::scaling_matrix(vm::vec3d{2, 2, 2}));
+
+      CHECK(
+        entity.modelTransformation(
+          el::ExpressionNode{el::LiteralExpression{el::Value{3.0}}})
+        == vm::scaling_matrix(vm::vec3d{3, 3, 3}));
+      CHECK(entity.modelTransformation(std::nullopt) == vm::mat4x4d::identity());
+    }
+  }
+
   SECTION("addOrUpdateProperty")
   {
     // needs to be created here so that it is destroyed last
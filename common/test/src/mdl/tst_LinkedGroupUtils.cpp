@@ -714,6 +714,296 @@ TEST_CASE("updateLinkedGroups")
   }
 }
 
+TEST_CASE("updateLinkedGroupsIncrementally")
+{
+  auto taskManager = kdl::task_manager{};
+
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto brushBuilder = BrushBuilder{MapFormat::Quake3, worldBounds};
+
+  auto sourceGroupNode = GroupNode{Group{"name"}};
+  auto* sourceBrushNode =
+    new BrushNode{brushBuilder.createCube(64.0, "material") | kdl::value()};
+  auto* sourceEntityNode = new EntityNode{Entity{}};
+  sourceGroupNode.addChildren({sourceBrushNode, sourceEntityNode});
+
+  auto targetGroupNode = std::unique_ptr<GroupNode>{
+    static_cast<GroupNode*>(sourceGroupNode.cloneRecursively(worldBounds))};
+  transformNode(
+    *targetGroupNode, vm::translation_matrix(vm::vec3d{128, 0, 0}), worldBounds);
+
+  auto* targetBrushNode = dynamic_cast<BrushNode*>(targetGroupNode->children().front());
+  auto* targetEntityNode = dynamic_cast<EntityNode*>(targetGroupNode->children().back());
+  REQUIRE(targetBrushNode != nullptr);
+  REQUIRE(targetEntityNode != nullptr);
+
+  SECTION("Nothing changed")
+  {
+    updateLinkedGroupsIncrementally(
+      sourceGroupNode, {targetGroupNode.get()}, worldBounds, taskManager)
+      | kdl::transform([&](const IncrementalUpdateLinkedGroupsResult& r) {
+          CHECK(r.replacedChildren.empty());
+          CHECK(r.swappedContents.empty());
+        })
+      | kdl::transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("Only the changed node is swapped")
+  {
+    transformNode(
+      *sourceEntityNode, vm::translation_matrix(vm::vec3d{0, 0, 16}), worldBounds);
+
+    updateLinkedGroupsIncrementally(
+      sourceGroupNode, {targetGroupNode.get()}, worldBounds, taskManager)
+      | kdl::transform([&](const IncrementalUpdateLinkedGroupsResult& r) {
+          CHECK(r.replacedChildren.empty());
+          REQUIRE(r.swappedContents.size() == 1u);
+
+          const auto& [node, contents] = r.swappedContents.front();
+          CHECK(node == targetEntityNode);
+          CHECK(std::get<Entity>(contents.get()).origin() == vm::vec3d{128, 0, 16});
+        })
+      | kdl::transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("Protected entity properties are preserved")
+  {
+    {
+      auto targetEntity = targetEntityNode->entity();
+      targetEntity.setProtectedProperties({"light"});
+      targetEntity.addOrUpdateProperty("light", "500");
+      targetEntityNode->setEntity(std::move(targetEntity));
+    }
+
+    SECTION("Unprotected property changed")
+    {
+      auto sourceEntity = sourceEntityNode->entity();
+      sourceEntity.addOrUpdateProperty("classname", "light");
+      sourceEntityNode->setEntity(std::move(sourceEntity));
+
+      updateLinkedGroupsIncrementally(
+        sourceGroupNode, {targetGroupNode.get()}, worldBounds, taskManager)
+        | kdl::transform([&](const IncrementalUpdateLinkedGroupsResult& r) {
+            CHECK(r.replacedChildren.empty());
+            REQUIRE(r.swappedContents.size() == 1u);
+
+            const auto& [node, contents] = r.swappedContents.front();
+            CHECK(node == targetEntityNode);
+            CHECK_THAT(
+              std::get<Entity>(contents.get()).properties(),
+              Catch::UnorderedEquals(std::vector<EntityProperty>{
+                {"classname", "light"},
+                {"origin", "128 0 0"},
+                {"light", "500"},
+              }));
+          })
+        | kdl::transform_error([](const auto&) { FAIL(); });
+    }
+
+    SECTION("Only protected property changed")
+    {
+      auto sourceEntity = sourceEntityNode->entity();
+      sourceEntity.addOrUpdateProperty("light", "400");
+      sourceEntityNode->setEntity(std::move(sourceEntity));
+
+      updateLinkedGroupsIncrementally(
+        sourceGroupNode, {targetGroupNode.get()}, worldBounds, taskManager)
+        | kdl::transform([&](const IncrementalUpdateLinkedGroupsResult& r) {
+            CHECK(r.replacedChildren.empty());
+            CHECK(r.swappedContents.empty());
+          })
+        | kdl::transform_error([](const auto&) { FAIL(); });
+    }
+  }
+
+  SECTION("All children are replaced if the structure changed")
+  {
+    sourceGroupNode.addChild(createPatchNode());
+
+    updateLinkedGroupsIncrementally(
+      sourceGroupNode, {targetGroupNode.get()}, worldBounds, taskManager)
+      | kdl::transform([&](const IncrementalUpdateLinkedGroupsResult& r) {
+          CHECK(r.swappedContents.empty());
+          REQUIRE(r.replacedChildren.size() == 1u);
+
+          const auto& [node, newChildren] = r.replacedChildren.front();
+          CHECK(node == targetGroupNode.get());
+          CHECK(newChildren.size() == 3u);
+        })
+      | kdl::transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("Changed and unchanged target groups")
+  {
+    auto otherTargetGroupNode = std::unique_ptr<GroupNode>{
+      static_cast<GroupNode*>(sourceGroupNode.cloneRecursively(worldBounds))};
+    auto* otherTargetBrushNode =
+      dynamic_cast<BrushNode*>(otherTargetGroupNode->children().front());
+    REQUIRE(otherTargetBrushNode != nullptr);
+
+    // only the first target group is out of date
+    transformNode(
+      *sourceBrushNode, vm::translation_matrix(vm::vec3d{0, 32, 0}), worldBounds);
+    transformNode(
+      *otherTargetBrushNode, vm::translation_matrix(vm::vec3d{0, 32, 0}), worldBounds);
+
+    updateLinkedGroupsIncrementally(
+      sourceGroupNode,
+      {otherTargetGroupNode.get(), targetGroupNode.get()},
+      worldBounds,
+      taskManager)
+      | kdl::transform([&](const IncrementalUpdateLinkedGroupsResult& r) {
+          CHECK(r.replacedChildren.empty());
+          REQUIRE(r.swappedContents.size() == 1u);
+
+          const auto& [node, contents] = r.swappedContents.front();
+          CHECK(node == targetBrushNode);
+          CHECK(
+            std::get<Brush>(contents.get()).bounds()
+            == sourceBrushNode->logicalBounds().translate(vm::vec3d{128, 0, 0}));
+        })
+      | kdl::transform_error([](const auto&) { FAIL(); });
+  }
+}
+
+TEST_CASE("updateLinkedGroupsIncrementally.changedNodes")
+{
+  auto taskManager = kdl::task_manager{};
+
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto brushBuilder = BrushBuilder{MapFormat::Quake3, worldBounds};
+
+  auto sourceGroupNode = GroupNode{Group{"name"}};
+  auto* sourceBrushNode =
+    new BrushNode{brushBuilder.createCube(64.0, "material") | kdl::value()};
+  auto* sourceEntityNode = new EntityNode{Entity{}};
+  sourceGroupNode.addChildren({sourceBrushNode, sourceEntityNode});
+
+  auto targetGroupNode = std::unique_ptr<GroupNode>{
+    static_cast<GroupNode*>(sourceGroupNode.cloneRecursively(worldBounds))};
+  transformNode(
+    *targetGroupNode, vm::translation_matrix(vm::vec3d{128, 0, 0}), worldBounds);
+
+  auto* targetBrushNode = dynamic_cast<BrushNode*>(targetGroupNode->children().front());
+  auto* targetEntityNode = dynamic_cast<EntityNode*>(targetGroupNode->children().back());
+  REQUIRE(targetBrushNode != nullptr);
+  REQUIRE(targetEntityNode != nullptr);
+
+  // the target brush is out of sync, but it isn't recorded as changed, so it must not be
+  // cloned and compared
+  transformNode(
+    *targetBrushNode, vm::translation_matrix(vm::vec3d{0, 32, 0}), worldBounds);
+  transformNode(
+    *sourceEntityNode, vm::translation_matrix(vm::vec3d{0, 0, 16}), worldBounds);
+
+  SECTION("Only the counterparts of the changed nodes are updated")
+  {
+    updateLinkedGroupsIncrementally(
+      sourceGroupNode,
+      {sourceEntityNode},
+      {targetGroupNode.get()},
+      worldBounds,
+      taskManager)
+      | kdl::transform([&](const IncrementalUpdateLinkedGroupsResult& r) {
+          CHECK(r.replacedChildren.empty());
+          REQUIRE(r.swappedContents.size() == 1u);
+
+          const auto& [node, contents] = r.swappedContents.front();
+          CHECK(node == targetEntityNode);
+          CHECK(std::get<Entity>(contents.get()).origin() == vm::vec3d{128, 0, 16});
+        })
+      | kdl::transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("All children are compared if no changed nodes are recorded")
+  {
+    updateLinkedGroupsIncrementally(
+      sourceGroupNode, {}, {targetGroupNode.get()}, worldBounds, taskManager)
+      | kdl::transform([&](const IncrementalUpdateLinkedGroupsResult& r) {
+          CHECK(r.replacedChildren.empty());
+          CHECK_THAT(
+            kdl::vec_transform(r.swappedContents, [](const auto& p) { return p.first; }),
+            Catch::UnorderedEquals(
+              std::vector<Node*>{targetBrushNode, targetEntityNode}));
+        })
+      | kdl::transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("All children are replaced if a counterpart is missing")
+  {
+    auto* sourcePatchNode = createPatchNode();
+    sourceGroupNode.addChild(sourcePatchNode);
+
+    updateLinkedGroupsIncrementally(
+      sourceGroupNode,
+      {sourcePatchNode},
+      {targetGroupNode.get()},
+      worldBounds,
+      taskManager)
+      | kdl::transform([&](const IncrementalUpdateLinkedGroupsResult& r) {
+          CHECK(r.swappedContents.empty());
+          REQUIRE(r.replacedChildren.size() == 1u);
+
+          const auto& [node, newChildren] = r.replacedChildren.front();
+          CHECK(node == targetGroupNode.get());
+          CHECK(newChildren.size() == 3u);
+        })
+      | kdl::transform_error([](const auto&) { FAIL(); });
+  }
+}
+
+TEST_CASE("updateLinkedGroupsIncrementally.nestedChangedNodes")
+{
+  auto taskManager = kdl::task_manager{};
+
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto brushBuilder = BrushBuilder{MapFormat::Quake3, worldBounds};
+
+  auto sourceGroupNode = GroupNode{Group{"outer"}};
+  auto* sourceInnerGroupNode = new GroupNode{Group{"inner"}};
+  auto* sourceBrushNode =
+    new BrushNode{brushBuilder.createCube(64.0, "material") | kdl::value()};
+  auto* sourceOuterBrushNode =
+    new BrushNode{brushBuilder.createCube(64.0, "material") | kdl::value()};
+  sourceInnerGroupNode->addChild(sourceBrushNode);
+  sourceGroupNode.addChildren({sourceInnerGroupNode, sourceOuterBrushNode});
+
+  auto targetGroupNode = std::unique_ptr<GroupNode>{
+    static_cast<GroupNode*>(sourceGroupNode.cloneRecursively(worldBounds))};
+  transformNode(
+    *targetGroupNode, vm::translation_matrix(vm::vec3d{128, 0, 0}), worldBounds);
+
+  auto* targetInnerGroupNode =
+    dynamic_cast<GroupNode*>(targetGroupNode->children().front());
+  auto* targetOuterBrushNode =
+    dynamic_cast<BrushNode*>(targetGroupNode->children().back());
+  REQUIRE(targetInnerGroupNode != nullptr);
+  REQUIRE(targetOuterBrushNode != nullptr);
+  auto* targetBrushNode =
+    dynamic_cast<BrushNode*>(targetInnerGroupNode->children().front());
+  REQUIRE(targetBrushNode != nullptr);
+
+  // the target outer brush is out of sync, but it isn't recorded as changed
+  transformNode(
+    *targetOuterBrushNode, vm::translation_matrix(vm::vec3d{0, 32, 0}), worldBounds);
+  transformNode(
+    *sourceBrushNode, vm::translation_matrix(vm::vec3d{0, 0, 16}), worldBounds);
+
+  updateLinkedGroupsIncrementally(
+    sourceGroupNode, {sourceBrushNode}, {targetGroupNode.get()}, worldBounds, taskManager)
+    | kdl::transform([&](const IncrementalUpdateLinkedGroupsResult& r) {
+        CHECK(r.replacedChildren.empty());
+        REQUIRE(r.swappedContents.size() == 1u);
+
+        const auto& [node, contents] = r.swappedContents.front();
+        CHECK(node == targetBrushNode);
+        CHECK(
+          std::get<Brush>(contents.get()).bounds()
+          == sourceBrushNode->physicalBounds().translate(vm::vec3d{128, 0, 0}));
+      })
+    | kdl::transform_error([](const auto&) { FAIL(); });
+}
+
 TEST_CASE("initializeLinkIds")
 {
   auto brushBuilder = BrushBuilder{MapFormat::Quake3, vm::bbox3d{8192.0}};
@@ -0,0 +1,126 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushNode.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/NodeContents.h"
+#include "mdl/NodeContentsDelta.h"
+#include "mdl/UVCoordSystem.h"
+
+#include "kdl/result.h"
+
+#include "vm/mat_ext.h"
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+
+TEST_CASE("NodeContentsDelta")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto mapFormat = GENERATE(MapFormat::Quake3, MapFormat::Valve);
+
+  auto builder = BrushBuilder{mapFormat, worldBounds};
+  const auto originalBrush = builder.createCube(64.0, "some_material") | kdl::value();
+  const auto brushNode = BrushNode{originalBrush};
+
+  SECTION("Stores only the changed faces of a brush")
+  {
+    auto modifiedBrush = originalBrush;
+
+    auto attributes = modifiedBrush.face(1).attributes();
+    attributes.setMaterialName("other_material");
+    modifiedBrush.face(1).setAttributes(attributes);
+    modifiedBrush.face(3).rotateUV(45.0f);
+
+    auto delta = NodeContentsDelta{NodeContents{modifiedBrush}, brushNode};
+    CHECK(delta.storesChangedFacesOnly());
+    CHECK(delta.sizeInBytes() < NodeContents{modifiedBrush}.sizeInBytes());
+
+    const auto restoredContents = std::move(delta).restore(brushNode);
+    const auto& restoredBrush = std::get<Brush>(restoredContents.get());
+    CHECK(restoredBrush == modifiedBrush);
+    CHECK(restoredBrush.vertexPositions() == modifiedBrush.vertexPositions());
+    for (size_t i = 0; i < restoredBrush.faceCount(); ++i)
+    {
+      CHECK(
+        restoredBrush.face(i).uvCoordSystem() == modifiedBrush.face(i).uvCoordSystem());
+      CHECK(restoredBrush.face(i).geometry() != nullptr);
+    }
+  }
+
+  SECTION("Stores unchanged brushes without any faces")
+  {
+    auto delta = NodeContentsDelta{NodeContents{originalBrush}, brushNode};
+    CHECK(delta.storesChangedFacesOnly());
+    CHECK(delta.sizeInBytes() == sizeof(NodeContentsDelta));
+
+    const auto restoredContents = std::move(delta).restore(brushNode);
+    CHECK(std::get<Brush>(restoredContents.get()) == originalBrush);
+  }
+
+  SECTION("Stores brushes with changed geometry as they are")
+  {
+    auto modifiedBrush = originalBrush;
+    REQUIRE(modifiedBrush
+              .transform(worldBounds, vm::translation_matrix(vm::vec3d{16, 0, 0}), false)
+              .is_success());
+
+    auto delta = NodeContentsDelta{NodeContents{modifiedBrush}, brushNode};
+    CHECK_FALSE(delta.storesChangedFacesOnly());
+
+    const auto restoredContents = std::move(delta).restore(brushNode);
+    CHECK(std::get<Brush>(restoredContents.get()) == modifiedBrush);
+  }
+
+  SECTION("Stores other contents as they are")
+  {
+    const auto entity = Entity{{{"classname", "light"}}};
+    const auto entityNode = EntityNode{Entity{}};
+
+    auto delta = NodeContentsDelta{NodeContents{entity}, entityNode};
+    CHECK_FALSE(delta.storesChangedFacesOnly());
+
+    const auto restoredContents = std::move(delta).restore(entityNode);
+    CHECK(std::get<Entity>(restoredContents.get()) == entity);
+  }
+
+  SECTION("Restores against node contents")
+  {
+    auto modifiedBrush = originalBrush;
+    modifiedBrush.face(2).rotateUV(90.0f);
+
+    const auto baseContents = NodeContents{originalBrush};
+    auto delta = NodeContentsDelta{NodeContents{modifiedBrush}, baseContents};
+    CHECK(delta.storesChangedFacesOnly());
+
+    const auto restoredContents = std::move(delta).restore(baseContents);
+    const auto& restoredBrush = std::get<Brush>(restoredContents.get());
+    CHECK(restoredBrush == modifiedBrush);
+    CHECK(restoredBrush.face(2).uvCoordSystem() == modifiedBrush.face(2).uvCoordSystem());
+  }
+}
+
+} // namespace tb::mdl
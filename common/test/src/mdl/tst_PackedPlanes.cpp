@@ -0,0 +1,182 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushFace.h"
+#include "mdl/MapFormat.h"
+#include "mdl/PackedPlanes.h"
+
+#include "kdl/result.h"
+#include "kdl/vector_utils.h"
+
+#include "vm/approx.h"
+#include "vm/ray_io.h" // IWYU pragma: keep
+#include "vm/vec_io.h" // IWYU pragma: keep
+
+#include <optional>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+namespace
+{
+
+PackedPlanes makePackedPlanes(const Brush& brush)
+{
+  return PackedPlanes{kdl::vec_transform(
+    brush.faces(), [](const auto& face) { return face.boundary(); })};
+}
+
+std::optional<std::tuple<double, size_t>> intersectFaces(
+  const Brush& brush, const vm::ray3d& ray)
+{
+  for (size_t i = 0; i < brush.faceCount(); ++i)
+  {
+    if (const auto distance = brush.face(i).intersectWithRay(ray))
+    {
+      return std::tuple{*distance, i};
+    }
+  }
+  return std::nullopt;
+}
+
+} // namespace
+
+TEST_CASE("PackedPlanes")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  SECTION("intersectWithRay")
+  {
+    SECTION("Empty planes")
+    {
+      CHECK(PackedPlanes{}.intersectWithRay(vm::ray3d{{0, 0, 0}, {1, 0, 0}})
+            == std::nullopt);
+    }
+
+    const auto brush =
+      builder.createCuboid(vm::bbox3d{{0, 0, 0}, {16, 16, 16}}, "material")
+      | kdl::value();
+    const auto planes = makePackedPlanes(brush);
+    REQUIRE(planes.size() == 6);
+
+    const auto findFace = [&](const vm::vec3d& normal) {
+      for (size_t i = 0; i < brush.faceCount(); ++i)
+      {
+        if (brush.face(i).boundary().normal == normal)
+        {
+          return i;
+        }
+      }
+      FAIL("no face with the given normal");
+      return brush.faceCount();
+    };
+
+    using T = std::tuple<vm::ray3d, std::optional<std::tuple<double, vm::vec3d>>>;
+
+    // clang-format off
+    const auto
+    [ray,                                   expected] = GENERATE(values<T>({
+    // the ray enters through a face
+    {vm::ray3d{{8, -8, 8}, {0, 1, 0}},      std::tuple{8.0, vm::vec3d{0, -1, 0}}},
+    {vm::ray3d{{8, 8, 32}, {0, 0, -1}},     std::tuple{16.0, vm::vec3d{0, 0, 1}}},
+    // the ray origin is on a face
+    {vm::ray3d{{8, 0, 8}, {0, 1, 0}},       std::tuple{0.0, vm::vec3d{0, -1, 0}}},
+    // the ray points away from the cuboid
+    {vm::ray3d{{8, -8, 8}, {0, -1, 0}},     std::nullopt},
+    // the ray misses the cuboid
+    {vm::ray3d{{32, -8, 8}, {0, 1, 0}},     std::nullopt},
+    {vm::ray3d{{-8, -8, 8}, {0, 1, 1}},     std::nullopt},
+    // the ray origin is inside of the cuboid
+    {vm::ray3d{{8, 8, 8}, {0, 1, 0}},       std::nullopt},
+    }));
+    // clang-format on
+
+    CAPTURE(ray);
+
+    const auto hit = planes.intersectWithRay(ray);
+    if (expected)
+    {
+      const auto& [expectedDistance, expectedNormal] = *expected;
+
+      REQUIRE(hit != std::nullopt);
+      const auto& [distance, index] = *hit;
+      CHECK(distance == vm::approx{expectedDistance});
+      CHECK(index == findFace(expectedNormal));
+    }
+    else
+    {
+      CHECK(hit == std::nullopt);
+    }
+  }
+
+  SECTION("Rays through an edge hit the face with the lower index")
+  {
+    const auto brush =
+      builder.createCuboid(vm::bbox3d{{0, 0, 0}, {16, 16, 16}}, "material")
+      | kdl::value();
+    const auto planes = makePackedPlanes(brush);
+
+    const auto ray = vm::ray3d{{-8, -8, 8}, vm::normalize(vm::vec3d{1, 1, 0})};
+    const auto hit = planes.intersectWithRay(ray);
+    REQUIRE(hit != std::nullopt);
+    CHECK(hit == intersectFaces(brush, ray));
+  }
+
+  SECTION("Results match intersecting the faces one by one")
+  {
+    const auto brush =
+      builder.createIcoSphere(vm::bbox3d{{-64, -64, -64}, {64, 64, 64}}, 2, "material")
+      | kdl::value();
+    const auto planes = makePackedPlanes(brush);
+
+    auto rng = std::mt19937{1};
+    auto origin = std::uniform_real_distribution<double>{-256.0, 256.0};
+    auto target = std::uniform_real_distribution<double>{-80.0, 80.0};
+
+    auto hitCount = size_t(0);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      const auto rayOrigin = vm::vec3d{origin(rng), origin(rng), origin(rng)};
+      const auto rayTarget = vm::vec3d{target(rng), target(rng), target(rng)};
+      const auto ray = vm::ray3d{rayOrigin, vm::normalize(rayTarget - rayOrigin)};
+      CAPTURE(ray);
+
+      const auto hit = planes.intersectWithRay(ray);
+      const auto expected = intersectFaces(brush, ray);
+      REQUIRE(hit.has_value() == expected.has_value());
+      if (hit)
+      {
+        CHECK(std::get<0>(*hit) == vm::approx{std::get<0>(*expected)});
+        CHECK(std::get<1>(*hit) == std::get<1>(*expected));
+        ++hitCount;
+      }
+    }
+
+    CHECK(hitCount > 0);
+  }
+}
+
+} // namespace tb::mdl
@@ -22,12 +22,16 @@
 #include "mdl/Polyhedron_IO.h" // IWYU pragma: keep
 #include "mdl/Polyhedron_Instantiation.h"
 
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
+#include "vm/mat_io.h" // IWYU pragma: keep
 #include "vm/vec.h"
 #include "vm/vec_io.h"
 
 #include <algorithm>
 #include <iterator>
 #include <set>
+#include <tuple>
 
 #include "Catch2.h"
 
@@ -392,6 +396,43 @@ TEST_CASE("PolyhedronTest.swap")
   CHECK(rhs.bounds() == original.bounds());
 }
 
+TEST_CASE("PolyhedronTest.transform")
+{
+  const auto p1 = vm::vec3d{0, 0, 8};
+  const auto p2 = vm::vec3d{8, 0, 0};
+  const auto p3 = vm::vec3d{-8, 0, 0};
+  const auto p4 = vm::vec3d{0, 16, 0};
+
+  using T = std::tuple<vm::mat4x4d>;
+
+  // clang-format off
+  const auto
+  [transformation] = GENERATE(values<T>({
+  {vm::translation_matrix(vm::vec3d{16, -32, 8})},
+  {vm::rotation_matrix(vm::vec3d{0, 0, 1}, vm::to_radians(90.0))},
+  {vm::scaling_matrix(vm::vec3d{2, 1, 3})},
+  {vm::mirror_matrix<double>(vm::axis::x)},
+  {vm::translation_matrix(vm::vec3d{16, 0, 0}) * vm::mirror_matrix<double>(vm::axis::z)},
+  }));
+  // clang-format on
+
+  CAPTURE(transformation);
+
+  auto p = Polyhedron3d{p1, p2, p3, p4};
+  p.transform(transformation);
+
+  const auto expected = Polyhedron3d{
+    transformation * p1, transformation * p2, transformation * p3, transformation * p4};
+  CHECK(p == expected);
+  CHECK(p.bounds() == expected.bounds());
+
+  for (const auto* face : p.faces())
+  {
+    CHECK(vm::is_equal(face->normal(), face->plane().normal, vm::Cd::almost_zero()));
+    CHECK(face->plane().point_status(face->origin()) == vm::plane_status::inside);
+  }
+}
+
 TEST_CASE("PolyhedronTest.clipCubeWithHorizontalPlane")
 {
   const auto p1 = vm::vec3d{-64, -64, -64};
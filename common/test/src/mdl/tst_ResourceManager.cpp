@@ -127,21 +127,119 @@ TEST_CASE("ResourceManager")
     REQUIRE(std::holds_alternative<ResourceReady<MockResource>>(resource2->state()));
     CHECK(!resourceManager.needsProcessing());
 
+    // releasing a resource is only noticed by the release checks in process
     resource1.reset();
     REQUIRE(std::holds_alternative<ResourceReady<MockResource>>(resource2->state()));
-    CHECK(resourceManager.needsProcessing());
+    CHECK(!resourceManager.needsProcessing());
 
     resourceManager.process(taskRunner, processContext);
     REQUIRE(std::holds_alternative<ResourceReady<MockResource>>(resource2->state()));
-    CHECK(!resourceManager.needsProcessing());
+    CHECK(resourceManager.resources().size() == 1);
+
+    // after finding a released resource, the remaining resource is checked once more
+    while (resourceManager.needsProcessing())
+    {
+      resourceManager.process(taskRunner, processContext);
+    }
+    REQUIRE(std::holds_alternative<ResourceReady<MockResource>>(resource2->state()));
+    CHECK(resourceManager.resources().size() == 1);
 
     resource2.reset();
+    CHECK(!resourceManager.needsProcessing());
+
+    resourceManager.process(taskRunner, processContext);
+    CHECK(resourceManager.resources().empty());
+    CHECK(!resourceManager.needsProcessing());
+  }
+
+  SECTION("requestReleaseCheck")
+  {
+    auto resources = std::vector<std::shared_ptr<ResourceT>>{};
+    for (size_t i = 0; i < ResourceManager::ReleaseCheckBatchSize + 1; ++i)
+    {
+      resources.push_back(std::make_shared<ResourceT>(MockResource{}));
+      resourceManager.addResource(resources.back());
+    }
+
+    resourceManager.process(taskRunner, processContext);
+    REQUIRE(!resourceManager.needsProcessing());
+
+    resourceManager.requestReleaseCheck();
+    CHECK(resourceManager.needsProcessing());
+
+    resourceManager.process(taskRunner, processContext);
     CHECK(resourceManager.needsProcessing());
 
     resourceManager.process(taskRunner, processContext);
     CHECK(!resourceManager.needsProcessing());
   }
 
+  SECTION("counts")
+  {
+    CHECK(resourceManager.counts() == ResourceCounts{});
+
+    auto resource1 = std::make_shared<ResourceT>(mockResourceLoader);
+    auto resource2 = std::make_shared<ResourceT>(mockResourceLoader);
+    resourceManager.addResource(resource1);
+    resourceManager.addResource(resource2);
+    CHECK(resourceManager.counts() == ResourceCounts{2, 0, 0, 0});
+
+    resourceManager.process(taskRunner, processContext);
+    CHECK(resourceManager.counts() == ResourceCounts{2, 2, 0, 0});
+
+    mockTaskRunner.resolveNextPromise();
+    resourceManager.process(taskRunner, processContext);
+    CHECK(resourceManager.counts() == ResourceCounts{2, 1, 0, 0});
+
+    mockTaskRunner.resolveNextPromise();
+    resourceManager.process(taskRunner, processContext);
+    CHECK(resourceManager.counts() == ResourceCounts{1, 0, 1, 0});
+
+    resourceManager.process(taskRunner, processContext);
+    CHECK(resourceManager.counts() == ResourceCounts{0, 0, 2, 0});
+
+    resource1.reset();
+    resourceManager.process(taskRunner, processContext);
+    CHECK(resourceManager.counts() == ResourceCounts{0, 0, 1, 1});
+  }
+
+  SECTION("release checks are spread over multiple calls")
+  {
+    auto resources = std::vector<std::shared_ptr<ResourceT>>{};
+    for (size_t i = 0; i < ResourceManager::ReleaseCheckBatchSize + 1; ++i)
+    {
+      resources.push_back(std::make_shared<ResourceT>(MockResource{}));
+      resourceManager.addResource(resources.back());
+    }
+
+    resourceManager.process(taskRunner, processContext);
+    REQUIRE(
+      resourceManager.counts()
+      == ResourceCounts{0, 0, ResourceManager::ReleaseCheckBatchSize + 1, 0});
+
+    // the next call checks the last resource and then wraps around, but it doesn't get
+    // to the resource before the last one
+    resources.front().reset();
+    resources[ResourceManager::ReleaseCheckBatchSize - 1].reset();
+    CHECK(!resourceManager.needsProcessing());
+
+    resourceManager.process(taskRunner, processContext);
+    CHECK(resourceManager.resources().size() == ResourceManager::ReleaseCheckBatchSize);
+    CHECK(resourceManager.needsProcessing());
+
+    resourceManager.process(taskRunner, processContext);
+    CHECK(
+      resourceManager.resources().size() == ResourceManager::ReleaseCheckBatchSize - 1);
+
+    // after finding a released resource, all other resources are checked once more
+    while (resourceManager.needsProcessing())
+    {
+      resourceManager.process(taskRunner, processContext);
+    }
+    CHECK(
+      resourceManager.resources().size() == ResourceManager::ReleaseCheckBatchSize - 1);
+  }
+
   SECTION("addResource")
   {
     auto resource1 = std::make_shared<ResourceT>(mockResourceLoader);
@@ -25,19 +25,54 @@
 #include "mdl/EntityNode.h"
 #include "mdl/Group.h"
 #include "mdl/GroupNode.h"
+#include "mdl/Issue.h"
 #include "mdl/Layer.h"
 #include "mdl/LayerNode.h"
 #include "mdl/MapFormat.h"
 #include "mdl/PatchNode.h"
+#include "mdl/Validator.h"
+#include "mdl/WorldBoundsValidator.h"
 #include "mdl/WorldNode.h"
 #include "octree.h"
 
 #include "kdl/result.h"
+#include "kdl/task_manager.h"
+#include "kdl/vector_utils.h"
+
+#include "vm/mat_ext.h"
+
+#include <atomic>
+#include <stdexcept>
 
 #include "Catch2.h"
 
 namespace tb::mdl
 {
+namespace
+{
+
+class BrushCountingValidator : public Validator
+{
+private:
+  std::atomic<size_t>& m_validatedBrushes;
+
+public:
+  explicit BrushCountingValidator(std::atomic<size_t>& validatedBrushes)
+    : Validator{freeIssueType(), "Brush counting validator"}
+    , m_validatedBrushes{validatedBrushes}
+  {
+  }
+
+private:
+  void doValidate(
+    BrushNode& brushNode, std::vector<std::unique_ptr<Issue>>& issues) const override
+  {
+    ++m_validatedBrushes;
+    issues.push_back(std::make_unique<Issue>(type(), brushNode, "brush"));
+  }
+};
+
+} // namespace
 
 TEST_CASE("WorldNodeTest.canAddChild")
 {
@@ -236,6 +271,72 @@ TEST_CASE("WorldNodeTest.nodeTreeUpdates")
       nodeTree.find_containers(vm::vec3d{384, 384, 384}),
       Catch::UnorderedEquals(std::vector<Node*>{entityNode, brushNode, patchNode}));
   }
+
+  SECTION("Deferred updates are applied in one batch")
+  {
+    groupNode->addChildren({entityNode, brushNode});
+    worldNode.defaultLayer()->addChild(groupNode);
+
+    worldNode.deferNodeTreeUpdates();
+    transformNode(
+      *entityNode, vm::translation_matrix(vm::vec3d(384, 384, 384)), worldBounds);
+    transformNode(
+      *brushNode, vm::translation_matrix(vm::vec3d(384, 384, 384)), worldBounds);
+
+    CHECK_THAT(
+      nodeTree.find_containers(vm::vec3d{0, 0, 0}),
+      Catch::UnorderedEquals(std::vector<Node*>{entityNode, brushNode}));
+
+    SECTION("Applying the updates")
+    {
+      worldNode.applyDeferredNodeTreeUpdates();
+    }
+
+    SECTION("Adding a node applies the updates")
+    {
+      worldNode.defaultLayer()->addChild(patchNode);
+    }
+
+    SECTION("Destroying a guard applies the updates")
+    {
+      worldNode.applyDeferredNodeTreeUpdates();
+
+      try
+      {
+        const auto deferNodeTreeUpdates = DeferNodeTreeUpdates{worldNode};
+        transformNode(
+          *entityNode, vm::translation_matrix(vm::vec3d(-384, -384, -384)), worldBounds);
+        transformNode(
+          *brushNode, vm::translation_matrix(vm::vec3d(-384, -384, -384)), worldBounds);
+
+        REQUIRE_THAT(
+          nodeTree.find_containers(vm::vec3d{384, 384, 384}),
+          Catch::UnorderedEquals(std::vector<Node*>{entityNode, brushNode}));
+
+        throw std::runtime_error{"error"};
+      }
+      catch (const std::runtime_error&)
+      {
+      }
+
+      REQUIRE_THAT(
+        nodeTree.find_containers(vm::vec3d{0, 0, 0}),
+        Catch::UnorderedEquals(std::vector<Node*>{entityNode, brushNode}));
+
+      // the world no longer defers the updates
+      transformNode(
+        *entityNode, vm::translation_matrix(vm::vec3d(384, 384, 384)), worldBounds);
+      transformNode(
+        *brushNode, vm::translation_matrix(vm::vec3d(384, 384, 384)), worldBounds);
+    }
+
+    const auto containers = nodeTree.find_containers(vm::vec3d{0, 0, 0});
+    CHECK_FALSE(kdl::vec_contains(containers, entityNode));
+    CHECK_FALSE(kdl::vec_contains(containers, brushNode));
+    CHECK_THAT(
+      nodeTree.find_containers(vm::vec3d{384, 384, 384}),
+      Catch::UnorderedEquals(std::vector<Node*>{entityNode, brushNode}));
+  }
 }
 
 TEST_CASE("WorldNodeTest.rebuildNodeTree")
@@ -316,6 +417,81 @@ TEST_CASE("WorldNodeTest.disableNodeTreeUpdates")
   CHECK(nodeTree.contains(patchNode));
 }
 
+TEST_CASE("WorldNodeTest.findNodesWithLinkId")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  auto* groupNode = new GroupNode{Group{"group"}};
+  auto* entityNode = new EntityNode{Entity{}};
+  auto* brushNode = new BrushNode{
+    BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "material") | kdl::value()};
+
+  setLinkId(*groupNode, "group");
+  setLinkId(*entityNode, "object");
+  setLinkId(*brushNode, "object");
+
+  groupNode->addChildren({entityNode, brushNode});
+
+  CHECK(worldNode.findNodesWithLinkId("group").empty());
+
+  worldNode.defaultLayer()->addChild(groupNode);
+
+  CHECK(worldNode.findNodesWithLinkId("group") == std::vector<Node*>{groupNode});
+  CHECK_THAT(
+    worldNode.findNodesWithLinkId("object"),
+    Catch::UnorderedEquals(std::vector<Node*>{entityNode, brushNode}));
+
+  SECTION("Changing a link ID updates the index")
+  {
+    setLinkId(*brushNode, "brush");
+
+    CHECK(worldNode.findNodesWithLinkId("object") == std::vector<Node*>{entityNode});
+    CHECK(worldNode.findNodesWithLinkId("brush") == std::vector<Node*>{brushNode});
+  }
+
+  // the index refers to the link ID of the node that was added first
+  SECTION("Changing the link ID of the first node with a shared link ID")
+  {
+    setLinkId(*entityNode, "entity");
+
+    CHECK(worldNode.findNodesWithLinkId("object") == std::vector<Node*>{brushNode});
+    CHECK(worldNode.findNodesWithLinkId("entity") == std::vector<Node*>{entityNode});
+
+    setLinkId(*entityNode, "object");
+    CHECK_THAT(
+      worldNode.findNodesWithLinkId("object"),
+      Catch::UnorderedEquals(std::vector<Node*>{entityNode, brushNode}));
+  }
+
+  SECTION("Removing the first node with a shared link ID")
+  {
+    groupNode->removeChild(entityNode);
+    setLinkId(*entityNode, "entity");
+    delete entityNode;
+
+    CHECK(worldNode.findNodesWithLinkId("object") == std::vector<Node*>{brushNode});
+
+    setLinkId(*brushNode, "brush");
+    CHECK(worldNode.findNodesWithLinkId("object").empty());
+    CHECK(worldNode.findNodesWithLinkId("brush") == std::vector<Node*>{brushNode});
+  }
+
+  SECTION("Removing a node removes its descendants from the index")
+  {
+    worldNode.defaultLayer()->removeChild(groupNode);
+
+    CHECK(worldNode.findNodesWithLinkId("group").empty());
+    CHECK(worldNode.findNodesWithLinkId("object").empty());
+
+    setLinkId(*groupNode, "other");
+    CHECK(worldNode.findNodesWithLinkId("other").empty());
+
+    delete groupNode;
+  }
+}
+
 TEST_CASE("WorldNodeTest.persistentIdOfDefaultLayer")
 {
   auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
@@ -423,4 +599,108 @@ TEST_CASE("WorldNodeTest.setPersistentIdsWhenAddingLayersAndGroups")
   CHECK(groupNode->persistentId() == 2u);
 }
 
+TEST_CASE("WorldNodeTest.validateAllIssues")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto taskManager = kdl::task_manager{};
+  auto validatedBrushes = std::atomic<size_t>{0};
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  worldNode.registerValidator(std::make_unique<BrushCountingValidator>(validatedBrushes));
+
+  const auto builder = BrushBuilder{mapFormat, worldBounds};
+  auto brushNodes = std::vector<BrushNode*>{};
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    auto* brushNode = new BrushNode{builder.createCube(64.0, "material") | kdl::value()};
+    worldNode.defaultLayer()->addChild(brushNode);
+    brushNodes.push_back(brushNode);
+  }
+
+  const auto validationTimes = worldNode.validateAllIssues(taskManager);
+  REQUIRE(validationTimes.size() == 1);
+  CHECK(validationTimes.front().description == "Brush counting validator");
+  CHECK(validatedBrushes == 1000);
+
+  const auto validators = worldNode.registeredValidators();
+  for (auto* brushNode : brushNodes)
+  {
+    CHECK(brushNode->issues(validators).size() == 1u);
+  }
+  CHECK(validatedBrushes == 1000);
+
+  SECTION("Valid nodes are not validated again")
+  {
+    worldNode.validateAllIssues(taskManager);
+    CHECK(validatedBrushes == 1000);
+  }
+
+  SECTION("Changed nodes are validated again")
+  {
+    const auto transform = vm::translation_matrix(vm::vec3d{16, 0, 0});
+    auto brush = brushNodes.front()->brush();
+    REQUIRE(brush.transform(worldBounds, transform, false).is_success());
+    brushNodes.front()->setBrush(std::move(brush));
+
+    worldNode.validateAllIssues(taskManager);
+    CHECK(validatedBrushes == 1001);
+    CHECK(brushNodes.front()->issues(validators).size() == 1u);
+  }
+}
+
+TEST_CASE("WorldNodeTest.validateAllIssuesWithCandidates")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto validatorBounds = vm::bbox3d{1024.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto taskManager = kdl::task_manager{};
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  worldNode.registerValidator(std::make_unique<WorldBoundsValidator>(validatorBounds));
+
+  const auto builder = BrushBuilder{mapFormat, worldBounds};
+  const auto createBrushNode = [&](const vm::vec3d& position) {
+    auto brush = builder.createCube(64.0, "material") | kdl::value();
+    REQUIRE(
+      brush.transform(worldBounds, vm::translation_matrix(position), false).is_success());
+    return new BrushNode{std::move(brush)};
+  };
+
+  auto brushNodesInside = std::vector<BrushNode*>{};
+  for (size_t i = 0; i < 100; ++i)
+  {
+    auto* brushNode =
+      createBrushNode(vm::vec3d{double(i % 10), double(i / 10), 0.0} * 64.0);
+    worldNode.defaultLayer()->addChild(brushNode);
+    brushNodesInside.push_back(brushNode);
+  }
+
+  auto* brushNodeOutside = createBrushNode(vm::vec3d{2048, 0, 0});
+  worldNode.defaultLayer()->addChild(brushNodeOutside);
+
+  auto* brushNodeStraddling = createBrushNode(vm::vec3d{1024, 0, 0});
+  auto* entityNode = new EntityNode{Entity{}};
+  entityNode->addChild(brushNodeStraddling);
+  worldNode.defaultLayer()->addChild(entityNode);
+
+  auto* pointEntityNodeOutside = new EntityNode{Entity{{{"origin", "-2048 0 0"}}}};
+  worldNode.defaultLayer()->addChild(pointEntityNodeOutside);
+
+  worldNode.validateAllIssues(taskManager);
+
+  const auto validators = worldNode.registeredValidators();
+  for (auto* brushNode : brushNodesInside)
+  {
+    CHECK(brushNode->issuesValid());
+    CHECK(brushNode->issues(validators).empty());
+  }
+  CHECK(brushNodeOutside->issues(validators).size() == 1u);
+  CHECK(brushNodeStraddling->issues(validators).size() == 1u);
+  CHECK(entityNode->issues(validators).size() == 1u);
+  CHECK(pointEntityNodeOutside->issues(validators).size() == 1u);
+}
+
 } // namespace tb::mdl
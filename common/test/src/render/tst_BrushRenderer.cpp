@@ -0,0 +1,106 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/MapFormat.h"
+#include "render/BrushRenderer.h"
+#include "render/PerspectiveCamera.h"
+#include "render/ViewFrustum.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include <memory>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::render
+{
+
+TEST_CASE("BrushRendererTest.cullingStats")
+{
+  const auto worldBounds = vm::bbox3d{16384.0};
+  const auto builder = mdl::BrushBuilder{mdl::MapFormat::Standard, worldBounds};
+
+  const auto createBrushNode = [&](const vm::vec3d& min) {
+    return std::make_unique<mdl::BrushNode>(
+      builder.createCuboid(vm::bbox3d{min, min + vm::vec3d{64, 64, 64}}, "material")
+      | kdl::value());
+  };
+
+  // brushes are batched in cells with an edge length of 2048 units
+  auto brushNodes = std::vector<std::unique_ptr<mdl::BrushNode>>{};
+  brushNodes.push_back(createBrushNode({256, -32, -32}));
+  brushNodes.push_back(createBrushNode({512, -32, -32}));
+  brushNodes.push_back(createBrushNode({-4096, -32, -32}));
+  brushNodes.push_back(createBrushNode({4096, 12288, -32}));
+
+  auto renderer = BrushRenderer{};
+  for (const auto& brushNode : brushNodes)
+  {
+    renderer.addBrush(brushNode.get());
+  }
+
+  // both cameras have a 90 degree field of view
+  auto positiveXCamera = PerspectiveCamera{
+    90.0f,
+    1.0f,
+    8192.0f,
+    Camera::Viewport{0, 0, 800, 800},
+    vm::vec3f{0, 0, 0},
+    vm::vec3f{1, 0, 0},
+    vm::vec3f{0, 0, 1}};
+  const auto negativeXCamera = PerspectiveCamera{
+    90.0f,
+    1.0f,
+    8192.0f,
+    Camera::Viewport{0, 0, 800, 800},
+    vm::vec3f{0, 0, 0},
+    vm::vec3f{-1, 0, 0},
+    vm::vec3f{0, 0, 1}};
+
+  CHECK(renderer.cullingStats(positiveXCamera) == CullingStats{2, 2});
+
+  SECTION("Stats are counted per camera")
+  {
+    CHECK(renderer.cullingStats(negativeXCamera) == CullingStats{1, 3});
+    CHECK(renderer.cullingStats(positiveXCamera) == CullingStats{2, 2});
+  }
+
+  SECTION("Stats are updated when the camera changes")
+  {
+    positiveXCamera.setDirection(vm::vec3f{0, 1, 0}, vm::vec3f{0, 0, 1});
+    CHECK(renderer.cullingStats(positiveXCamera) == CullingStats{1, 3});
+  }
+
+  SECTION("Stats are updated when brushes change")
+  {
+    renderer.removeBrush(brushNodes[0].get());
+    CHECK(renderer.cullingStats(positiveXCamera) == CullingStats{1, 2});
+
+    renderer.addBrush(brushNodes[0].get());
+    CHECK(renderer.cullingStats(positiveXCamera) == CullingStats{2, 2});
+  }
+}
+
+} // namespace tb::render
@@ -0,0 +1,103 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/OrthographicCamera.h"
+#include "render/PerspectiveCamera.h"
+#include "render/ViewFrustum.h"
+
+#include "vm/bbox.h"
+
+#include "Catch2.h"
+
+#include <tuple>
+
+namespace tb::render
+{
+
+TEST_CASE("ViewFrustumTest.perspectiveCamera")
+{
+  // looks along the positive X axis from the origin with a 90 degree field of view
+  const auto camera = PerspectiveCamera{
+    90.0f,
+    1.0f,
+    8192.0f,
+    Camera::Viewport{0, 0, 800, 800},
+    vm::vec3f{0, 0, 0},
+    vm::vec3f{1, 0, 0},
+    vm::vec3f{0, 0, 1}};
+
+  const auto frustum = ViewFrustum{camera};
+
+  using T = std::tuple<vm::bbox3f, bool>;
+
+  // clang-format off
+  const auto
+  [bounds,                                                    expectedResult] = GENERATE(values<T>({
+  {vm::bbox3f{{ 100,  -16,  -16}, { 132,   16,   16}},        true},
+  {vm::bbox3f{{ 100,   90,  -16}, { 132,  110,   16}},        true},
+  {vm::bbox3f{{ 100,  -16,   90}, { 132,   16,  110}},        true},
+  {vm::bbox3f{{ -16,  -16,  -16}, {  16,   16,   16}},        true},
+  {vm::bbox3f{{-132,  -16,  -16}, {-100,   16,   16}},        false},
+  {vm::bbox3f{{ 100,  200,  -16}, { 132,  232,   16}},        false},
+  {vm::bbox3f{{ 100, -232,  -16}, { 132, -200,   16}},        false},
+  {vm::bbox3f{{ 100,  -16,  200}, { 132,   16,  232}},        false},
+  {vm::bbox3f{{ 100,  -16, -232}, { 132,   16, -200}},        false},
+  }));
+  // clang-format on
+
+  CAPTURE(bounds);
+
+  CHECK(frustum.intersects(bounds) == expectedResult);
+  CHECK(frustum.intersects(vm::bbox3d{bounds}) == expectedResult);
+}
+
+TEST_CASE("ViewFrustumTest.orthographicCamera")
+{
+  // looks down the negative Z axis, the viewport covers [-400, 400] x [-300, 300]
+  const auto camera = OrthographicCamera{
+    1.0f,
+    8192.0f,
+    Camera::Viewport{0, 0, 800, 600},
+    vm::vec3f{0, 0, 1024},
+    vm::vec3f{0, 0, -1},
+    vm::vec3f{0, 1, 0}};
+
+  const auto frustum = ViewFrustum{camera};
+
+  using T = std::tuple<vm::bbox3f, bool>;
+
+  // clang-format off
+  const auto
+  [bounds,                                                    expectedResult] = GENERATE(values<T>({
+  {vm::bbox3f{{ -16,  -16,  -16}, {  16,   16,   16}},        true},
+  {vm::bbox3f{{ 380,  280,  -16}, { 420,  320,   16}},        true},
+  {vm::bbox3f{{-16,   -16, -8192}, { 16,   16, -8000}},       true},
+  {vm::bbox3f{{ 410,  -16,  -16}, { 450,   16,   16}},        false},
+  {vm::bbox3f{{-450,  -16,  -16}, {-410,   16,   16}},        false},
+  {vm::bbox3f{{ -16,  310,  -16}, {  16,  350,   16}},        false},
+  {vm::bbox3f{{ -16, -350,  -16}, {  16, -310,   16}},        false},
+  }));
+  // clang-format on
+
+  CAPTURE(bounds);
+
+  CHECK(frustum.intersects(bounds) == expectedResult);
+}
+
+} // namespace tb::render
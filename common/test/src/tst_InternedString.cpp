@@ -0,0 +1,82 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "InternedString.h"
+
+#include <future>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb
+{
+
+TEST_CASE("InternedString")
+{
+  SECTION("Default constructed string is empty")
+  {
+    CHECK(InternedString{}.str().empty());
+    CHECK(InternedString{} == InternedString{""});
+  }
+
+  SECTION("Equal strings share the same instance")
+  {
+    const auto a = InternedString{"some_material"};
+    const auto b = InternedString{std::string{"some_"} + "material"};
+    CHECK(a == b);
+    CHECK(&a.str() == &b.str());
+    CHECK(a.str() == "some_material");
+  }
+
+  SECTION("Different strings")
+  {
+    const auto a = InternedString{"a_material"};
+    const auto b = InternedString{"b_material"};
+    CHECK(a != b);
+    CHECK(a < b);
+    CHECK(b > a);
+    CHECK(a.str() == "a_material");
+    CHECK(b.str() == "b_material");
+  }
+
+  SECTION("Interning from multiple threads")
+  {
+    auto futures = std::vector<std::future<std::vector<const std::string*>>>{};
+    for (size_t i = 0; i < 4; ++i)
+    {
+      futures.push_back(std::async(std::launch::async, [] {
+        auto result = std::vector<const std::string*>{};
+        for (size_t j = 0; j < 100; ++j)
+        {
+          result.push_back(&InternedString{"thread_material_" + std::to_string(j)}.str());
+        }
+        return result;
+      }));
+    }
+
+    const auto expected = futures.front().get();
+    for (size_t i = 1; i < futures.size(); ++i)
+    {
+      CHECK(futures[i].get() == expected);
+    }
+  }
+}
+
+} // namespace tb
@@ -0,0 +1,135 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "block_pool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb
+{
+namespace
+{
+
+// use a unique size so that other users of the pool don't interfere with the test
+using pool = block_pool<40, 8>;
+
+} // namespace
+
+TEST_CASE("block_pool")
+{
+  SECTION("allocated blocks are distinct and aligned")
+  {
+    auto blocks = std::vector<void*>{};
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      blocks.push_back(pool::allocate());
+    }
+
+    CHECK(std::set<void*>{blocks.begin(), blocks.end()}.size() == blocks.size());
+    for (auto* block : blocks)
+    {
+      CHECK(reinterpret_cast<std::uintptr_t>(block) % 8 == 0);
+    }
+
+    for (auto* block : blocks)
+    {
+      pool::deallocate(block);
+    }
+  }
+
+  SECTION("freed blocks are reused")
+  {
+    auto* block = pool::allocate();
+    pool::deallocate(block);
+    CHECK(pool::allocate() == block);
+    pool::deallocate(block);
+  }
+
+  SECTION("blocks can be freed on another thread")
+  {
+    auto blocks = std::vector<void*>{};
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      blocks.push_back(pool::allocate());
+    }
+
+    auto thread = std::thread{[&]() {
+      for (auto* block : blocks)
+      {
+        pool::deallocate(block);
+      }
+    }};
+    thread.join();
+
+    // the other thread has returned the blocks to the shared list when it exited
+    auto reused = std::vector<void*>{};
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      reused.push_back(pool::allocate());
+    }
+
+    const auto allocated = std::set<void*>{blocks.begin(), blocks.end()};
+    CHECK(std::ranges::any_of(
+      reused, [&](auto* block) { return allocated.contains(block); }));
+
+    for (auto* block : reused)
+    {
+      pool::deallocate(block);
+    }
+  }
+
+  SECTION("blocks can be freed after the thread's cache was destroyed")
+  {
+    struct deferred_deallocation
+    {
+      void* block = nullptr;
+
+      ~deferred_deallocation() { pool::deallocate(block); }
+    };
+
+    auto* freedBlock = static_cast<void*>(nullptr);
+    auto thread = std::thread{[&]() {
+      // thread local objects are destroyed in reverse order of their construction, so
+      // the cache is destroyed before this object frees the block
+      thread_local auto deallocation = deferred_deallocation{};
+      deallocation.block = pool::allocate();
+      freedBlock = deallocation.block;
+    }};
+    thread.join();
+
+    // the block was returned to the shared list last, so a new thread's cache starts with
+    // it
+    auto* reusedBlock = static_cast<void*>(nullptr);
+    thread = std::thread{[&]() {
+      reusedBlock = pool::allocate();
+      pool::deallocate(reusedBlock);
+    }};
+    thread.join();
+
+    CHECK(reusedBlock == freedBlock);
+  }
+}
+
+} // namespace tb
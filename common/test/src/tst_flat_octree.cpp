@@ -0,0 +1,422 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "flat_octree.h"
+#include "octree.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb
+{
+namespace
+{
+
+std::vector<int> sorted(std::vector<int> v)
+{
+  std::ranges::sort(v);
+  return v;
+}
+
+std::vector<std::pair<vm::bbox3d, int>> makeRandomItems(const size_t count)
+{
+  auto rng = std::mt19937{1};
+  auto position = std::uniform_real_distribution<double>{-2048.0, 2048.0};
+  auto size = std::uniform_real_distribution<double>{1.0, 256.0};
+
+  auto result = std::vector<std::pair<vm::bbox3d, int>>{};
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto min = vm::vec3d{position(rng), position(rng), position(rng)};
+    const auto max = min + vm::vec3d{size(rng), size(rng), size(rng)};
+    result.emplace_back(vm::bbox3d{min, max}, int(i));
+  }
+  return result;
+}
+
+std::vector<vm::ray3d> makeRandomRays(const size_t count)
+{
+  auto rng = std::mt19937{2};
+  auto position = std::uniform_real_distribution<double>{-3000.0, 3000.0};
+  auto direction = std::uniform_real_distribution<double>{-1.0, 1.0};
+
+  auto result = std::vector<vm::ray3d>{};
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto origin = vm::vec3d{position(rng), position(rng), position(rng)};
+    const auto dir = vm::vec3d{direction(rng), direction(rng), direction(rng)};
+    result.emplace_back(origin, vm::normalize(dir));
+  }
+
+  // axis aligned rays that run along the cell boundaries
+  result.emplace_back(vm::vec3d{0, 0, 0}, vm::vec3d{1, 0, 0});
+  result.emplace_back(vm::vec3d{256, -4096, 512}, vm::vec3d{0, 1, 0});
+  result.emplace_back(vm::vec3d{-100, 33, 4096}, vm::vec3d{0, 0, -1});
+  return result;
+}
+
+void checkSameResults(
+  const flat_octree<double, int>& tree, const octree<double, int>& expected)
+{
+  for (const auto& ray : makeRandomRays(100))
+  {
+    CHECK(sorted(tree.find_intersectors(ray)) == sorted(expected.find_intersectors(ray)));
+  }
+
+  for (const auto& [bounds, data] : makeRandomItems(100))
+  {
+    CHECK(
+      sorted(tree.find_intersectors(bounds))
+      == sorted(expected.find_intersectors(bounds)));
+    CHECK(
+      sorted(tree.find_containers(bounds.center()))
+      == sorted(expected.find_containers(bounds.center())));
+  }
+}
+
+} // namespace
+
+TEST_CASE("flat_octree.insert")
+{
+  auto tree = flat_octree<double, int>{32.0};
+  REQUIRE(tree.empty());
+
+  tree.insert(vm::bbox3d{{32, 32, 32}, {64, 64, 64}}, 1);
+  CHECK_FALSE(tree.empty());
+  CHECK(tree.contains(1));
+
+  SECTION("data is found")
+  {
+    CHECK(tree.find_containers({48, 48, 48}) == std::vector<int>{1});
+    CHECK(tree.find_containers({48, 48, 0}).empty());
+  }
+
+  SECTION("data crossing the origin is stored in the root node")
+  {
+    tree.insert(vm::bbox3d{{-8, -8, -8}, {8, 8, 8}}, 2);
+    CHECK(tree.contains(2));
+    CHECK(sorted(tree.find_containers({48, 48, 48})) == std::vector<int>{1, 2});
+    CHECK(tree.find_containers({-48, -48, -48}) == std::vector<int>{2});
+  }
+
+  SECTION("inserting outside of the root grows the tree")
+  {
+    tree.insert(vm::bbox3d{{1024, 1024, 1024}, {1056, 1056, 1056}}, 2);
+    CHECK(tree.contains(1));
+    CHECK(tree.contains(2));
+    CHECK(tree.find_containers({48, 48, 48}) == std::vector<int>{1});
+    CHECK(tree.find_containers({1040, 1040, 1040}) == std::vector<int>{2});
+  }
+
+  SECTION("inserting duplicate data throws")
+  {
+    CHECK_THROWS_AS(
+      tree.insert(vm::bbox3d{{0, 0, 0}, {2, 1, 1}}, 1), NodeTreeException);
+    CHECK(tree.contains(1));
+  }
+
+  SECTION("inserting invalid bounds throws")
+  {
+    CHECK_THROWS_AS(
+      tree.insert(vm::bbox3d{{0, 0, 0}, {vm::nan<double>(), 1, 1}}, 2),
+      NodeTreeException);
+    CHECK_FALSE(tree.contains(2));
+  }
+}
+
+TEST_CASE("flat_octree.remove")
+{
+  auto tree = flat_octree<double, int>{32.0};
+
+  CHECK_FALSE(tree.remove(1));
+
+  tree.insert(vm::bbox3d{{32, 32, 32}, {64, 64, 64}}, 1);
+  tree.insert(vm::bbox3d{{32, 32, 32}, {48, 48, 48}}, 2);
+  tree.insert(vm::bbox3d{{-64, 32, 32}, {-32, 64, 64}}, 3);
+
+  CHECK(tree.remove(2));
+  CHECK_FALSE(tree.contains(2));
+  CHECK_FALSE(tree.remove(2));
+  CHECK(tree.find_containers({40, 40, 40}) == std::vector<int>{1});
+
+  CHECK(tree.remove(1));
+  CHECK(tree.find_containers({40, 40, 40}).empty());
+  CHECK(tree.find_containers({-40, 40, 40}) == std::vector<int>{3});
+
+  SECTION("removed nodes can be reused")
+  {
+    tree.insert(vm::bbox3d{{32, 32, 32}, {48, 48, 48}}, 2);
+    CHECK(tree.find_containers({40, 40, 40}) == std::vector<int>{2});
+    CHECK(tree.find_containers({-40, 40, 40}) == std::vector<int>{3});
+  }
+
+  SECTION("removing the last item empties the tree")
+  {
+    CHECK(tree.remove(3));
+    CHECK(tree.empty());
+  }
+}
+
+TEST_CASE("flat_octree.update")
+{
+  auto tree = flat_octree<double, int>{32.0};
+
+  CHECK_THROWS_AS(
+    tree.update(vm::bbox3d{{32, 32, 32}, {64, 64, 64}}, 1), NodeTreeException);
+
+  tree.insert(vm::bbox3d{{32, 32, 32}, {64, 64, 64}}, 1);
+
+  tree.update(vm::bbox3d{{40, 40, 40}, {48, 48, 48}}, 1);
+  CHECK(tree.find_containers({40, 40, 40}) == std::vector<int>{1});
+
+  tree.update(vm::bbox3d{{-64, -64, -64}, {-32, -32, -32}}, 1);
+  CHECK(tree.find_containers({40, 40, 40}).empty());
+  CHECK(tree.find_containers({-40, -40, -40}) == std::vector<int>{1});
+}
+
+TEST_CASE("flat_octree.build")
+{
+  auto tree = flat_octree<double, int>{32.0};
+
+  SECTION("building from no data empties the tree")
+  {
+    tree.insert(vm::bbox3d{{32, 32, 32}, {64, 64, 64}}, 1);
+    tree.build({});
+    CHECK(tree.empty());
+    CHECK_FALSE(tree.contains(1));
+  }
+
+  SECTION("building replaces the contents")
+  {
+    tree.insert(vm::bbox3d{{32, 32, 32}, {64, 64, 64}}, 1);
+    tree.build({
+      {vm::bbox3d{{32, 32, 32}, {48, 48, 48}}, 2},
+      {vm::bbox3d{{-8, -8, -8}, {8, 8, 8}}, 3},
+    });
+
+    CHECK_FALSE(tree.contains(1));
+    CHECK(tree.contains(2));
+    CHECK(tree.contains(3));
+    CHECK(sorted(tree.find_containers({40, 40, 40})) == std::vector<int>{2, 3});
+  }
+
+  SECTION("building with duplicate data throws")
+  {
+    CHECK_THROWS_AS(
+      tree.build({
+        {vm::bbox3d{{32, 32, 32}, {48, 48, 48}}, 2},
+        {vm::bbox3d{{-8, -8, -8}, {8, 8, 8}}, 2},
+      }),
+      NodeTreeException);
+    CHECK(tree.empty());
+  }
+
+  SECTION("the tree can be modified after building")
+  {
+    const auto items = makeRandomItems(100);
+    tree.build(items);
+
+    for (const auto& [bounds, data] : items)
+    {
+      if (data % 2 == 0)
+      {
+        CHECK(tree.remove(data));
+      }
+    }
+    tree.insert(vm::bbox3d{{4096, 4096, 4096}, {4100, 4100, 4100}}, 1000);
+
+    for (const auto& [bounds, data] : items)
+    {
+      CHECK(tree.contains(data) == (data % 2 != 0));
+      if (data % 2 != 0)
+      {
+        CHECK(std::ranges::count(tree.find_containers(bounds.center()), data) == 1);
+      }
+    }
+    CHECK(std::ranges::count(tree.find_containers({4098, 4098, 4098}), 1000) == 1);
+  }
+}
+
+TEST_CASE("flat_octree.queries")
+{
+  const auto items = makeRandomItems(1000);
+
+  auto expected = octree<double, int>{64.0};
+  for (const auto& [bounds, data] : items)
+  {
+    expected.insert(bounds, data);
+  }
+
+  auto tree = flat_octree<double, int>{64.0};
+
+  SECTION("empty tree")
+  {
+    CHECK(tree.find_intersectors(vm::ray3d{{0, 0, 0}, {1, 0, 0}}).empty());
+    CHECK(tree.find_intersectors(vm::bbox3d{{0, 0, 0}, {1, 1, 1}}).empty());
+    CHECK(tree.find_containers({0, 0, 0}).empty());
+  }
+
+  SECTION("after inserting")
+  {
+    for (const auto& [bounds, data] : items)
+    {
+      tree.insert(bounds, data);
+    }
+    checkSameResults(tree, expected);
+  }
+
+  SECTION("after building")
+  {
+    tree.build(items);
+    checkSameResults(tree, expected);
+  }
+
+  SECTION("after updating and removing")
+  {
+    tree.build(items);
+    for (const auto& [bounds, data] : items)
+    {
+      if (data % 3 == 0)
+      {
+        const auto newBounds = bounds.translate({100, -50, 25});
+        tree.update(newBounds, data);
+        expected.update(newBounds, data);
+      }
+      else if (data % 3 == 1)
+      {
+        tree.remove(data);
+        expected.remove(data);
+      }
+    }
+    checkSameResults(tree, expected);
+  }
+
+  SECTION("after batched updates")
+  {
+    tree.build(items);
+
+    // moving few items updates them in place, moving many items rebuilds the tree
+    const auto divisor = GENERATE(100, 3, 1);
+
+    auto changedItems = std::vector<std::pair<vm::bbox3d, int>>{};
+    for (const auto& [bounds, data] : items)
+    {
+      if (data % divisor == 0)
+      {
+        const auto newBounds = bounds.translate({3000, -50, 25});
+        changedItems.emplace_back(newBounds, data);
+        expected.update(newBounds, data);
+      }
+    }
+
+    tree.update(changedItems);
+    checkSameResults(tree, expected);
+
+    CHECK_THROWS_AS(
+      tree.update({{vm::bbox3d{{0, 0, 0}, {1, 1, 1}}, 5000}}), NodeTreeException);
+  }
+
+  SECTION("after repeated updates")
+  {
+    for (const auto& [bounds, data] : items)
+    {
+      tree.insert(bounds, data);
+    }
+
+    for (int i = 1; i <= 5; ++i)
+    {
+      for (const auto& [bounds, data] : items)
+      {
+        const auto newBounds = bounds.translate({i * 300.0, -i * 200.0, i * 100.0});
+        tree.update(newBounds, data);
+        expected.update(newBounds, data);
+      }
+    }
+    checkSameResults(tree, expected);
+  }
+
+  SECTION("after removing most items and inserting new ones")
+  {
+    tree.build(items);
+    for (const auto& [bounds, data] : items)
+    {
+      if (data >= 10)
+      {
+        tree.remove(data);
+        expected.remove(data);
+      }
+    }
+
+    for (const auto& [bounds, data] : items)
+    {
+      const auto newBounds = bounds.translate({500, 500, 500});
+      tree.insert(newBounds, data + 1000);
+      expected.insert(newBounds, data + 1000);
+    }
+    checkSameResults(tree, expected);
+  }
+
+  SECTION("visitors receive the same results")
+  {
+    tree.build(items);
+
+    const auto ray = vm::ray3d{{-3000, 0, 0}, {1, 0, 0}};
+    auto visited = std::vector<int>{};
+    tree.visit_intersectors(ray, [&](const int data) { visited.push_back(data); });
+    CHECK(sorted(visited) == sorted(tree.find_intersectors(ray)));
+
+    visited.clear();
+    tree.visit_containers(
+      vm::vec3d{0, 0, 0}, [&](const int data) { visited.push_back(data); });
+    CHECK(sorted(visited) == sorted(tree.find_containers({0, 0, 0})));
+  }
+}
+
+TEST_CASE("flat_octree.visit_non_containees")
+{
+  const auto items = makeRandomItems(1000);
+
+  auto tree = flat_octree<double, int>{64.0};
+  tree.build(items);
+
+  const auto bbox = vm::bbox3d{{-1024, -1024, -1024}, {1024, 1024, 1024}};
+
+  auto visited = std::vector<int>{};
+  tree.visit_non_containees(bbox, [&](const int data) { visited.push_back(data); });
+  visited = sorted(std::move(visited));
+
+  auto notContained = std::vector<int>{};
+  for (const auto& [bounds, data] : items)
+  {
+    if (!bbox.contains(bounds))
+    {
+      notContained.push_back(data);
+    }
+  }
+
+  // every item that is not contained is visited, but some contained items are skipped
+  CHECK(std::ranges::includes(visited, notContained));
+  CHECK(visited.size() < items.size());
+}
+
+} // namespace tb
@@ -24,8 +24,12 @@
 #include "io/TestEnvironment.h"
 #include "mdl/BrushNode.h" // IWYU pragma: keep
 #include "mdl/EntityNode.h"
+#include "mdl/EntityProperties.h"
 #include "mdl/LayerNode.h" // IWYU pragma: keep
+#include "mdl/Material.h"
+#include "mdl/MaterialManager.h"
 #include "ui/Autosaver.h"
+#include "ui/MapDocument.h"
 #include "ui/MapDocumentTest.h"
 
 #include "kdl/vector_utils.h"
@@ -34,6 +38,7 @@
 
 #include <chrono>
 #include <filesystem>
+#include <string>
 #include <thread>
 
 #include "Catch2.h"
@@ -96,6 +101,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverNoSaveUntilSaveInter
   document->addNodes({{document->currentLayer(), {createBrushNode("some_material")}}});
 
   autosaver.triggerAutosave(logger);
+  autosaver.waitForAutosave(logger);
 
   CHECK_FALSE(env.fileExists("autosave/test.1.map"));
   CHECK_FALSE(env.directoryExists("autosave"));
@@ -113,6 +119,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverNoSaveOfUnchangedMap
 
   auto autosaver = Autosaver{document, 0s};
   autosaver.triggerAutosave(logger);
+  autosaver.waitForAutosave(logger);
 
   CHECK_FALSE(env.fileExists("autosave/test.1.map"));
   CHECK_FALSE(env.directoryExists("autosave"));
@@ -136,6 +143,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesAfterSaveInterv
   std::this_thread::sleep_for(100ms);
 
   autosaver.triggerAutosave(logger);
+  autosaver.waitForAutosave(logger);
 
   CHECK(env.fileExists("autosave/test.1.map"));
   CHECK(env.directoryExists("autosave"));
@@ -159,6 +167,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesAgainAfterSaveI
   std::this_thread::sleep_for(100ms);
 
   autosaver.triggerAutosave(logger);
+  autosaver.waitForAutosave(logger);
 
   CHECK(env.fileExists("autosave/test.1.map"));
   CHECK(env.directoryExists("autosave"));
@@ -168,15 +177,91 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesAgainAfterSaveI
   std::this_thread::sleep_for(100ms);
 
   autosaver.triggerAutosave(logger);
+  autosaver.waitForAutosave(logger);
   CHECK_FALSE(env.fileExists("autosave/test.2.map"));
 
   // modify the map
   document->addNodes({{document->currentLayer(), {createBrushNode("some_material")}}});
 
   autosaver.triggerAutosave(logger);
+  autosaver.waitForAutosave(logger);
   CHECK(env.fileExists("autosave/test.2.map"));
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverWritesSnapshot")
+{
+  using namespace std::chrono_literals;
+
+  auto env = io::TestEnvironment{};
+  auto logger = NullLogger{};
+
+  document->saveDocumentAs(env.dir() / "test.map");
+  assert(env.fileExists("test.map"));
+
+  auto autosaver = Autosaver{document, 0s};
+
+  // modify the map
+  document->addNodes({{document->currentLayer(), {new mdl::EntityNode{{}}}}});
+
+  autosaver.triggerAutosave(logger);
+
+  // modify the map again while the backup may still be written
+  document->addNodes({{document->currentLayer(), {new mdl::EntityNode{{}}}}});
+
+  autosaver.waitForAutosave(logger);
+  CHECK_FALSE(autosaver.autosaveInProgress());
+
+  CHECK(
+    env.directoryContents("autosave")
+    == std::vector<std::filesystem::path>{"autosave/test.1.map"});
+  CHECK(env.loadFile("autosave/test.1.map") == R"(// Game: Test
+// Format: Standard
+// entity 0
+{
+"classname" "worldspawn"
+}
+// entity 1
+{
+}
+)");
+}
+
+TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverReloadAssetsWhilePending")
+{
+  using namespace std::chrono_literals;
+
+  auto env = io::TestEnvironment{};
+  auto logger = NullLogger{};
+
+  document->setProperty(mdl::EntityPropertyKeys::Wad, "fixture/test/io/Wad/cr8_czg.wad");
+  document->saveDocumentAs(env.dir() / "test.map");
+  assert(env.fileExists("test.map"));
+
+  auto autosaver = Autosaver{document, 0s};
+
+  // modify the map
+  document->addNodes({{document->currentLayer(), {createBrushNode("coffin1")}}});
+
+  const auto* material = document->materialManager().material("coffin1");
+  REQUIRE(material != nullptr);
+  REQUIRE(material->usageCount() == 6u);
+
+  autosaver.triggerAutosave(logger);
+
+  // the snapshot doesn't refer to the material
+  CHECK(material->usageCount() == 6u);
+
+  // unload the materials and entity definitions while the backup may still be written
+  document->reloadMaterialCollections();
+  document->reloadEntityDefinitions();
+
+  autosaver.waitForAutosave(logger);
+  CHECK_FALSE(autosaver.autosaveInProgress());
+
+  CHECK(env.fileExists("autosave/test.1.map"));
+  CHECK(env.loadFile("autosave/test.1.map").find("coffin1") != std::string::npos);
+}
+
 TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverCleanup")
 {
   using namespace std::chrono_literals;
@@ -219,6 +304,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverCleanup")
 
     std::this_thread::sleep_for(100ms);
     autosaver.triggerAutosave(logger);
+    autosaver.waitForAutosave(logger);
 
     const auto allPaths = kdl::vec_push_back(initialPaths, "autosave/test.3.map");
 
@@ -245,6 +331,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverCleanup")
 
     std::this_thread::sleep_for(100ms);
     autosaver.triggerAutosave(logger);
+    autosaver.waitForAutosave(logger);
 
     CHECK(env.directoryContents("autosave") == allPaths);
     CHECK(
@@ -310,6 +397,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverCleanup")
 
     std::this_thread::sleep_for(100ms);
     autosaver.triggerAutosave(logger);
+    autosaver.waitForAutosave(logger);
 
     const auto allPaths = std::vector<std::filesystem::path>{
       "autosave/test.1.map",
@@ -359,6 +447,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesWhenCrashFilesP
   document->addNodes({{document->currentLayer(), {createBrushNode("some_material")}}});
 
   autosaver.triggerAutosave(logger);
+  autosaver.waitForAutosave(logger);
 
   CHECK(env.fileExists("autosave/test.2.map"));
 }
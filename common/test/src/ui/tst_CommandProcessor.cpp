@@ -845,4 +845,120 @@ TEST_CASE("CommandProcessorTest.collateTransactions")
   commandProcessor.undo();
 }
 
+TEST_CASE("CommandProcessorTest.stackSizeInBytes")
+{
+  auto taskManager = createTestTaskManager();
+  auto facade = MapDocumentCommandFacade{*taskManager};
+  auto commandProcessor = CommandProcessor{facade};
+
+  REQUIRE(commandProcessor.undoStackSizeInBytes() == 0u);
+  REQUIRE(commandProcessor.redoStackSizeInBytes() == 0u);
+
+  auto command = std::make_unique<NullCommand>("command");
+  const auto commandSize = command->sizeInBytes();
+  REQUIRE(commandSize > 0u);
+
+  commandProcessor.executeAndStore(std::move(command));
+  CHECK(commandProcessor.undoStackSizeInBytes() == commandSize);
+  CHECK(commandProcessor.redoStackSizeInBytes() == 0u);
+
+  commandProcessor.undo();
+  CHECK(commandProcessor.undoStackSizeInBytes() == 0u);
+  CHECK(commandProcessor.redoStackSizeInBytes() == commandSize);
+
+  commandProcessor.redo();
+  CHECK(commandProcessor.undoStackSizeInBytes() == commandSize);
+  CHECK(commandProcessor.redoStackSizeInBytes() == 0u);
+
+  commandProcessor.clear();
+  CHECK(commandProcessor.undoStackSizeInBytes() == 0u);
+}
+
+TEST_CASE("CommandProcessorTest.memoryBudget")
+{
+  auto taskManager = createTestTaskManager();
+  auto facade = MapDocumentCommandFacade{*taskManager};
+
+  const auto commandSize = NullCommand{"command"}.sizeInBytes();
+  auto commandProcessor =
+    CommandProcessor{facade, std::chrono::milliseconds{1000}, 2u * commandSize};
+
+  SECTION("Evicts the oldest commands when the budget is exceeded")
+  {
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command 1"));
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command 2"));
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command 3"));
+
+    CHECK(commandProcessor.undoStackSizeInBytes() == 2u * commandSize);
+    CHECK(commandProcessor.undoCommandName() == "command 3");
+
+    commandProcessor.undo();
+    commandProcessor.undo();
+    CHECK_FALSE(commandProcessor.canUndo());
+    CHECK(commandProcessor.redoStackSizeInBytes() == 2u * commandSize);
+  }
+
+  SECTION("Always keeps the most recent command")
+  {
+    commandProcessor.setMemoryBudget(0u);
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command 1"));
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command 2"));
+
+    CHECK(commandProcessor.undoStackSizeInBytes() == commandSize);
+    CHECK(commandProcessor.undoCommandName() == "command 2");
+  }
+
+  SECTION("Lowering the budget trims the undo stack")
+  {
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command 1"));
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command 2"));
+    REQUIRE(commandProcessor.undoStackSizeInBytes() == 2u * commandSize);
+
+    commandProcessor.setMemoryBudget(commandSize);
+    CHECK(commandProcessor.undoStackSizeInBytes() == commandSize);
+    CHECK(commandProcessor.undoCommandName() == "command 2");
+  }
+
+  SECTION("Lowering the budget trims the redo stack after the undo stack")
+  {
+    commandProcessor.setMemoryBudget(std::nullopt);
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command 1"));
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command 2"));
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command 3"));
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command 4"));
+    commandProcessor.undo();
+    commandProcessor.undo();
+    REQUIRE(commandProcessor.undoStackSizeInBytes() == 2u * commandSize);
+    REQUIRE(commandProcessor.redoStackSizeInBytes() == 2u * commandSize);
+
+    // undoing and redoing moves commands between the stacks without trimming them
+    commandProcessor.setMemoryBudget(4u * commandSize);
+    commandProcessor.undo();
+    commandProcessor.redo();
+    CHECK(commandProcessor.undoStackSizeInBytes() == 2u * commandSize);
+    CHECK(commandProcessor.redoStackSizeInBytes() == 2u * commandSize);
+
+    commandProcessor.setMemoryBudget(2u * commandSize);
+    CHECK(commandProcessor.undoStackSizeInBytes() == commandSize);
+    CHECK(commandProcessor.undoCommandName() == "command 2");
+    CHECK(commandProcessor.redoStackSizeInBytes() == commandSize);
+    CHECK(commandProcessor.redoCommandName() == "command 3");
+
+    commandProcessor.redo();
+    CHECK_FALSE(commandProcessor.canRedo());
+  }
+
+  SECTION("Always keeps the next command to redo")
+  {
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command 1"));
+    commandProcessor.executeAndStore(std::make_unique<NullCommand>("command 2"));
+    commandProcessor.undo();
+
+    commandProcessor.setMemoryBudget(0u);
+    CHECK(commandProcessor.undoStackSizeInBytes() == commandSize);
+    CHECK(commandProcessor.redoStackSizeInBytes() == commandSize);
+    CHECK(commandProcessor.redoCommandName() == "command 2");
+  }
+}
+
 } // namespace tb::ui
@@ -20,6 +20,7 @@
 #include "TestUtils.h"
 #include "mdl/BezierPatch.h"
 #include "mdl/Brush.h"
+#include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
 #include "mdl/Entity.h"
 #include "mdl/EntityDefinition.h"
@@ -30,6 +31,7 @@
 #include "mdl/MaterialManager.h"
 #include "mdl/NodeContents.h"
 #include "mdl/PatchNode.h"
+#include "mdl/UVCoordSystem.h"
 #include "ui/MapDocument.h"
 #include "ui/MapDocumentTest.h"
 #include "ui/SwapNodeContentsCommand.h"
@@ -63,6 +65,41 @@ TEST_CASE_METHOD(MapDocumentTest, "SwapNodeContentsTest.swapBrushes")
   CHECK(brushNode->brush() == originalBrush);
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "SwapNodeContentsTest.collateFaceChanges")
+{
+  auto* brushNode = createBrushNode();
+  document->addNodes({{document->parentForNodes(), {brushNode}}});
+
+  const auto originalBrush = brushNode->brush();
+
+  auto firstBrush = originalBrush;
+  firstBrush.face(0).rotateUV(45.0f);
+
+  auto secondBrush = firstBrush;
+  auto attributes = secondBrush.face(1).attributes();
+  attributes.setMaterialName("other_material");
+  secondBrush.face(1).setAttributes(attributes);
+
+  auto nodesToSwap = std::vector<std::pair<mdl::Node*, mdl::NodeContents>>{};
+  nodesToSwap.emplace_back(brushNode, firstBrush);
+  document->swapNodeContents("Swap Nodes", std::move(nodesToSwap), {});
+  REQUIRE(brushNode->brush() == firstBrush);
+
+  // collated with the previous command
+  nodesToSwap = std::vector<std::pair<mdl::Node*, mdl::NodeContents>>{};
+  nodesToSwap.emplace_back(brushNode, secondBrush);
+  document->swapNodeContents("Swap Nodes", std::move(nodesToSwap), {});
+  REQUIRE(brushNode->brush() == secondBrush);
+
+  document->undoCommand();
+  CHECK(brushNode->brush() == originalBrush);
+  CHECK(
+    brushNode->brush().face(0).uvCoordSystem() == originalBrush.face(0).uvCoordSystem());
+
+  document->redoCommand();
+  CHECK(brushNode->brush() == secondBrush);
+}
+
 TEST_CASE_METHOD(MapDocumentTest, "SwapNodeContentsTest.swapPatches")
 {
   auto* patchNode = createPatchNode();
@@ -182,6 +219,64 @@ TEST_CASE_METHOD(MapDocumentTest, "SwapNodesContentCommandTest.updateLinkedGroup
     == brushNode->physicalBounds().transform(linkedGroupNode->group().transformation()));
 }
 
+TEST_CASE_METHOD(
+  MapDocumentTest, "SwapNodesContentCommandTest.updateNestedLinkedGroups")
+{
+  auto* outerGroupNode = new mdl::GroupNode{mdl::Group{"outer"}};
+  auto* innerGroupNode = new mdl::GroupNode{mdl::Group{"inner"}};
+  auto* brushNode = createBrushNode();
+  auto* outerBrushNode = createBrushNode();
+  innerGroupNode->addChild(brushNode);
+  outerGroupNode->addChildren({innerGroupNode, outerBrushNode});
+  document->addNodes({{document->parentForNodes(), {outerGroupNode}}});
+
+  document->selectNodes({outerGroupNode});
+  auto* linkedOuterGroupNode = document->createLinkedDuplicate();
+  document->deselectAll();
+
+  REQUIRE(linkedOuterGroupNode->childCount() == 2u);
+  auto* linkedInnerGroupNode =
+    dynamic_cast<mdl::GroupNode*>(linkedOuterGroupNode->children().front());
+  auto* linkedOuterBrushNode =
+    dynamic_cast<mdl::BrushNode*>(linkedOuterGroupNode->children().back());
+  REQUIRE(linkedInnerGroupNode != nullptr);
+  REQUIRE(linkedOuterBrushNode != nullptr);
+  REQUIRE(linkedInnerGroupNode->childCount() == 1u);
+  auto* linkedBrushNode =
+    dynamic_cast<mdl::BrushNode*>(linkedInnerGroupNode->children().front());
+  REQUIRE(linkedBrushNode != nullptr);
+
+  // the linked outer brush is out of sync, but it isn't changed, so it must not be
+  // updated when the nested brush changes
+  transformNode(
+    *linkedOuterBrushNode,
+    vm::translation_matrix(vm::vec3d(0.0, 0.0, 64.0)),
+    document->worldBounds());
+  const auto linkedOuterBrushBounds = linkedOuterBrushNode->physicalBounds();
+
+  auto modifiedBrush = brushNode->brush();
+  REQUIRE(modifiedBrush
+            .transform(
+              document->worldBounds(), vm::translation_matrix(vm::vec3d(0, 16, 0)), false)
+            .is_success());
+
+  auto nodesToSwap = std::vector<std::pair<mdl::Node*, mdl::NodeContents>>{};
+  nodesToSwap.emplace_back(brushNode, modifiedBrush);
+
+  // both groups are changed, so the outer group's changes must only include the brush
+  REQUIRE(document->swapNodeContents(
+    "Swap Nodes", std::move(nodesToSwap), {outerGroupNode, innerGroupNode}));
+
+  CHECK_THAT(
+    linkedOuterGroupNode->children(),
+    Catch::Equals(std::vector<mdl::Node*>{linkedInnerGroupNode, linkedOuterBrushNode}));
+  CHECK_THAT(
+    linkedInnerGroupNode->children(),
+    Catch::Equals(std::vector<mdl::Node*>{linkedBrushNode}));
+  CHECK(linkedBrushNode->brush() == modifiedBrush);
+  CHECK(linkedOuterBrushNode->physicalBounds() == linkedOuterBrushBounds);
+}
+
 TEST_CASE_METHOD(MapDocumentTest, "SwapNodesContentCommandTest.updateLinkedGroupsFails")
 {
   auto* groupNode = new mdl::GroupNode{mdl::Group{"group"}};
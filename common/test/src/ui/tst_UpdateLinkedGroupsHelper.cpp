@@ -88,6 +88,10 @@ TEST_CASE_METHOD(UpdateLinkedGroupsHelperTest, "ownership")
 
   document->addNodes({{document->parentForNodes(), {groupNode, linkedNode}}});
 
+  // change the structure of the linked group so that the children of groupNode are
+  // replaced when propagating the changes
+  linkedNode->addChild(new mdl::EntityNode{mdl::Entity{}});
+
   SECTION("Helper takes ownership of replaced child nodes")
   {
     {
@@ -186,15 +190,14 @@ TEST_CASE_METHOD(UpdateLinkedGroupsHelperTest, "applyLinkedGroupUpdates")
     +-groupNode
       +-brushNode (translated 0 16 0)
     +-linkedGroupNode (translated 32 0 0)
-      +-newLinkedBrushNode (translated 32 16 0)
+      +-linkedBrushNode (translated 32 16 0)
   */
 
-  // changes were propagated
-  REQUIRE(linkedGroupNode->childCount() == 1u);
-  CHECK(linkedBrushNode->parent() == nullptr);
-  auto* newLinkedBrushNode = linkedGroupNode->children().front();
+  // changes were propagated by swapping the contents of the changed node
+  CHECK_THAT(
+    linkedGroupNode->children(), Catch::Equals(std::vector<mdl::Node*>{linkedBrushNode}));
   CHECK(
-    newLinkedBrushNode->physicalBounds()
+    linkedBrushNode->physicalBounds()
     == originalBrushBounds.translate(vm::vec3d(32.0, 16.0, 0.0)));
 
   // undo change propagation
@@ -513,6 +516,44 @@ TEST_CASE_METHOD(
       helper
         .applyLinkedGroupUpdates(*static_cast<MapDocumentCommandFacade*>(document.get()))
         .is_success());
+
+    // undo; both updates changed the contents of the nested linked brush node
+    helper.undoLinkedGroupUpdates(
+      *static_cast<MapDocumentCommandFacade*>(document.get()));
+
+    /*
+    world
+    +-defaultLayer
+      +-outerGroupNode
+        +-innerGroupNode (translated 0 16 0)
+          +-brushNode (translated 0 16 8)
+      +-linkedInnerGroupNode
+        +-linkedBrushNode
+      +-linkedOuterGroupNode (translated 32 0 0)
+        +-nestedLinkedInnerGroupNode (translated 32 0 0)
+          +-nestedLinkedBrushNode (translated 32 0 0)
+    */
+
+    REQUIRE(linkedInnerGroupNode->childCount() == 1u);
+    CHECK(
+      linkedInnerGroupNode->children().front()->physicalBounds() == originalBrushBounds);
+
+    auto* restoredNestedLinkedInnerGroupNode =
+      findGroupByName(*document->world(), "nestedLinkedInnerGroupNode");
+    REQUIRE(restoredNestedLinkedInnerGroupNode != nullptr);
+    CHECK(
+      restoredNestedLinkedInnerGroupNode->group().transformation()
+      == vm::translation_matrix(vm::vec3d(32.0, 0.0, 0.0)));
+    REQUIRE(restoredNestedLinkedInnerGroupNode->childCount() == 1u);
+    CHECK(
+      restoredNestedLinkedInnerGroupNode->children().front()->physicalBounds()
+      == originalBrushBounds.translate(vm::vec3d(32.0, 0.0, 0.0)));
+
+    // redo
+    REQUIRE(
+      helper
+        .applyLinkedGroupUpdates(*static_cast<MapDocumentCommandFacade*>(document.get()))
+        .is_success());
   }
 
   /*
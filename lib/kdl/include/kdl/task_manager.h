@@ -22,55 +22,302 @@
 
 #include "kdl/range_to_vector.h"
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
-#include <functional>
+#include <cstddef>
+#include <deque>
+#include <exception>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <new>
+#include <optional>
 #include <ranges>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace kdl
 {
+namespace detail
+{
+
+/**
+ * A move only, type erased nullary callable.
+ *
+ * Callables that are small enough and nothrow move constructible are stored in an inline
+ * buffer, so that wrapping them does not require a heap allocation. Larger callables are
+ * stored on the heap.
+ */
+class unique_task
+{
+private:
+  static constexpr std::size_t buffer_size = 8 * sizeof(void*);
+
+  struct vtable
+  {
+    void (*invoke)(void*);
+    void (*move)(void* dst, void* src);
+    void (*destroy)(void*);
+  };
+
+  template <typename F>
+  static constexpr bool is_stored_inline = sizeof(F) <= buffer_size
+                                           && alignof(F) <= alignof(std::max_align_t)
+                                           && std::is_nothrow_move_constructible_v<F>;
+
+  template <typename F>
+  static constexpr auto inline_vtable = vtable{
+    [](void* f) { (*static_cast<F*>(f))(); },
+    [](void* dst, void* src) {
+      new (dst) F{std::move(*static_cast<F*>(src))};
+      static_cast<F*>(src)->~F();
+    },
+    [](void* f) { static_cast<F*>(f)->~F(); },
+  };
+
+  template <typename F>
+  static constexpr auto heap_vtable = vtable{
+    [](void* f) { (**static_cast<F**>(f))(); },
+    [](void* dst, void* src) {
+      new (dst) F*{*static_cast<F**>(src)};
+      *static_cast<F**>(src) = nullptr;
+    },
+    [](void* f) { delete *static_cast<F**>(f); },
+  };
+
+  alignas(std::max_align_t) std::byte m_buffer[buffer_size];
+  const vtable* m_vtable = nullptr;
+
+public:
+  unique_task() = default;
+
+  template <typename F>
+    requires(!std::is_same_v<std::remove_cvref_t<F>, unique_task>)
+  unique_task(F&& f) // NOLINT
+  {
+    using function_type = std::remove_cvref_t<F>;
+    if constexpr (is_stored_inline<function_type>)
+    {
+      new (m_buffer) function_type{std::forward<F>(f)};
+      m_vtable = &inline_vtable<function_type>;
+    }
+    else
+    {
+      new (m_buffer) function_type*{new function_type{std::forward<F>(f)}};
+      m_vtable = &heap_vtable<function_type>;
+    }
+  }
+
+  unique_task(const unique_task&) = delete;
+  unique_task& operator=(const unique_task&) = delete;
+
+  unique_task(unique_task&& other) noexcept
+    : m_vtable{std::exchange(other.m_vtable, nullptr)}
+  {
+    if (m_vtable)
+    {
+      m_vtable->move(m_buffer, other.m_buffer);
+    }
+  }
+
+  unique_task& operator=(unique_task&& other) noexcept
+  {
+    if (this != &other)
+    {
+      reset();
+      if (other.m_vtable)
+      {
+        other.m_vtable->move(m_buffer, other.m_buffer);
+        m_vtable = std::exchange(other.m_vtable, nullptr);
+      }
+    }
+    return *this;
+  }
+
+  ~unique_task() { reset(); }
+
+  explicit operator bool() const { return m_vtable != nullptr; }
 
+  void operator()() { m_vtable->invoke(m_buffer); }
+
+private:
+  void reset()
+  {
+    if (m_vtable)
+    {
+      m_vtable->destroy(m_buffer);
+      m_vtable = nullptr;
+    }
+  }
+};
+
+} // namespace detail
+
+/**
+ * Runs tasks on a fixed number of worker threads.
+ *
+ * Every worker owns a task queue. Tasks submitted from a worker thread are pushed onto
+ * that worker's queue, and tasks submitted from other threads are distributed among the
+ * worker queues round robin. A worker takes tasks from the back of its own queue and
+ * steals from the front of the other queues when its own queue is empty, so there is no
+ * single lock that all submissions and workers contend for.
+ *
+ * Tasks may submit further tasks and wait for them. A worker that waits for a task's
+ * result runs pending tasks in the meantime instead of blocking, so nested submissions
+ * cannot deadlock even if all workers are waiting.
+ *
+ * If the task manager has no workers, tasks are run immediately on the calling thread.
+ */
 class task_manager
 {
 private:
-  using pending_task = std::function<void()>;
+  struct alignas(64) worker_queue
+  {
+    std::mutex mutex;
+    std::deque<detail::unique_task> tasks;
+  };
+
+  struct worker_context
+  {
+    const task_manager* manager = nullptr;
+    std::size_t index = 0;
+  };
 
+  std::vector<std::unique_ptr<worker_queue>> m_queues;
   std::vector<std::thread> m_workers;
 
-  std::mutex m_pending_tasks_mutex;
-  std::condition_variable m_pending_tasks_cv;
-  std::queue<pending_task> m_pending_tasks;
-  bool m_running = true;
+  std::atomic<std::size_t> m_next_queue = 0;
+  std::atomic<std::size_t> m_pending_count = 0;
+
+  std::mutex m_sleep_mutex;
+  std::condition_variable m_sleep_cv;
+  std::atomic<std::size_t> m_sleeping_count = 0;
+  std::atomic<bool> m_running = true;
+
+  static worker_context& current_worker()
+  {
+    thread_local auto context = worker_context{};
+    return context;
+  }
+
+  std::optional<std::size_t> current_worker_index() const
+  {
+    const auto& context = current_worker();
+    return context.manager == this ? std::optional{context.index} : std::nullopt;
+  }
+
+  void push_task(detail::unique_task task)
+  {
+    // increment the pending count first so that it never underflows if another worker
+    // takes the task before we get to increment it
+    m_pending_count.fetch_add(1);
+
+    const auto index = current_worker_index().value_or(
+      m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size());
+
+    {
+      auto& queue = *m_queues[index];
+      auto lock = std::lock_guard{queue.mutex};
+      queue.tasks.push_back(std::move(task));
+    }
+
+    wake_worker();
+  }
+
+  std::optional<detail::unique_task> pop_task()
+  {
+    const auto own_index = current_worker_index();
+    if (own_index)
+    {
+      auto& queue = *m_queues[*own_index];
+      auto lock = std::lock_guard{queue.mutex};
+      if (!queue.tasks.empty())
+      {
+        auto task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        m_pending_count.fetch_sub(1);
+        return task;
+      }
+    }
+
+    const auto first = own_index ? *own_index + 1 : 0;
+    for (std::size_t i = 0; i < m_queues.size(); ++i)
+    {
+      const auto index = (first + i) % m_queues.size();
+      if (index == own_index)
+      {
+        continue;
+      }
+
+      auto& queue = *m_queues[index];
+      auto lock = std::lock_guard{queue.mutex};
+      if (!queue.tasks.empty())
+      {
+        auto task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        m_pending_count.fetch_sub(1);
+        return task;
+      }
+    }
 
+    return std::nullopt;
+  }
 
-  auto make_worker_func()
+  void wake_worker()
   {
-    return [&] {
-      while (true)
+    // A worker increments m_sleeping_count before it checks m_pending_count, and we
+    // increment m_pending_count before we check m_sleeping_count. Thus, either we see the
+    // sleeping worker here, or it sees the pending task and does not go to sleep.
+    if (m_sleeping_count.load() > 0)
+    {
       {
-        auto lock = std::unique_lock{m_pending_tasks_mutex};
-        m_pending_tasks_cv.wait(
-          lock, [&] { return !m_running || !m_pending_tasks.empty(); });
+        auto lock = std::lock_guard{m_sleep_mutex};
+      }
+      m_sleep_cv.notify_one();
+    }
+  }
 
-        if (!m_running)
-        {
-          break;
-        }
+  void run_worker(const std::size_t index)
+  {
+    current_worker() = worker_context{this, index};
 
-        if (!m_pending_tasks.empty())
-        {
-          auto task = std::move(m_pending_tasks.front());
-          m_pending_tasks.pop();
-          lock.unlock();
+    while (m_running)
+    {
+      if (auto task = pop_task())
+      {
+        (*task)();
+        continue;
+      }
 
-          task();
-        }
+      auto lock = std::unique_lock{m_sleep_mutex};
+      m_sleeping_count.fetch_add(1);
+      m_sleep_cv.wait(lock, [&] { return !m_running || m_pending_count.load() > 0; });
+      m_sleeping_count.fetch_sub(1);
+    }
+  }
+
+  template <typename task_result, typename task_type>
+  static void fulfill(std::promise<task_result>& promise, task_type& task)
+  {
+    try
+    {
+      if constexpr (std::is_void_v<task_result>)
+      {
+        task();
+        promise.set_value();
       }
-    };
+      else
+      {
+        promise.set_value(task());
+      }
+    }
+    catch (...)
+    {
+      promise.set_exception(std::current_exception());
+    }
   }
 
 public:
@@ -79,48 +326,80 @@ public:
   {
     for (size_t i = 0; i < max_concurrent_tasks; ++i)
     {
-      m_workers.emplace_back(make_worker_func());
+      m_queues.push_back(std::make_unique<worker_queue>());
+    }
+    for (size_t i = 0; i < max_concurrent_tasks; ++i)
+    {
+      m_workers.emplace_back([&, i] { run_worker(i); });
     }
   }
 
   ~task_manager()
   {
     {
-      auto lock = std::lock_guard{m_pending_tasks_mutex};
+      auto lock = std::lock_guard{m_sleep_mutex};
       m_running = false;
     }
 
-    m_pending_tasks_cv.notify_all();
+    m_sleep_cv.notify_all();
     for (auto& worker : m_workers)
     {
       worker.join();
     }
   }
 
-  template <typename task_result>
-  auto run_task(std::function<task_result()> task)
+  template <typename task_type>
+  auto run_task(task_type task)
   {
+    using task_result = std::invoke_result_t<task_type&>;
+
+    // The promise's shared state is still allocated once per task. The promise is moved
+    // into the task wrapper, so no additional shared_ptr to it is needed.
+    auto promise = std::promise<task_result>{};
+    auto future = promise.get_future();
+
     if (m_workers.empty())
     {
-      auto promise = std::promise<task_result>{};
-      promise.set_value(task());
-      return promise.get_future();
+      fulfill(promise, task);
     }
-
-    auto promise = std::make_shared<std::promise<task_result>>();
-    auto future = promise->get_future();
-
+    else
     {
-      auto lock = std::lock_guard{m_pending_tasks_mutex};
-      m_pending_tasks.push([&, task_ = std::move(task), promise_ = std::move(promise)]() {
-        promise_->set_value(task_());
+      push_task([task_ = std::move(task), promise_ = std::move(promise)]() mutable {
+        fulfill(promise_, task_);
       });
     }
-    m_pending_tasks_cv.notify_one();
 
     return future;
   }
 
+  /**
+   * Waits for the given future and returns its result.
+   *
+   * If called from a worker thread, pending tasks are run while waiting, so it is safe to
+   * wait for a task submitted from within another task.
+   */
+  template <typename task_result>
+  auto wait_for(std::future<task_result>& future)
+  {
+    if (current_worker_index())
+    {
+      // run other tasks while we wait so that nested tasks cannot deadlock
+      while (future.wait_for(std::chrono::seconds{0}) != std::future_status::ready)
+      {
+        if (auto task = pop_task())
+        {
+          (*task)();
+        }
+        else
+        {
+          future.wait_for(std::chrono::microseconds{100});
+        }
+      }
+    }
+
+    return future.get();
+  }
+
   template <std::ranges::range range>
   auto run_tasks(range tasks)
   {
@@ -134,7 +413,7 @@ public:
   auto run_tasks_and_wait(range&& tasks)
   {
     auto futures = run_tasks(std::forward<range>(tasks));
-    return futures | std::views::transform([](auto& future) { return future.get(); })
+    return futures | std::views::transform([&](auto& future) { return wait_for(future); })
            | to_vector;
   }
 };
@@ -21,7 +21,9 @@
 #include "kdl/range_to_vector.h"
 #include "kdl/task_manager.h"
 
+#include <atomic>
 #include <memory>
+#include <stdexcept>
 #include <tuple>
 
 #include "catch2.h"
@@ -123,6 +125,82 @@ TEST_CASE("task_manager")
   }
 }
 
+TEST_CASE("task_manager with move only tasks")
+{
+  const auto max_concurrent_tasks = GENERATE(0u, 1u, 4u);
+  CAPTURE(max_concurrent_tasks);
+
+  auto tm = task_manager{max_concurrent_tasks};
+
+  auto value = std::make_unique<int>(7);
+  auto future = tm.run_task([value_ = std::move(value)]() { return *value_; });
+  CHECK(future.get() == 7);
+}
+
+TEST_CASE("task_manager with void tasks")
+{
+  const auto max_concurrent_tasks = GENERATE(0u, 1u, 4u);
+  CAPTURE(max_concurrent_tasks);
+
+  auto tm = task_manager{max_concurrent_tasks};
+
+  auto task_ran = false;
+  auto future = tm.run_task([&]() { task_ran = true; });
+  future.get();
+  CHECK(task_ran);
+}
+
+TEST_CASE("task_manager propagates exceptions")
+{
+  const auto max_concurrent_tasks = GENERATE(0u, 1u, 4u);
+  CAPTURE(max_concurrent_tasks);
+
+  auto tm = task_manager{max_concurrent_tasks};
+
+  auto future = tm.run_task([]() -> int { throw std::runtime_error{"error"}; });
+  CHECK_THROWS_AS(future.get(), std::runtime_error);
+
+  // the worker survives the exception
+  CHECK(tm.run_task([]() { return 1; }).get() == 1);
+}
+
+TEST_CASE("task_manager with nested tasks")
+{
+  const auto max_concurrent_tasks = GENERATE(1u, 2u, 4u);
+  CAPTURE(max_concurrent_tasks);
+
+  auto tm = task_manager{max_concurrent_tasks};
+
+  // every outer task occupies a worker while it waits for its inner tasks, so this would
+  // deadlock if waiting workers didn't run pending tasks
+  const auto outer_tasks = std::views::iota(0, 16) | std::views::transform([&](int i) {
+                             return std::function{[&, i]() {
+                               const auto inner_tasks =
+                                 std::views::iota(0, 16)
+                                 | std::views::transform([i](int j) {
+                                     return std::function{[i, j]() { return i * 16 + j; }};
+                                   })
+                                 | to_vector;
+
+                               auto sum = 0;
+                               for (const auto result : tm.run_tasks_and_wait(inner_tasks))
+                               {
+                                 sum += result;
+                               }
+                               return sum;
+                             }};
+                           })
+                           | to_vector;
+
+  auto sum = 0;
+  for (const auto result : tm.run_tasks_and_wait(outer_tasks))
+  {
+    sum += result;
+  }
+
+  CHECK(sum == 255 * 256 / 2);
+}
+
 TEST_CASE("task_manager stress test")
 {
   auto tm = task_manager{};